@@ -0,0 +1,121 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef BITRATE_BASIC_H
+#define BITRATE_BASIC_H
+
+// Include standard headers
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+// Include ESP headers
+#include <esp_log.h>
+#include <esp_err.h>
+
+// Include Opus headers
+#include "opus.h"
+
+// Define controller decision interval
+#define AUDIO_BITRATE_INTERVAL_MS 1000
+
+// Define congestion thresholds: loss percentage and queued send audio
+#define AUDIO_BITRATE_LOSS_HIGH 5
+#define AUDIO_BITRATE_LOSS_LOW 1
+#define AUDIO_BITRATE_QUEUE_HIGH_MS 60
+
+// Define clean intervals before the bitrate is raised, and the raise step
+#define AUDIO_BITRATE_CLEAN_INTERVALS 3
+#define AUDIO_BITRATE_STEP 2000
+
+// Define highest loss percentage passed to the encoder
+#define AUDIO_BITRATE_MAX_LOSS_PERCENT 30
+
+// Define clean intervals before packets are made shorter again
+#define AUDIO_PACKET_CLEAN_INTERVALS 5
+
+// Define bitrate controller statistics
+struct AudioBitrateStats
+{
+    int bitrate = 0;
+    int bandwidth = 0;
+    int loss_percent = 0;
+    int packet_frames = 1;
+    uint32_t decreases = 0;
+    uint32_t increases = 0;
+};
+
+// AIMD uplink rate controller. Under congestion it also joins more frames
+// per packet to cut per-packet overhead. Report() may be called from any
+// task; Update() runs on the encode task, which applies its decisions.
+class AudioBitrateController
+{
+private:
+    // Bounds and current decision
+    int min_bitrate = 0;
+    int max_bitrate = 0;
+    std::atomic<int> bitrate{0};
+    std::atomic<int> bandwidth{OPUS_BANDWIDTH_WIDEBAND};
+    std::atomic<int> loss_percent{0};
+
+    // Frames joined per packet, grown up to max_packet_frames when automatic
+    std::atomic<int> packet_frames{1};
+    int max_packet_frames = 1;
+    int packet_clean_intervals = 0;
+
+    // Uplink results reported since the last decision
+    std::atomic<uint32_t> sent{0};
+    std::atomic<uint32_t> failed{0};
+
+    // Interval state
+    int64_t interval_start_us = 0;
+    int max_queue_ms = 0;
+    int clean_intervals = 0;
+
+    // Counters
+    std::atomic<uint32_t> decreases{0};
+    std::atomic<uint32_t> increases{0};
+
+    // Private methods
+    static int BandwidthFor(int bitrate);
+    static int PacketFramesStep(int frames, int direction, int max_frames);
+
+public:
+    // Constructor and destructor
+    AudioBitrateController();
+    ~AudioBitrateController();
+
+    // Set bounds in bits per second, starting at start_bitrate
+    void Configure(int min_bitrate_, int max_bitrate_, int start_bitrate);
+
+    // Set frames per packet; with automatic set, grow up to frames under congestion
+    void SetPacketFrames(int frames, bool automatic);
+
+    // Report frames handed to the network and frames that failed to send
+    void Report(uint32_t sent_frames, uint32_t failed_frames);
+
+    // Sample queued send audio and decide; returns true when settings changed
+    bool Update(int64_t now_us, int queue_ms);
+
+    // Getters
+    int Bitrate() const { return bitrate.load(); }
+    int Bandwidth() const { return bandwidth.load(); }
+    int LossPercent() const { return loss_percent.load(); }
+    int PacketFrames() const { return packet_frames.load(); }
+    AudioBitrateStats GetStats() const;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,113 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef CACHE_BASIC_H
+#define CACHE_BASIC_H
+
+// Include standard headers
+#include <list>
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+
+// Include ESP headers
+#include <esp_log.h>
+#include <esp_err.h>
+#include <esp_heap_caps.h>
+
+// Define decoded prompt PCM, held in PSRAM
+struct AudioPromptPcm
+{
+    const void *key = nullptr;
+    int16_t *data = nullptr;
+    size_t capacity = 0;
+    size_t samples = 0;
+    bool failed = false;
+    std::atomic<bool> complete{false};
+
+    // Free PSRAM buffer
+    ~AudioPromptPcm()
+    {
+        if (data != nullptr)
+        {
+            heap_caps_free(data);
+        }
+    }
+
+    // Append decoded samples while the prompt is first played
+    void Append(const int16_t *pcm, size_t count)
+    {
+        if (count > capacity - samples)
+        {
+            count = capacity - samples;
+        }
+        std::copy(pcm, pcm + count, data + samples);
+        samples += count;
+    }
+};
+
+// Define prompt cache statistics
+struct AudioPromptCacheStats
+{
+    size_t bytes = 0;
+    size_t budget = 0;
+    size_t entries = 0;
+    uint32_t hits = 0;
+    uint32_t misses = 0;
+};
+
+// LRU cache of prompts decoded and resampled to the codec output rate.
+// Entries are shared so an evicted prompt stays valid until playback ends.
+class AudioPromptCache
+{
+private:
+    // Entries ordered from most to least recently used
+    std::mutex mutex;
+    std::list<std::shared_ptr<AudioPromptPcm>> entries;
+
+    // Byte budget and usage
+    size_t budget = 0;
+    size_t bytes = 0;
+
+    // Counters
+    std::atomic<uint32_t> hits{0};
+    std::atomic<uint32_t> misses{0};
+
+    // Private methods
+    void EvictLocked(size_t needed);
+
+public:
+    // Constructor and destructor
+    AudioPromptCache();
+    ~AudioPromptCache();
+
+    // Set byte budget, 0 disables the cache
+    void SetBudget(size_t budget_bytes);
+
+    // Get a fully decoded prompt, or nullptr on a miss
+    std::shared_ptr<AudioPromptPcm> Lookup(const void *key);
+
+    // Reserve an entry to be filled while the prompt is decoded
+    std::shared_ptr<AudioPromptPcm> Reserve(const void *key, size_t samples);
+
+    // Getters
+    bool Enabled() const { return budget > 0; }
+    AudioPromptCacheStats GetStats();
+};
+
+#endif
\ No newline at end of file
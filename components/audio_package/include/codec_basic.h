@@ -20,11 +20,17 @@ limitations under the License.
 // Include standard headers
 #include <string>
 #include <vector>
+#include <atomic>
+#include <algorithm>
+#include <cstring>
 #include <functional>
 
 // Include ESP headers
 #include <esp_log.h>
 #include <esp_err.h>
+#include <esp_attr.h>
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
 
 // Include driver headers
 #include <driver/i2s_std.h>
@@ -44,6 +50,25 @@ limitations under the License.
 // Define audio codec DMA frame number
 #define AUDIO_CODEC_DMA_FRAME_NUM 240
 
+// Define samples faded to silence when the output stream runs dry, avoids a click
+#define AUDIO_CODEC_UNDERRUN_FADE 32
+
+// Define output stream statistics
+struct AudioCodecStreamStats
+{
+    uint32_t dma_events = 0;
+    uint32_t underruns = 0;
+    uint32_t underrun_samples = 0;
+};
+
+// Define input stream statistics
+struct AudioCodecCaptureStats
+{
+    uint32_t dma_events = 0;
+    uint32_t overruns = 0;
+    uint32_t dropped_samples = 0;
+};
+
 // Define the AudioCodec class
 class AudioCodec
 {
@@ -67,6 +92,59 @@ protected:
     int output_volume = 80;
     float input_gain = 30.00;
 
+    // Output stream: TX DMA events pull samples from a single-producer ring
+    int16_t *stream_ring = nullptr;
+    size_t stream_capacity = 0;
+    std::atomic<size_t> stream_head{0};
+    std::atomic<size_t> stream_tail{0};
+    std::atomic<bool> stream_active{false};
+    std::atomic<bool> stream_waiting{false};
+    TaskHandle_t stream_waiter = nullptr;
+    size_t stream_wake_space = 0;
+    int16_t stream_last = 0;
+    bool stream_dry = false;
+
+    // Time the sample at stream_stamp_index starts playing, guarded by a sequence count
+    std::atomic<uint32_t> stream_stamp_sequence{0};
+    size_t stream_stamp_index = 0;
+    int64_t stream_stamp_us = 0;
+    int64_t stream_delay_us = 0;
+
+    // Output stream counters, updated from the DMA interrupt
+    std::atomic<uint32_t> stream_dma_events{0};
+    std::atomic<uint32_t> stream_underruns{0};
+    std::atomic<uint32_t> stream_underrun_samples{0};
+
+    // Input stream: RX DMA events push samples into a single-consumer ring
+    int16_t *capture_ring = nullptr;
+    size_t capture_capacity = 0;
+    std::atomic<size_t> capture_head{0};
+    std::atomic<size_t> capture_tail{0};
+    std::atomic<bool> capture_active{false};
+    std::atomic<bool> capture_waiting{false};
+    TaskHandle_t capture_waiter = nullptr;
+    size_t capture_wake_samples = 0;
+    bool capture_dropping = false;
+
+    // Time the sample before capture_stamp_index was captured, guarded by a sequence count
+    std::atomic<uint32_t> capture_stamp_sequence{0};
+    size_t capture_stamp_index = 0;
+    int64_t capture_stamp_us = 0;
+
+    // Input stream counters, updated from the DMA interrupt
+    std::atomic<uint32_t> capture_dma_events{0};
+    std::atomic<uint32_t> capture_overruns{0};
+    std::atomic<uint32_t> capture_dropped_samples{0};
+
+    // Time a buffer handed to the TX DMA waits behind the descriptors queued ahead of it
+    inline int64_t GetOutputDmaDelayUs() const { return static_cast<int64_t>(AUDIO_CODEC_DMA_DESC_NUM - 1) * AUDIO_CODEC_DMA_FRAME_NUM * 1000000 / output_sample_rate; }
+
+    // TX DMA sent callback, refills the buffer that was just sent
+    static bool IRAM_ATTR OnStreamSent(i2s_chan_handle_t handle, i2s_event_data_t *event, void *user_ctx);
+
+    // RX DMA received callback, queues the buffer that was just filled
+    static bool IRAM_ATTR OnCaptureRecv(i2s_chan_handle_t handle, i2s_event_data_t *event, void *user_ctx);
+
     // Pure virtual methods for reading and writing audio data
     virtual int Read(int16_t *dest, int samples) = 0;
     virtual int Write(const int16_t *data, int samples) = 0;
@@ -87,7 +165,31 @@ public:
 
     // Define data input/output methods
     virtual void OutputData(std::vector<int16_t> &data);
-    virtual bool InputData(std::vector<int16_t> &data);
+    virtual void OutputData(const int16_t *data, size_t samples);
+    virtual bool InputData(std::vector<int16_t> &data, int64_t *capture_us = nullptr);
+
+    // Output stream, enable before Start(): playback is pushed to a ring and
+    // the I2S TX DMA pulls from it, filling gaps with silence
+    virtual bool EnableOutputStream(size_t ring_samples);
+    size_t WriteOutputStream(const int16_t *data, size_t samples);
+    size_t GetOutputStreamSpace() const;
+    void SetOutputStreamActive(bool active);
+    bool WaitOutputStreamSpace(TaskHandle_t task, size_t samples);
+    size_t IRAM_ATTR PullOutputStream(int16_t *dest, size_t samples);
+    AudioCodecStreamStats GetOutputStreamStats() const;
+
+    // Time the next sample written starts playing, dated from TX DMA events when streaming
+    int64_t GetOutputPlayTime() const;
+
+    // Input stream, enable before Start(): the I2S RX DMA pushes captured
+    // samples to a ring, stamped with the time they were captured
+    virtual bool EnableInputStream(size_t ring_samples);
+    size_t ReadInputStream(int16_t *dest, size_t samples, int64_t *capture_us);
+    size_t GetInputStreamAvailable() const;
+    void SetInputStreamActive(bool active);
+    bool WaitInputStreamData(TaskHandle_t task, size_t samples);
+    void ResetInputStream();
+    AudioCodecCaptureStats GetInputStreamStats() const;
 
     // Define getter methods
     inline bool GetDuplex() const { return duplex; }
@@ -100,6 +202,8 @@ public:
     inline float GetInputGain() const { return input_gain; }
     inline bool GetInputEnabled() const { return input_enabled; }
     inline bool GetOutputEnabled() const { return output_enabled; }
+    inline bool GetOutputStream() const { return stream_ring != nullptr; }
+    inline bool GetInputStream() const { return capture_ring != nullptr; }
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,159 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef JITTER_BASIC_H
+#define JITTER_BASIC_H
+
+// Include standard headers
+#include <vector>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+
+// Include ESP headers
+#include <esp_log.h>
+#include <esp_err.h>
+
+// Define jitter buffer slot count (window of frames ahead of playout)
+#define JITTER_BUFFER_CAPACITY 32
+
+// Define target depth bounds in frames
+#define JITTER_BUFFER_MIN_DEPTH 2
+#define JITTER_BUFFER_MAX_DEPTH 12
+
+// Define consecutive concealed frames before a talkspurt is considered over
+#define JITTER_BUFFER_MAX_CONCEAL 5
+
+// Define played frames before an underrun depth boost decays
+#define JITTER_BUFFER_BOOST_DECAY_FRAMES 500
+
+// Define how far off the frame grid a timestamp may sit and still be snapped
+// onto it, as a divisor of the frame duration
+#define JITTER_BUFFER_ALIGN_TOLERANCE 4
+
+// Define what the decoder should do for the next playout frame
+enum AudioJitterAction
+{
+    AudioJitterNone,
+    AudioJitterDecode,
+    AudioJitterFec,
+    AudioJitterConceal,
+};
+
+// Define jitter buffer packet slot
+struct AudioJitterPacket
+{
+    bool valid = false;
+    int sample_rate = 0;
+    int frame_duration = 0;
+    uint32_t timestamp = 0;
+    int64_t arrival_us = 0;
+    std::vector<uint8_t> payload;
+};
+
+// Define jitter buffer statistics
+struct AudioJitterStats
+{
+    int depth = 0;
+    int target_depth = 0;
+    int jitter_ms = 0;
+    uint32_t late = 0;
+    uint32_t lost = 0;
+    uint32_t concealed = 0;
+    uint32_t recovered = 0;
+    uint32_t rejected = 0;
+};
+
+// Timestamp-ordered adaptive jitter buffer. Push() and Pop() must be called
+// from the same task; statistics and RequestReset() are safe from any task.
+class AudioJitterBuffer
+{
+private:
+    // Slots indexed by frame sequence modulo capacity
+    std::vector<AudioJitterPacket> slots;
+
+    // Timestamp that frame sequence numbers count from, set per talkspurt
+    uint32_t base_timestamp = 0;
+
+    // Playout state
+    bool anchored = false;
+    bool playing = false;
+    uint32_t next_timestamp = 0;
+    int frame_duration = 0;
+    int sample_rate = 0;
+    int consecutive_concealed = 0;
+
+    // Jitter estimation state (RFC 3550 interarrival jitter)
+    bool has_transit = false;
+    int64_t last_arrival_us = 0;
+    int64_t last_transit_us = 0;
+    int64_t jitter_us = 0;
+
+    // Underrun depth boost
+    int depth_boost = 0;
+    int frames_since_boost = 0;
+
+    // Reset flag set by other tasks
+    std::atomic<bool> reset_requested{false};
+
+    // Published statistics
+    std::atomic<int> depth{0};
+    std::atomic<int> target_depth{JITTER_BUFFER_MIN_DEPTH};
+    std::atomic<int> jitter_ms{0};
+    std::atomic<uint32_t> late_count{0};
+    std::atomic<uint32_t> lost_count{0};
+    std::atomic<uint32_t> concealed_count{0};
+    std::atomic<uint32_t> recovered_count{0};
+    std::atomic<uint32_t> rejected_count{0};
+
+    // Private methods
+    AudioJitterPacket &SlotFor(uint32_t timestamp);
+    bool AlignTimestamp(uint32_t &timestamp) const;
+    int32_t FramesBetween(uint32_t from, uint32_t to) const;
+    void UpdateJitter(uint32_t timestamp, int64_t arrival_us);
+    void UpdateTargetDepth();
+    void ApplyReset();
+
+public:
+    // Constructor and destructor
+    AudioJitterBuffer();
+    ~AudioJitterBuffer();
+
+    // Preallocate slots
+    void Initialize(size_t payload_reserve);
+
+    // Insert a received packet; an accepted payload is swapped into its slot,
+    // handing the slot's previous buffer back to the caller. A talkspurt keeps
+    // the format of its first packet, packets of another format or off the
+    // frame grid are rejected
+    void Push(std::vector<uint8_t> &payload, int sample_rate_, int frame_duration_, uint32_t timestamp, int64_t arrival_us);
+
+    // Get the next playout action; packet is valid until the next call
+    AudioJitterAction Pop(const AudioJitterPacket *&packet, int64_t now_us);
+
+    // Drop buffered packets on the owner's next Push() or Pop()
+    void RequestReset();
+
+    // Getters
+    bool Empty() const { return depth.load() == 0; }
+    bool IsPlaying() const { return playing; }
+    bool IsPrebuffering() const { return anchored && !playing && depth.load() > 0; }
+    int SampleRate() const { return sample_rate; }
+    int FrameDuration() const { return frame_duration; }
+    AudioJitterStats GetStats() const;
+};
+
+#endif
\ No newline at end of file
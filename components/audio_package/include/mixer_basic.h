@@ -0,0 +1,118 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef MIXER_BASIC_H
+#define MIXER_BASIC_H
+
+// Include standard headers
+#include <vector>
+#include <algorithm>
+#include <climits>
+#include <atomic>
+#include <cstdint>
+
+// Include ESP headers
+#include <esp_log.h>
+#include <esp_err.h>
+
+// Define maximum mixer sources
+#define AUDIO_MIXER_MAX_SOURCES 4
+
+// Define unity gain in Q15
+#define AUDIO_MIXER_UNITY_GAIN (1 << 15)
+
+// Define time a gain change ramps over, avoids clicks when ducking
+#define AUDIO_MIXER_RAMP_MS 10
+
+// Define mixer source statistics
+struct AudioMixerStats
+{
+    uint64_t samples = 0;
+    uint32_t underruns = 0;
+    uint32_t clipped = 0;
+    int gain_percent = 0;
+    bool ducked = false;
+};
+
+// Fixed-point mixer. Each segment is built by Begin(), one Add() per source
+// with data, then End(); all calls must come from the output task.
+class AudioMixer
+{
+private:
+    // Define mixer source
+    struct Source
+    {
+        int priority = 0;
+        int32_t gain = AUDIO_MIXER_UNITY_GAIN;
+        int32_t target = AUDIO_MIXER_UNITY_GAIN;
+        int32_t applied = AUDIO_MIXER_UNITY_GAIN;
+        bool ducked = false;
+
+        // Counters
+        std::atomic<uint64_t> samples{0};
+        std::atomic<uint32_t> underruns{0};
+    };
+    Source sources[AUDIO_MIXER_MAX_SOURCES];
+    int source_count = 0;
+
+    // Gain applied to sources below the highest active priority
+    int32_t duck_gain = AUDIO_MIXER_UNITY_GAIN;
+
+    // Per-sample gain step while ramping
+    int32_t ramp_step = AUDIO_MIXER_UNITY_GAIN;
+
+    // Segment buffers
+    std::vector<int32_t> accumulator;
+    std::vector<int16_t> output;
+    size_t segment_samples = 0;
+    std::atomic<uint32_t> clipped{0};
+
+    // Private methods
+    static int32_t ToQ15(float gain);
+
+public:
+    // Constructor and destructor
+    AudioMixer();
+    ~AudioMixer();
+
+    // Configure ramp speed and preallocate the longest segment
+    void Configure(int sample_rate, size_t max_samples);
+
+    // Add a source, higher priorities duck lower ones, returns the source id
+    int AddSource(int priority, float gain = 1.0f);
+
+    // Set gains
+    void SetGain(int source, float gain);
+    void SetDuckGain(float gain);
+
+    // Start a segment; active_mask marks sources that are playing, even
+    // if they have no data for this segment, so ducking holds across gaps
+    void Begin(size_t samples, uint32_t active_mask);
+
+    // Mix samples of a source into the segment at the given offset
+    void Add(int source, const int16_t *pcm, size_t offset, size_t samples);
+
+    // Count a source that is playing but had no data in time
+    void Underrun(int source);
+
+    // Saturate the segment to 16 bits and return it
+    const int16_t *End();
+
+    // Get statistics of a source
+    AudioMixerStats GetStats(int source) const;
+};
+
+#endif
\ No newline at end of file
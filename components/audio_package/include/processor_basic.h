@@ -35,6 +35,28 @@ limitations under the License.
 #include "model_basic.h"
 #include "codec_basic.h"
 
+// Define processing profiles, ordered from cheapest to best
+enum AudioProcessorProfile
+{
+    AudioProcessorProfileLowPower,
+    AudioProcessorProfileBalanced,
+    AudioProcessorProfileHighQuality,
+    AudioProcessorProfileCount,
+};
+
+// Define audio processor statistics
+struct AudioProcessorStats
+{
+    int profile = 0;
+    int ceiling = 0;
+    bool governor = false;
+    int load_percent = 0;
+    uint32_t fetch_us = 0;
+    uint32_t fetch_cycles = 0;
+    uint32_t fetches = 0;
+    uint32_t switches = 0;
+};
+
 // AudioProcessor class definition
 class AudioProcessor
 {
@@ -48,15 +70,22 @@ public:
     virtual ~AudioProcessor();
 
     // Define public methods
-    virtual void Initialize(AudioCodec *codec, int frame_duration_ms) = 0;
-    virtual void Feed(std::vector<int16_t> &&data) = 0;
+    virtual void Initialize(AudioCodec *codec, int frame_duration_ms, bool loopback_reference = false) = 0;
+    virtual void Feed(const std::vector<int16_t> &data) = 0;
     virtual void Start() = 0;
     virtual void Stop() = 0;
     virtual bool IsRunning() = 0;
-    virtual void OnOutput(std::function<void(std::vector<int16_t> &&data)> callback) = 0;
+    // Output frames are lent to the callback and only valid during the call
+    virtual void OnOutput(std::function<void(const int16_t *data, size_t samples)> callback) = 0;
     virtual void OnVadStateChange(std::function<void(bool speaking)> callback) = 0;
     virtual size_t GetFeedSize() = 0;
     virtual void EnableDeviceAec(bool enable) = 0;
+
+    // Select the best profile to run; the governor may drop below it when CPU runs short.
+    // Stages a processor can only choose at Initialize keep the profile set then
+    virtual void SetProfile(AudioProcessorProfile profile) = 0;
+    virtual void EnableGovernor(bool enable) = 0;
+    virtual AudioProcessorStats GetStats() = 0;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,115 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef REFERENCE_BASIC_H
+#define REFERENCE_BASIC_H
+
+// Include standard headers
+#include <vector>
+#include <algorithm>
+#include <mutex>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <cstdint>
+
+// Include ESP headers
+#include <esp_log.h>
+#include <esp_err.h>
+
+// Define playback history kept for alignment, covers queued playback and the longest echo path
+#define AUDIO_REFERENCE_HISTORY_MS 500
+
+// Define longest echo path the delay estimator searches, past the DMA and codec latency
+#define AUDIO_REFERENCE_MAX_DELAY_MS 160
+
+// Define how far the reference is kept ahead of its echo
+#define AUDIO_REFERENCE_LEAD_MS 2
+
+// Define decimation applied before correlating
+#define AUDIO_REFERENCE_DECIMATION 4
+
+// Define minimum normalized correlation for a delay estimate
+#define AUDIO_REFERENCE_MIN_CORRELATION 0.3f
+
+// Define estimates that must agree before the delay is updated
+#define AUDIO_REFERENCE_AGREEING_ESTIMATES 2
+
+// Define reference statistics
+struct AudioReferenceStats
+{
+    int delay_ms = 0;
+    uint32_t estimates = 0;
+    uint32_t gaps = 0;
+};
+
+// Ring of played samples stamped with the time they reach the speaker, read
+// back aligned to captured mic frames to serve as the AEC reference
+class AudioReference
+{
+private:
+    // Sample history and its timeline: sample index base_index plays at base_us
+    std::mutex mutex;
+    std::vector<int16_t> history;
+    uint64_t written = 0;
+    uint64_t base_index = 0;
+    int64_t base_us = 0;
+    int sample_rate = 16000;
+
+    // Estimated echo path delay
+    std::atomic<int64_t> delay_us{0};
+    int64_t candidate_us = -1;
+    int candidate_count = 0;
+
+    // Scratch buffers for delay estimation
+    std::vector<int16_t> window;
+    std::vector<int32_t> mic_decimated;
+    std::vector<int32_t> reference_decimated;
+
+    // Counters
+    std::atomic<uint32_t> estimates{0};
+    std::atomic<uint32_t> gaps{0};
+
+    // Private methods
+    void AppendLocked(const int16_t *pcm, size_t samples);
+    void CopyLocked(int16_t *dest, size_t samples, int64_t start_us);
+
+public:
+    // Constructor and destructor
+    AudioReference();
+    ~AudioReference();
+
+    // Allocate history at the given rate
+    void Initialize(int sample_rate_);
+
+    // Record samples that start playing at play_us
+    void Write(const int16_t *pcm, size_t samples, int64_t play_us);
+
+    // Read the reference aligned to mic samples captured from capture_us
+    void Read(int16_t *dest, size_t samples, int64_t capture_us);
+
+    // Correlate mic samples with the history to refine the echo delay
+    void EstimateDelay(const int16_t *mic, size_t samples, int64_t capture_us);
+
+    // Forget history, keeps the delay estimate
+    void Reset();
+
+    // Getters
+    int64_t GetDelayUs() const { return delay_us.load(); }
+    AudioReferenceStats GetStats() const;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,195 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef RING_BASIC_H
+#define RING_BASIC_H
+
+// Include standard headers
+#include <vector>
+#include <atomic>
+#include <functional>
+
+// Include FreeRTOS headers
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+// Define the notification index of space wakeups, kept apart from the default
+// index that carries consumer wakeups so one never consumes the other
+#define AUDIO_RING_SPACE_NOTIFY_INDEX 1
+#if configTASK_NOTIFICATION_ARRAY_ENTRIES <= AUDIO_RING_SPACE_NOTIFY_INDEX
+#error "AudioRing needs CONFIG_FREERTOS_TASK_NOTIFICATION_ARRAY_ENTRIES of at least 2"
+#endif
+
+// Fixed-capacity single-producer/single-consumer ring of preallocated slots.
+// Slots are constructed once in Allocate() and reused, so the steady state
+// never touches the heap. Wakeups go through direct task notifications.
+template <typename T>
+class AudioRing
+{
+private:
+    // Slot storage
+    std::vector<T> slots;
+    size_t capacity = 0;
+
+    // Monotonic write and read positions
+    std::atomic<size_t> head{0};
+    std::atomic<size_t> tail{0};
+
+    // Deferred clear, applied by the consumer
+    std::atomic<bool> clear_requested{false};
+
+    // Task notified when a slot is committed
+    std::atomic<TaskHandle_t> consumer_task{nullptr};
+
+    // Task notified when a slot is released, and the notification index it waits on
+    std::atomic<TaskHandle_t> space_waiter{nullptr};
+    std::atomic<UBaseType_t> space_waiter_index{AUDIO_RING_SPACE_NOTIFY_INDEX};
+
+public:
+    // Allocate slots and run the initializer on each of them
+    void Allocate(size_t capacity_, const std::function<void(T &)> &init = nullptr)
+    {
+        slots.resize(capacity_);
+        capacity = capacity_;
+        head.store(0);
+        tail.store(0);
+        if (init)
+        {
+            for (auto &slot : slots)
+            {
+                init(slot);
+            }
+        }
+    }
+
+    // Set consumer task to notify on commit
+    void SetConsumer(TaskHandle_t task) { consumer_task.store(task, std::memory_order_release); }
+
+    // Get ring capacity
+    size_t Capacity() const { return capacity; }
+
+    // Get number of occupied slots; a requested clear frees them once the consumer applies it
+    size_t Size() const { return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire); }
+
+    // Check if ring is empty
+    bool Empty() const { return Size() == 0; }
+
+    // Check if ring is full
+    bool Full() const { return Size() >= capacity; }
+
+    // Check if a clear is waiting for the consumer
+    bool ClearPending() const { return clear_requested.load(std::memory_order_acquire); }
+
+    // Producer: get the next free slot, or nullptr if full
+    T *Acquire()
+    {
+        if (capacity == 0 || Full())
+        {
+            return nullptr;
+        }
+        return &slots[head.load(std::memory_order_relaxed) % capacity];
+    }
+
+    // Producer: publish the slot returned by Acquire()
+    void Commit()
+    {
+        head.fetch_add(1, std::memory_order_release);
+        WakeConsumer();
+    }
+
+    // Producer: block until a slot is free or the timeout expires, on the space notification index
+    bool WaitForSpace(TickType_t timeout)
+    {
+        TickType_t start = xTaskGetTickCount();
+        while (Full())
+        {
+            // Register before the last check so a release in between is not missed
+            NotifyOnSpace();
+            if (!Full())
+            {
+                break;
+            }
+
+            // Wait out the rest of the timeout, a stale notification only loops once more
+            TickType_t waited = xTaskGetTickCount() - start;
+            if (timeout != portMAX_DELAY && waited >= timeout)
+            {
+                return false;
+            }
+            ulTaskNotifyTakeIndexed(AUDIO_RING_SPACE_NOTIFY_INDEX, pdTRUE, timeout == portMAX_DELAY ? portMAX_DELAY : timeout - waited);
+        }
+        return true;
+    }
+
+    // Producer: request a notification on the given index at the next release;
+    // a task that waits for several events at once passes its shared index
+    void NotifyOnSpace(UBaseType_t index = AUDIO_RING_SPACE_NOTIFY_INDEX)
+    {
+        space_waiter_index.store(index, std::memory_order_relaxed);
+        space_waiter.store(xTaskGetCurrentTaskHandle(), std::memory_order_release);
+    }
+
+    // Consumer: get the oldest committed slot, or nullptr if empty
+    T *Front()
+    {
+        if (clear_requested.exchange(false, std::memory_order_acq_rel))
+        {
+            tail.store(head.load(std::memory_order_acquire), std::memory_order_release);
+            WakeSpaceWaiter();
+        }
+        if (head.load(std::memory_order_acquire) == tail.load(std::memory_order_relaxed))
+        {
+            return nullptr;
+        }
+        return &slots[tail.load(std::memory_order_relaxed) % capacity];
+    }
+
+    // Consumer: release the slot returned by Front()
+    void Release()
+    {
+        tail.fetch_add(1, std::memory_order_release);
+        WakeSpaceWaiter();
+    }
+
+    // Any task: drop all committed slots on the consumer's next Front()
+    void RequestClear()
+    {
+        clear_requested.store(true, std::memory_order_release);
+        WakeConsumer();
+    }
+
+    // Wake the consumer task
+    void WakeConsumer()
+    {
+        TaskHandle_t consumer = consumer_task.load(std::memory_order_acquire);
+        if (consumer != nullptr)
+        {
+            xTaskNotifyGive(consumer);
+        }
+    }
+
+    // Wake a producer waiting for space
+    void WakeSpaceWaiter()
+    {
+        TaskHandle_t waiter = space_waiter.exchange(nullptr, std::memory_order_acq_rel);
+        if (waiter != nullptr)
+        {
+            xTaskNotifyGiveIndexed(waiter, space_waiter_index.load(std::memory_order_relaxed));
+        }
+    }
+};
+
+#endif
\ No newline at end of file
@@ -23,8 +23,8 @@ limitations under the License.
 #include <deque>
 #include <chrono>
 #include <mutex>
+#include <atomic>
 #include <cstring>
-#include <condition_variable>
 
 // Include ESP headers
 #include <esp_log.h>
@@ -38,39 +38,232 @@ limitations under the License.
 // Include audio package headers
 #include "codec_basic.h"
 #include "processor_basic.h"
+#include "ring_basic.h"
+#include "jitter_basic.h"
+#include "cache_basic.h"
+#include "mixer_basic.h"
+#include "reference_basic.h"
+#include "bitrate_basic.h"
+#include "tap_basic.h"
+
+// Include utils package headers
+#include "utils_latency.h"
+
+// Include language package headers
+#include "language_sound.h"
 
 // Include opus package headers
 #include "opus_encoder.h"
+#include "opus_packetizer.h"
 #include "opus_decoder.h"
 #include "opus_resampler.h"
 
+// Include resampler package headers
+#include "resampler_basic.h"
+
 // Include AFE headers
 #include "afe_audio_processor.h"
+#include "wake_word_processor.h"
 
 // Define audio processor running event bit
 #define OPUS_FRAME_DURATION_MS 20
 #define MAX_ENCODE_TASKS_IN_QUEUE 2
 #define MAX_PLAYBACK_TASKS_IN_QUEUE 2
 
-// Define maximum packets in queue based on 2400ms buffer
-#define MAX_DECODE_PACKETS_IN_QUEUE (2400 / OPUS_FRAME_DURATION_MS)
-#define MAX_SEND_PACKETS_IN_QUEUE (2400 / OPUS_FRAME_DURATION_MS)
+// Define audio each packet queue buffers, slot counts follow from the
+// shortest packet the queue carries
+#define AUDIO_SERVICE_QUEUE_MS 2400
+#define AUDIO_PROMPT_FRAME_DURATION_MS 60
+#define MAX_DECODE_PACKETS_IN_QUEUE (AUDIO_SERVICE_QUEUE_MS / OPUS_FRAME_DURATION_MS)
+#define MAX_SEND_PACKETS_IN_QUEUE (AUDIO_SERVICE_QUEUE_MS / OPUS_FRAME_DURATION_MS)
+#define MAX_PROMPT_PACKETS_IN_QUEUE (AUDIO_SERVICE_QUEUE_MS / AUDIO_PROMPT_FRAME_DURATION_MS)
 
 // Define maximum timestamps in queue
 #define MAX_TIMESTAMPS_IN_QUEUE 3
 
+// Define preallocated opus payload bytes per queue slot
+#define AUDIO_SERVICE_PACKET_RESERVE 160
+
+// Define the buffer one stats JSON line is formatted into
+#define AUDIO_SERVICE_STATS_JSON_SIZE 2048
+
+// Define longest frame a queue slot is sized for
+#define AUDIO_SERVICE_MAX_FRAME_DURATION_MS 120
+
+// Define opus decode task placement, a negative core leaves it unpinned
+#ifdef CONFIG_GEEKROS_AUDIO_DECODE_TASK_CORE
+#define AUDIO_DECODE_TASK_CORE CONFIG_GEEKROS_AUDIO_DECODE_TASK_CORE
+#define AUDIO_DECODE_TASK_PRIORITY CONFIG_GEEKROS_AUDIO_DECODE_TASK_PRIORITY
+#else
+#define AUDIO_DECODE_TASK_CORE 1
+#define AUDIO_DECODE_TASK_PRIORITY 3
+#endif
+#define AUDIO_DECODE_TASK_STACK_SIZE (2048 * 6)
+
+// Define opus encode task placement, a negative core leaves it unpinned
+#ifdef CONFIG_GEEKROS_AUDIO_ENCODE_TASK_CORE
+#define AUDIO_ENCODE_TASK_CORE CONFIG_GEEKROS_AUDIO_ENCODE_TASK_CORE
+#define AUDIO_ENCODE_TASK_PRIORITY CONFIG_GEEKROS_AUDIO_ENCODE_TASK_PRIORITY
+#else
+#define AUDIO_ENCODE_TASK_CORE 0
+#define AUDIO_ENCODE_TASK_PRIORITY 3
+#endif
+#define AUDIO_ENCODE_TASK_STACK_SIZE (2048 * 13)
+
+// Define prompt cache budget, 0 disables the cache
+#ifdef CONFIG_GEEKROS_AUDIO_PROMPT_CACHE
+#define AUDIO_PROMPT_CACHE_BUDGET (CONFIG_GEEKROS_AUDIO_PROMPT_CACHE_SIZE * 1024)
+#else
+#define AUDIO_PROMPT_CACHE_BUDGET 0
+#endif
+
+// Define cached prompt chunk length handed to the playback queue
+#define AUDIO_PROMPT_CACHE_CHUNK_MS 60
+
+// Define longest segment the mixer writes to the codec at once
+#define AUDIO_MIXER_SEGMENT_MS OPUS_FRAME_DURATION_MS
+
+// Define stream gain while a prompt plays
+#ifdef CONFIG_GEEKROS_AUDIO_DUCK_PERCENT
+#define AUDIO_MIXER_DUCK_PERCENT CONFIG_GEEKROS_AUDIO_DUCK_PERCENT
+#else
+#define AUDIO_MIXER_DUCK_PERCENT 30
+#endif
+
+// Define software echo reference, used when the codec has no reference channel
+#ifdef CONFIG_GEEKROS_AUDIO_SOFTWARE_REFERENCE
+#define AUDIO_SOFTWARE_REFERENCE 1
+#else
+#define AUDIO_SOFTWARE_REFERENCE 0
+#endif
+
+// Define uplink bitrate bounds in bits per second
+#ifdef CONFIG_GEEKROS_AUDIO_BITRATE_MIN
+#define AUDIO_BITRATE_MIN (CONFIG_GEEKROS_AUDIO_BITRATE_MIN * 1000)
+#define AUDIO_BITRATE_MAX (CONFIG_GEEKROS_AUDIO_BITRATE_MAX * 1000)
+#else
+#define AUDIO_BITRATE_MIN 8000
+#define AUDIO_BITRATE_MAX 32000
+#endif
+#define AUDIO_BITRATE_START 24000
+
+// Define uplink in-band FEC the application enables and the loss it always
+// protects against, covers WiFi losses the local send results cannot see
+#ifdef CONFIG_GEEKROS_AUDIO_UPLINK_FEC
+#define AUDIO_UPLINK_FEC 1
+#else
+#define AUDIO_UPLINK_FEC 0
+#endif
+#define AUDIO_UPLINK_FEC_MIN_LOSS 3
+
+// Define uplink packet duration the application sets, 0 joins more frames
+// per packet as the send queue backs up, up to the longest packet Opus allows
+#ifdef CONFIG_GEEKROS_AUDIO_UPLINK_PACKET_MS
+#define AUDIO_UPLINK_PACKET_MS CONFIG_GEEKROS_AUDIO_UPLINK_PACKET_MS
+#else
+#define AUDIO_UPLINK_PACKET_MS 0
+#endif
+#define AUDIO_UPLINK_MAX_PACKET_MS (OPUS_PACKETIZER_MAX_FRAMES * OPUS_FRAME_DURATION_MS)
+
+// Define muted uplink cadence, one DTX frame per Opus DTX update interval
+#define AUDIO_UPLINK_DTX_INTERVAL_MS 400
+
+// Define TOC of a SILK wideband 20 ms packet with an empty frame, which
+// decoders treat as a DTX frame and fade out like a lost one
+#define AUDIO_UPLINK_DTX_TOC 0x48
+
+// Define wake word gating of the uplink, audio replayed from before a detection, and silence that closes the gate
+#ifdef CONFIG_GEEKROS_AUDIO_WAKE_WORD
+#define AUDIO_WAKE_WORD 1
+#else
+#define AUDIO_WAKE_WORD 0
+#endif
+#ifdef CONFIG_GEEKROS_AUDIO_WAKE_PREROLL_MS
+#define AUDIO_WAKE_PREROLL_MS CONFIG_GEEKROS_AUDIO_WAKE_PREROLL_MS
+#else
+#define AUDIO_WAKE_PREROLL_MS 600
+#endif
+#ifdef CONFIG_GEEKROS_AUDIO_WAKE_IDLE_MS
+#define AUDIO_WAKE_IDLE_MS CONFIG_GEEKROS_AUDIO_WAKE_IDLE_MS
+#else
+#define AUDIO_WAKE_IDLE_MS 10000
+#endif
+
+// Define VAD-gated sending, needs the AFE VAD which device AEC turns off
+#if defined(CONFIG_GEEKROS_AUDIO_VAD_GATE) && !defined(CONFIG_USE_DEVICE_AEC)
+#define AUDIO_VAD_GATE 1
+#else
+#define AUDIO_VAD_GATE 0
+#endif
+#ifdef CONFIG_GEEKROS_AUDIO_VAD_PREROLL_MS
+#define AUDIO_VAD_PREROLL_MS CONFIG_GEEKROS_AUDIO_VAD_PREROLL_MS
+#else
+#define AUDIO_VAD_PREROLL_MS 300
+#endif
+
+// Define how long the VAD gate stays open after speech, keeps pauses between words
+#define AUDIO_VAD_HANGOVER_MS 400
+
+// Define DMA-driven capture, the audio its ring holds and how long the input task sleeps between checks
+#ifdef CONFIG_GEEKROS_AUDIO_INPUT_STREAM
+#define AUDIO_INPUT_STREAM 1
+#else
+#define AUDIO_INPUT_STREAM 0
+#endif
+#define AUDIO_INPUT_STREAM_MS 200
+#define AUDIO_INPUT_STREAM_WAIT_MS 100
+
+// Define DMA-driven playback and the audio its ring holds ahead of the DMA
+#ifdef CONFIG_GEEKROS_AUDIO_OUTPUT_STREAM
+#define AUDIO_OUTPUT_STREAM 1
+#else
+#define AUDIO_OUTPUT_STREAM 0
+#endif
+#define AUDIO_OUTPUT_STREAM_MS 60
+
+// Define interval between echo delay estimates
+#define AUDIO_REFERENCE_ESTIMATE_INTERVAL_MS 1000
+
+// Define audio output task stack size, with room for loopback resampling
+#define AUDIO_OUTPUT_TASK_STACK_SIZE (2048 * 2)
+
+// Define captured chunks remembered for uplink latency tagging
+#define AUDIO_LATENCY_FEED_HISTORY 16
+
 // Define power management timeouts
 #define AUDIO_POWER_TIMEOUT_MS 15000
 #define AUDIO_POWER_CHECK_INTERVAL_MS 1000
 
+// Define capture priming after power-up: chunks are dropped until one has
+// a sample above the level, or the time limit passes
+#define AUDIO_INPUT_PRIME_LEVEL 4
+#define AUDIO_INPUT_PRIME_MAX_MS 200
+
 // Define event bits
 #define AS_EVENT_AUDIO_PROCESSOR_RUNNING (1 << 0)
 
+// Define power state of one codec direction
+enum AudioPowerState
+{
+    AudioPowerOff,
+    AudioPowerWarming,
+    AudioPowerOn,
+};
+
+// Define activity hints that power the codec up ahead of use
+enum AudioPowerHint
+{
+    AudioPowerHintDownlink,
+    AudioPowerHintSignaling,
+    AudioPowerHintButton,
+};
+
 // Define audio service callbacks structure
 struct AudioServiceCallbacks
 {
     std::function<void(void)> on_send_queue_available;
     std::function<void(bool)> on_vad_change;
+    std::function<void(const std::string &)> on_wake_word;
 };
 
 // Define audio service task types
@@ -86,6 +279,15 @@ struct AudioServiceTask
     AudioServiceTaskType type;
     std::vector<int16_t> pcm;
     uint32_t timestamp;
+
+    // Latency tags: capture or receive time, and last stage boundary
+    int64_t origin_us = 0;
+    int64_t stage_us = 0;
+
+    // Cached prompt PCM, played in place of pcm when set
+    std::shared_ptr<AudioPromptPcm> cached;
+    const int16_t *view = nullptr;
+    size_t view_size = 0;
 };
 
 // Define audio service stream packet structure
@@ -95,6 +297,118 @@ struct AudioServiceStreamPacket
     int frame_duration = 0;
     uint32_t timestamp = 0;
     std::vector<uint8_t> payload;
+
+    // Latency tags: capture or receive time, and last stage boundary
+    int64_t origin_us = 0;
+    int64_t stage_us = 0;
+
+    // Flash-resident payload, played in place of payload when set
+    const uint8_t *view = nullptr;
+    size_t view_size = 0;
+
+    // Prompt cache entry filled by decoding this packet
+    std::shared_ptr<AudioPromptPcm> cache_fill;
+    bool cache_last = false;
+
+    // Prompt cache entry streamed instead of decoding
+    std::shared_ptr<AudioPromptPcm> cache_play;
+    size_t cache_offset = 0;
+};
+
+// Define audio service statistics
+struct AudioServiceStats
+{
+    // Frame counters since boot
+    uint32_t frames_encoded = 0;
+    uint32_t frames_decoded = 0;
+    uint32_t frames_concealed = 0;
+    uint32_t frames_played = 0;
+    uint32_t decode_errors = 0;
+
+    // Output stream gaps while playback expected data
+    uint32_t output_underruns = 0;
+    uint32_t output_underrun_samples = 0;
+
+    // Input stream buffers dropped because the input task fell behind
+    uint32_t input_overruns = 0;
+    uint32_t input_dropped_samples = 0;
+
+    // Muted uplink frames and what skipping their encode saved
+    uint32_t frames_muted = 0;
+    uint64_t muted_bytes_saved = 0;
+    uint64_t muted_encode_us_saved = 0;
+
+    // Current queue depths
+    size_t decode_queue = 0;
+    size_t prompt_queue = 0;
+    size_t send_queue = 0;
+    size_t encode_queue = 0;
+    size_t playback_queue = 0;
+
+    // Uplink encoder settings and rate controller steps
+    int bitrate = 0;
+    int bandwidth = 0;
+    int loss_percent = 0;
+    bool fec = false;
+    int packet_ms = 0;
+    uint32_t bitrate_decreases = 0;
+    uint32_t bitrate_increases = 0;
+
+    // Wake word gate
+    bool wake_enabled = false;
+    bool uplink_awake = true;
+    uint32_t wake_detections = 0;
+    uint32_t frames_gated = 0;
+    uint32_t wake_detect_us = 0;
+
+    // VAD gate: frames held in silence, onset bursts and bytes not sent
+    bool vad_gate = false;
+    uint32_t frames_held = 0;
+    uint32_t vad_bursts = 0;
+    uint32_t vad_burst_frames = 0;
+    uint64_t vad_bytes_saved = 0;
+
+    // Jitter buffer depth, late, lost, concealed and FEC-recovered frames
+    AudioJitterStats jitter;
+
+    // Prompt cache: decoded bytes held against the budget, hits and misses
+    AudioPromptCacheStats prompt_cache;
+
+    // Mixer sources: samples mixed, underruns, gain and ducking, clipped output samples
+    AudioMixerStats stream_mixer;
+    AudioMixerStats prompt_mixer;
+
+    // Software echo reference: estimated delay, estimates adopted and playback gaps
+    bool loopback = false;
+    AudioReferenceStats reference;
+
+    // AFE profile and CPU load
+    AudioProcessorStats processor;
+
+    // Tap points: enabled mask, records queued and dropped
+    AudioTapStats tap;
+
+    // Heap usage in bytes
+    size_t free_heap = 0;
+    size_t min_free_heap = 0;
+};
+
+// Define playback source: a decoder and the decoded frames it feeds the mixer
+struct AudioServiceSource
+{
+    int mixer_source = -1;
+    std::unique_ptr<OpusDecoderWrapper> decoder;
+    ResamplerBasic resampler;
+    std::vector<int16_t> resample_buffer;
+    AudioRing<AudioServiceTask> playback_queue;
+
+    // Set by the decode task while more frames are on the way
+    std::atomic<bool> pending{false};
+
+    // Output task state: frame being played and samples already mixed
+    AudioServiceTask *playing = nullptr;
+    size_t played = 0;
+    bool had_data = false;
 };
 
 // Define AudioService class
@@ -108,52 +422,189 @@ private:
     AudioCodec *codec = nullptr;
     AudioServiceCallbacks callbacks;
 
-    // Audio processor and Opus codec wrappers
+    // Audio processor and Opus encoder wrapper
     std::unique_ptr<AudioProcessor> audio_processor;
     std::unique_ptr<OpusEncoderWrapper> opus_encoder;
-    std::unique_ptr<OpusDecoderWrapper> opus_decoder;
 
-    // Resamplers for input, reference, and output audio
-    OpusResampler input_resampler;
-    OpusResampler reference_resampler;
-    OpusResampler output_resampler;
+    // Adapts the encoder to uplink congestion
+    AudioBitrateController bitrate_controller;
+
+    // Uplink FEC requested by the application, applied by the encode task
+    std::atomic<bool> uplink_fec{false};
+
+    // Joins encoded frames into uplink packets of the requested duration
+    OpusPacketizer uplink_packetizer;
+    std::vector<uint8_t> uplink_frame;
+    std::atomic<int> uplink_packet_ms{0};
+    int uplink_packet_ms_applied = -1;
+    uint32_t uplink_packet_timestamp = 0;
+    int64_t uplink_packet_origin_us = 0;
+
+    // Muted uplink skips the encoder, applied by the encode task
+    std::atomic<bool> uplink_muted{false};
+    bool uplink_muted_applied = false;
+    uint32_t uplink_muted_frames = 0;
+
+    // Wake word gate: while closed, frames only feed WakeNet and the pre-roll ring,
+    // which is replayed ahead of live frames once the wake word fires
+    bool wake_enabled = false;
+    WakeWordProcessor wake_word;
+    std::atomic<bool> uplink_awake{true};
+    bool uplink_awake_applied = true;
+    std::vector<AudioServiceTask> wake_preroll;
+    size_t wake_preroll_head = 0;
+    size_t wake_preroll_count = 0;
+    size_t wake_replay = 0;
+    int64_t wake_last_voice_us = 0;
+    std::atomic<int64_t> wake_detected_us{0};
+    std::atomic<uint32_t> frames_gated{0};
+
+    // VAD gate: during silence encoded frames wait in a ring and only DTX
+    // keep-alives are sent; at speech onset the ring goes out in a burst
+    bool vad_gate_enabled = false;
+    std::vector<AudioServiceStreamPacket> vad_preroll;
+    size_t vad_preroll_head = 0;
+    size_t vad_preroll_count = 0;
+    size_t vad_replay = 0;
+    bool vad_open = true;
+    int64_t vad_last_voice_us = 0;
+    uint32_t vad_silent_frames = 0;
+    std::atomic<uint32_t> frames_held{0};
+    std::atomic<uint32_t> vad_bursts{0};
+    std::atomic<uint32_t> vad_burst_frames{0};
+    std::atomic<uint64_t> vad_dropped_bytes{0};
+    std::atomic<uint64_t> vad_keepalive_bytes{0};
+
+    // Recent encoded frame size and encode time, estimate what muting saves
+    uint32_t uplink_frame_bytes = 0;
+    uint32_t uplink_encode_us = 0;
+
+    // Resampler for captured audio, mic and reference channels stay interleaved
+    ResamplerBasic input_resampler;
+
+    // Playback sources, each with its own decoder, mixed before the codec
+    AudioServiceSource stream_source;
+    AudioServiceSource prompt_source;
+    AudioMixer mixer;
+
+    // Playback is pulled by the I2S TX DMA instead of written by the output task
+    bool output_stream = false;
 
     // FreeRTOS task handles
     TaskHandle_t audio_input_task_handle = nullptr;
     TaskHandle_t audio_output_task_handle = nullptr;
-    TaskHandle_t opus_codec_task_handle = nullptr;
-
-    // Mutex and condition variable for audio queues
-    std::mutex audio_queue_mutex;
-    std::condition_variable audio_queue_cv;
-
-    // Audio queues
-    std::deque<std::unique_ptr<AudioServiceStreamPacket>> audio_decode_queue;
-    std::deque<std::unique_ptr<AudioServiceStreamPacket>> audio_send_queue;
-    std::deque<std::unique_ptr<AudioServiceTask>> audio_encode_queue;
-    std::deque<std::unique_ptr<AudioServiceTask>> audio_playback_queue;
+    TaskHandle_t opus_decode_task_handle = nullptr;
+    TaskHandle_t opus_encode_task_handle = nullptr;
+
+    // Audio queues, preallocated in Initialize()
+    AudioRing<AudioServiceStreamPacket> audio_decode_queue;
+    AudioRing<AudioServiceStreamPacket> audio_prompt_queue;
+    AudioRing<AudioServiceStreamPacket> audio_send_queue;
+    AudioRing<AudioServiceTask> audio_encode_queue;
+
+    // Reorders and paces received stream packets ahead of the decoder
+    AudioJitterBuffer jitter_buffer;
+
+    // Decoded prompts kept in PSRAM
+    AudioPromptCache prompt_cache;
+
+    // Persistent capture buffers, sized on first use and reused
+    std::vector<int16_t> input_data_buffer;
+    std::vector<int16_t> input_capture_buffer;
+    int64_t input_capture_us = 0;
+
+    // Capture is pushed by the I2S RX DMA instead of read by the input task
+    bool input_stream = false;
+
+    // Software echo reference: played samples aligned to captured mic frames
+    bool loopback_enabled = false;
+    AudioReference loopback_reference;
+    OpusResampler loopback_resampler;
+    std::vector<int16_t> loopback_buffer;
+    std::vector<int16_t> input_loopback_reference;
+    std::vector<int16_t> input_loopback_buffer;
+    int64_t loopback_start_us = 0;
+    uint64_t loopback_played_samples = 0;
+    int64_t loopback_estimate_us = 0;
+
+    // Debug tap points, each costs one test while disabled
+    AudioTap &tap = AudioTap::Instance();
+
+    // Capture times of recently fed chunks, matched to AFE output by sample count
+    int64_t input_feed_times[AUDIO_LATENCY_FEED_HISTORY] = {};
+    std::atomic<uint32_t> input_feed_count{0};
+    uint32_t input_output_samples = 0;
+    size_t input_feed_samples = 0;
+
+    // Frame counters
+    std::atomic<uint32_t> frames_encoded{0};
+    std::atomic<uint32_t> frames_decoded{0};
+    std::atomic<uint32_t> frames_concealed{0};
+    std::atomic<uint32_t> frames_played{0};
+    std::atomic<uint32_t> decode_errors{0};
+
+    // Muted uplink counters
+    std::atomic<uint32_t> frames_muted{0};
+    std::atomic<uint64_t> muted_bytes_saved{0};
+    std::atomic<uint64_t> muted_encode_us_saved{0};
 
     // For server AEC
+    std::mutex timestamp_queue_mutex;
     std::deque<uint32_t> timestamp_queue;
 
     // State variables
     bool audio_processor_initialized = false;
     bool voice_detected = false;
-    bool service_stopped = true;
-    bool audio_input_need_warmup = false;
+    std::atomic<bool> service_stopped{true};
 
     // Audio power management
     esp_timer_handle_t audio_service_power_timer = nullptr;
+    esp_timer_handle_t audio_service_prewarm_timer = nullptr;
+    std::mutex power_mutex;
+    std::atomic<AudioPowerState> input_power_state{AudioPowerOff};
+    std::atomic<AudioPowerState> output_power_state{AudioPowerOff};
+    int64_t input_power_request_us = 0;
+    int64_t output_power_request_us = 0;
+
+    // Pending prewarm requests, applied on the timer task
+    std::atomic<bool> prewarm_input{false};
+    std::atomic<bool> prewarm_output{false};
+    std::atomic<int64_t> prewarm_request_us{0};
     std::chrono::steady_clock::time_point last_input_time;
     std::chrono::steady_clock::time_point last_output_time;
 
     // Private methods
     void AudioInputTask();
     void AudioOutputTask();
-    void OpusCodecTask();
-    void PushTaskToEncodeQueue(AudioServiceTaskType type, std::vector<int16_t> &&pcm);
-    void SetDecodeSampleRate(int sample_rate, int frame_duration);
+    void OpusDecodeTask();
+    void OpusEncodeTask();
+    void ApplyEncoderSettings();
+    void FlushUplinkPacket();
+    void EncodeMutedFrame(AudioServiceTask *task);
+    void GateWakeFrame(AudioServiceTask *task);
+    bool HoldVadFrame(uint32_t timestamp);
+    void StoreVadFrame(uint32_t timestamp);
+    void SendVadReplayFrame();
+    void ClearVadPreroll();
+    void UpdateWakeGate();
+    AudioServiceTask *FrontEncodeTask();
+    void ReleaseEncodeTask();
+    void PushTaskToEncodeQueue(AudioServiceTaskType type, const int16_t *pcm, size_t samples, int64_t origin_us = 0);
+    bool PushPacketToRing(AudioRing<AudioServiceStreamPacket> &ring, const uint8_t *payload, size_t size, int sample_rate, int frame_duration, uint32_t timestamp, bool wait);
+    bool PushViewToPromptQueue(const uint8_t *payload, size_t size, int sample_rate, int frame_duration, const std::shared_ptr<AudioPromptPcm> &cache_fill, bool cache_last);
+    bool PushCachedToPromptQueue(const std::shared_ptr<AudioPromptPcm> &cached);
+    bool PlayCachedPrompt(AudioServiceStreamPacket &prompt);
+    void DecodePrompt(AudioServiceStreamPacket &prompt);
+    bool DecodeToPlaybackQueue(AudioServiceSource &source, AudioJitterAction action, const uint8_t *payload, size_t size, int frame_duration, uint32_t timestamp, int64_t origin_us, AudioPromptPcm *cache_fill = nullptr);
+    void NotifyAudioTasks();
+    void SetDecodeFrameDuration(AudioServiceSource &source, int frame_duration);
+    bool MixSources();
+    void RecordLoopback(const int16_t *pcm, size_t samples);
+    void AddLoopbackReference(std::vector<int16_t> &data, int64_t capture_us);
     void CheckAndUpdateAudioPowerState();
+    void PowerUp(bool input, bool output, int64_t request_us);
+    void ApplyPrewarm();
+    void PrimeInput();
 
 public:
     // Constructor and Destructor
@@ -182,14 +633,44 @@ public:
     bool IsVoiceDetected() const { return voice_detected; }
     bool IsIdle();
     bool IsAudioProcessorRunning() const { return xEventGroupGetBits(event_group) & AS_EVENT_AUDIO_PROCESSOR_RUNNING; }
+    AudioServiceStats GetStats();
+
+    // Format statistics as one JSON line for offline tracking
+    std::string GetStatsJson();
+
+    AudioPowerState GetInputPowerState() const { return input_power_state; }
+    AudioPowerState GetOutputPowerState() const { return output_power_state; }
 
     // Enable or disable features
     void EnableVoiceProcessing(bool enable);
+    void EnableUplinkFec(bool enable);
+
+    // Set uplink packet duration in milliseconds, 0 selects automatically
+    void SetUplinkPacketDuration(int duration_ms);
+
+    // Mute the uplink: stop encoding and send DTX frames only
+    void SetUplinkMuted(bool muted);
+
+    // Open or close the wake word gate, e.g. from a button; it closes by itself after silence
+    void SetUplinkAwake(bool awake);
+    bool IsUplinkAwake() const { return uplink_awake.load(); }
+
+    // Select the AFE profile; with the governor on it is the best one run.
+    // Only NS and AGC follow at runtime, the AEC mode stays as configured
+    void SetProcessorProfile(AudioProcessorProfile profile);
+    void EnableProcessorGovernor(bool enable);
+
+    // Power the codec up ahead of expected audio
+    void Prewarm(AudioPowerHint hint);
 
     // Audio data methods
-    bool PushPacketToDecodeQueue(std::unique_ptr<AudioServiceStreamPacket> packet, bool wait = false);
-    std::unique_ptr<AudioServiceStreamPacket> PopPacketFromSendQueue();
-    void PlaySound(const std::string_view &sound);
+    bool PushPacketToDecodeQueue(const uint8_t *payload, size_t size, int sample_rate, int frame_duration, uint32_t timestamp, bool wait = false);
+    bool PopPacketFromSendQueue(AudioServiceStreamPacket &packet);
+
+    // Report uplink frames sent and failed since the last report
+    void ReportUplink(uint32_t sent, uint32_t failed);
+    void PlaySound(const Lang::Sounds::Sound &sound);
+    void PlaySound(const std::string_view &ogg);
     bool ReadAudioData(std::vector<int16_t> &data, int sample_rate, int samples);
     void ResetDecoder();
 
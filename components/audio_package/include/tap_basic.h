@@ -0,0 +1,213 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef TAP_BASIC_H
+#define TAP_BASIC_H
+
+// Include standard headers
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <functional>
+#include <algorithm>
+
+// Include ESP headers
+#include <esp_log.h>
+#include <esp_err.h>
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+
+// Include FreeRTOS headers
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+// Define tap points compiled in and enabled at start
+#ifdef CONFIG_GEEKROS_AUDIO_TAP
+#define AUDIO_TAP 1
+#else
+#define AUDIO_TAP 0
+#endif
+#ifdef CONFIG_GEEKROS_AUDIO_TAP_MASK
+#define AUDIO_TAP_MASK CONFIG_GEEKROS_AUDIO_TAP_MASK
+#else
+#define AUDIO_TAP_MASK 0x0
+#endif
+
+// Define ring size of each enabled tap
+#ifdef CONFIG_GEEKROS_AUDIO_TAP_BUFFER_KB
+#define AUDIO_TAP_BUFFER_KB CONFIG_GEEKROS_AUDIO_TAP_BUFFER_KB
+#else
+#define AUDIO_TAP_BUFFER_KB 32
+#endif
+
+// Define largest capture file written to SPIFFS
+#ifdef CONFIG_GEEKROS_AUDIO_TAP_FILE_KB
+#define AUDIO_TAP_FILE_KB CONFIG_GEEKROS_AUDIO_TAP_FILE_KB
+#else
+#define AUDIO_TAP_FILE_KB 1024
+#endif
+
+// Define whether taps stream over the data channel instead of SPIFFS
+#ifdef CONFIG_GEEKROS_AUDIO_TAP_SINK_DATA_CHANNEL
+#define AUDIO_TAP_SINK_DATA_CHANNEL 1
+#else
+#define AUDIO_TAP_SINK_DATA_CHANNEL 0
+#endif
+
+// Define drain interval and largest batch handed to the sink
+#define AUDIO_TAP_DRAIN_MS 100
+#define AUDIO_TAP_DRAIN_BYTES 4096
+
+// Define drain task stack and priority, below every audio task
+#define AUDIO_TAP_TASK_STACK_SIZE 3072
+#define AUDIO_TAP_TASK_PRIORITY 1
+
+// Define record magic, "GTAP" in little endian
+#define AUDIO_TAP_MAGIC 0x50415447
+
+// Define tap points, one bit each in the enable mask
+enum AudioTapPoint
+{
+    AudioTapMic = 0,
+    AudioTapResampled,
+    AudioTapAfe,
+    AudioTapDecoded,
+    AudioTapPlayback,
+    AudioTapUplink,
+    AudioTapPointCount
+};
+
+// Define record payload formats
+enum AudioTapFormat
+{
+    AudioTapPcm16 = 0,
+    AudioTapOpus = 1
+};
+
+// Define record header, followed by size bytes of payload
+struct __attribute__((packed)) AudioTapRecord
+{
+    uint32_t magic;
+    uint8_t point;
+    uint8_t format;
+    uint8_t channels;
+    uint8_t reserved;
+    uint32_t sample_rate;
+    uint32_t size;
+    int64_t timestamp_us;
+};
+
+// Define tap statistics
+struct AudioTapStats
+{
+    uint32_t mask = 0;
+    uint32_t records = 0;
+    uint32_t dropped = 0;
+    uint64_t bytes = 0;
+};
+
+// Tap points that copy audio from the pipeline into per-tap rings, drained
+// by a low-priority task into a file or a callback. Each tap has a single
+// producer task; a full ring drops the record instead of blocking it.
+class AudioTap
+{
+private:
+    // Single producer byte ring of one tap, positions only ever grow
+    struct Ring
+    {
+        uint8_t *data = nullptr;
+        size_t capacity = 0;
+        std::atomic<size_t> head{0};
+        std::atomic<size_t> tail{0};
+    };
+    Ring rings[AudioTapPointCount];
+
+    // Enabled taps, tested before any work at a tap point
+    std::atomic<uint32_t> mask{0};
+
+    // Sink the drain task writes batches to
+    std::mutex sink_mutex;
+    std::function<bool(const uint8_t *data, size_t size)> sink;
+    FILE *file = nullptr;
+    size_t file_bytes = 0;
+    size_t file_max_bytes = 0;
+
+    // Drain task and its batch buffer
+    TaskHandle_t drain_task_handle = nullptr;
+    std::vector<uint8_t> batch;
+
+    // Counters
+    std::atomic<uint32_t> records{0};
+    std::atomic<uint32_t> dropped{0};
+    std::atomic<uint64_t> bytes{0};
+
+    // Private methods
+    bool Push(AudioTapPoint point, AudioTapFormat format, int sample_rate, int channels, const void *payload, size_t size, int64_t timestamp_us);
+    void CopyIn(Ring &ring, size_t position, const void *src, size_t size);
+    void CopyOut(Ring &ring, size_t position, void *dest, size_t size);
+    bool FlushBatch(size_t size);
+    void DrainTask();
+
+public:
+    // Constructor and Destructor
+    AudioTap();
+    ~AudioTap();
+
+    // Get the singleton instance of the AudioTap class
+    static AudioTap &Instance()
+    {
+        static AudioTap instance;
+        return instance;
+    }
+
+    // Delete copy constructor and assignment operator
+    AudioTap(const AudioTap &) = delete;
+    AudioTap &operator=(const AudioTap &) = delete;
+
+    // Enable the taps in a mask of AudioTapPoint bits, allocating their rings
+    void Enable(uint32_t enable_mask);
+    void Disable();
+
+    // Check a tap before preparing its data, a single load and test
+    bool IsEnabled(AudioTapPoint point) const { return (mask.load(std::memory_order_relaxed) >> point) & 1; }
+
+    // Copy interleaved PCM into a tap, split into records that fit one batch
+    void WritePcm(AudioTapPoint point, const int16_t *pcm, size_t samples, int sample_rate, int channels, int64_t timestamp_us);
+
+    // Copy an Opus packet into a tap
+    void WriteOpus(AudioTapPoint point, const uint8_t *data, size_t size, int sample_rate, int64_t timestamp_us);
+
+    // Drain to a file of at most max_bytes, truncating it
+    bool OpenFile(const char *path, size_t max_bytes);
+
+    // Drain to a callback, returning false drops the batch; nullptr detaches
+    void SetSink(std::function<bool(const uint8_t *data, size_t size)> sink_);
+
+    // Move queued records to the sink, called by the drain task
+    void Drain();
+
+    // Get statistics
+    AudioTapStats GetStats() const;
+
+    // Get tap point name
+    static const char *PointName(AudioTapPoint point);
+};
+
+#endif
\ No newline at end of file
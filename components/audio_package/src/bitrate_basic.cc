@@ -0,0 +1,213 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// Include the headers
+#include "bitrate_basic.h"
+
+// Define log tag
+#define TAG "[client:components:audio:bitrate:basic]"
+
+// Constructor
+AudioBitrateController::AudioBitrateController()
+{
+}
+
+// Destructor
+AudioBitrateController::~AudioBitrateController()
+{
+}
+
+// Pick the widest bandwidth a bitrate can carry cleanly
+int AudioBitrateController::BandwidthFor(int bitrate)
+{
+    if (bitrate >= 16000)
+    {
+        return OPUS_BANDWIDTH_WIDEBAND;
+    }
+    if (bitrate >= 11000)
+    {
+        return OPUS_BANDWIDTH_MEDIUMBAND;
+    }
+    return OPUS_BANDWIDTH_NARROWBAND;
+}
+
+// Move one rung along the frames-per-packet ladder
+int AudioBitrateController::PacketFramesStep(int frames, int direction, int max_frames)
+{
+    static const int ladder[] = {1, 2, 3, 4, 6};
+    const int rungs = sizeof(ladder) / sizeof(ladder[0]);
+
+    // Find the current rung, then step within the allowed range
+    int rung = 0;
+    while (rung + 1 < rungs && ladder[rung + 1] <= frames)
+    {
+        rung++;
+    }
+    rung += direction;
+    if (rung < 0 || rung >= rungs || ladder[rung] > max_frames)
+    {
+        return frames;
+    }
+    return ladder[rung];
+}
+
+// Set bounds
+void AudioBitrateController::Configure(int min_bitrate_, int max_bitrate_, int start_bitrate)
+{
+    // Clamp the starting point into the bounds
+    min_bitrate = min_bitrate_;
+    max_bitrate = max_bitrate_ > min_bitrate_ ? max_bitrate_ : min_bitrate_;
+    int start = start_bitrate < min_bitrate ? min_bitrate : (start_bitrate > max_bitrate ? max_bitrate : start_bitrate);
+    bitrate = start;
+    bandwidth = BandwidthFor(start);
+    loss_percent = 0;
+    interval_start_us = 0;
+    max_queue_ms = 0;
+    clean_intervals = 0;
+    packet_clean_intervals = 0;
+}
+
+// Set frames per packet
+void AudioBitrateController::SetPacketFrames(int frames, bool automatic)
+{
+    // Automatic mode starts at one frame and may grow up to frames
+    packet_frames = automatic ? 1 : frames;
+    max_packet_frames = automatic ? frames : 0;
+    packet_clean_intervals = 0;
+}
+
+// Report uplink results
+void AudioBitrateController::Report(uint32_t sent_frames, uint32_t failed_frames)
+{
+    sent.fetch_add(sent_frames, std::memory_order_relaxed);
+    failed.fetch_add(failed_frames, std::memory_order_relaxed);
+}
+
+// Sample the send queue and decide
+bool AudioBitrateController::Update(int64_t now_us, int queue_ms)
+{
+    // Track the deepest send queue of this interval
+    if (queue_ms > max_queue_ms)
+    {
+        max_queue_ms = queue_ms;
+    }
+    if (interval_start_us == 0)
+    {
+        interval_start_us = now_us;
+        return false;
+    }
+    if (now_us - interval_start_us < AUDIO_BITRATE_INTERVAL_MS * 1000)
+    {
+        return false;
+    }
+
+    // Close the interval
+    uint32_t interval_sent = sent.exchange(0, std::memory_order_relaxed);
+    uint32_t interval_failed = failed.exchange(0, std::memory_order_relaxed);
+    int queue_peak = max_queue_ms;
+    interval_start_us = now_us;
+    max_queue_ms = 0;
+
+    // Smooth the loss rate over a few intervals
+    uint32_t total = interval_sent + interval_failed;
+    int interval_loss = total > 0 ? static_cast<int>(interval_failed * 100 / total) : 0;
+    int current = bitrate.load();
+    int previous_loss = loss_percent.load();
+    int smoothed_loss = (previous_loss * 3 + interval_loss + 2) / 4;
+
+    // Rounding holds small values, so step down whenever this interval lost less
+    if (smoothed_loss == previous_loss && interval_loss < previous_loss)
+    {
+        smoothed_loss--;
+    }
+    smoothed_loss = smoothed_loss > AUDIO_BITRATE_MAX_LOSS_PERCENT ? AUDIO_BITRATE_MAX_LOSS_PERCENT : smoothed_loss;
+
+    // Back off multiplicatively on loss or a growing queue, probe up additively when clean
+    int next = current;
+    bool congested = interval_loss >= AUDIO_BITRATE_LOSS_HIGH || queue_peak >= AUDIO_BITRATE_QUEUE_HIGH_MS;
+    bool clean = interval_loss <= AUDIO_BITRATE_LOSS_LOW && total > 0 && !congested;
+    if (congested)
+    {
+        next = current * 3 / 4;
+        clean_intervals = 0;
+    }
+    else if (clean && ++clean_intervals >= AUDIO_BITRATE_CLEAN_INTERVALS)
+    {
+        next = current + AUDIO_BITRATE_STEP;
+        clean_intervals = 0;
+    }
+    next = next < min_bitrate ? min_bitrate : (next > max_bitrate ? max_bitrate : next);
+
+    // In automatic mode, join more frames per packet under congestion and split them again slowly
+    int frames = packet_frames.load();
+    int next_frames = frames;
+    if (max_packet_frames > 0)
+    {
+        if (congested)
+        {
+            next_frames = PacketFramesStep(frames, 1, max_packet_frames);
+            packet_clean_intervals = 0;
+        }
+        else if (clean && ++packet_clean_intervals >= AUDIO_PACKET_CLEAN_INTERVALS)
+        {
+            next_frames = PacketFramesStep(frames, -1, max_packet_frames);
+            packet_clean_intervals = 0;
+        }
+        else if (!clean)
+        {
+            packet_clean_intervals = 0;
+        }
+    }
+    if (next_frames != frames)
+    {
+        ESP_LOGI(TAG, "Packet frames %d -> %d", frames, next_frames);
+        packet_frames = next_frames;
+    }
+
+    // Count and log changes
+    bool changed = next != current || smoothed_loss != previous_loss;
+    if (next < current)
+    {
+        decreases++;
+    }
+    else if (next > current)
+    {
+        increases++;
+    }
+    if (next != current)
+    {
+        ESP_LOGI(TAG, "Bitrate %d -> %d bps, loss %d%%, queue %d ms", current, next, interval_loss, queue_peak);
+    }
+    bitrate = next;
+    bandwidth = BandwidthFor(next);
+    loss_percent = smoothed_loss;
+
+    // Return true when the encoder must be updated
+    return changed;
+}
+
+// Get statistics
+AudioBitrateStats AudioBitrateController::GetStats() const
+{
+    AudioBitrateStats stats;
+    stats.bitrate = bitrate.load();
+    stats.bandwidth = bandwidth.load();
+    stats.loss_percent = loss_percent.load();
+    stats.packet_frames = packet_frames.load();
+    stats.decreases = decreases.load();
+    stats.increases = increases.load();
+    return stats;
+}
\ No newline at end of file
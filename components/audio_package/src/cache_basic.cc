@@ -0,0 +1,140 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// Include the headers
+#include "cache_basic.h"
+
+// Define log tag
+#define TAG "[client:components:audio:cache:basic]"
+
+// Constructor
+AudioPromptCache::AudioPromptCache()
+{
+}
+
+// Destructor
+AudioPromptCache::~AudioPromptCache()
+{
+}
+
+// Set byte budget
+void AudioPromptCache::SetBudget(size_t budget_bytes)
+{
+    // Lock mutex
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Shrink to the new budget
+    budget = budget_bytes;
+    EvictLocked(0);
+}
+
+// Evict least recently used entries until needed bytes fit
+void AudioPromptCache::EvictLocked(size_t needed)
+{
+    while (!entries.empty() && bytes + needed > budget)
+    {
+        bytes -= entries.back()->capacity * sizeof(int16_t);
+        entries.pop_back();
+    }
+}
+
+// Get a fully decoded prompt
+std::shared_ptr<AudioPromptPcm> AudioPromptCache::Lookup(const void *key)
+{
+    // Lock mutex
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Cache disabled
+    if (budget == 0)
+    {
+        return nullptr;
+    }
+
+    // Find entry by key
+    for (auto it = entries.begin(); it != entries.end(); ++it)
+    {
+        if ((*it)->key != key)
+        {
+            continue;
+        }
+
+        // An unfinished fill was interrupted, decode it again
+        if (!(*it)->complete.load())
+        {
+            bytes -= (*it)->capacity * sizeof(int16_t);
+            entries.erase(it);
+            break;
+        }
+
+        // Move to the front and count the hit
+        entries.splice(entries.begin(), entries, it);
+        hits++;
+        return entries.front();
+    }
+
+    // Count the miss
+    misses++;
+    return nullptr;
+}
+
+// Reserve an entry to be filled while decoding
+std::shared_ptr<AudioPromptPcm> AudioPromptCache::Reserve(const void *key, size_t samples)
+{
+    // Lock mutex
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Prompt does not fit the budget at all
+    size_t needed = samples * sizeof(int16_t);
+    if (budget == 0 || samples == 0 || needed > budget)
+    {
+        return nullptr;
+    }
+
+    // Make room and allocate in PSRAM
+    EvictLocked(needed);
+    auto entry = std::make_shared<AudioPromptPcm>();
+    entry->data = static_cast<int16_t *>(heap_caps_malloc(needed, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+    if (entry->data == nullptr)
+    {
+        ESP_LOGW(TAG, "Failed to allocate %u bytes for prompt cache", (unsigned)needed);
+        return nullptr;
+    }
+    entry->key = key;
+    entry->capacity = samples;
+
+    // Insert as most recently used
+    entries.push_front(entry);
+    bytes += needed;
+
+    // Return entry to fill
+    return entry;
+}
+
+// Get statistics
+AudioPromptCacheStats AudioPromptCache::GetStats()
+{
+    // Lock mutex
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Collect statistics
+    AudioPromptCacheStats stats;
+    stats.bytes = bytes;
+    stats.budget = budget;
+    stats.entries = entries.size();
+    stats.hits = hits.load();
+    stats.misses = misses.load();
+    return stats;
+}
\ No newline at end of file
@@ -36,6 +36,20 @@ AudioCodec::~AudioCodec()
         vEventGroupDelete(event_group);
         event_group = NULL;
     }
+
+    // Free output stream ring
+    if (stream_ring != nullptr)
+    {
+        heap_caps_free(stream_ring);
+        stream_ring = nullptr;
+    }
+
+    // Free input stream ring
+    if (capture_ring != nullptr)
+    {
+        heap_caps_free(capture_ring);
+        capture_ring = nullptr;
+    }
 }
 
 // Start the audio codec
@@ -92,15 +106,393 @@ void AudioCodec::EnableOutput(bool enable)
 void AudioCodec::OutputData(std::vector<int16_t> &data)
 {
     // Write audio data
-    Write(data.data(), data.size());
+    OutputData(data.data(), data.size());
 }
 
-// Input audio data
-bool AudioCodec::InputData(std::vector<int16_t> &data)
+// Output audio data from a buffer the caller keeps alive
+void AudioCodec::OutputData(const int16_t *data, size_t samples)
 {
-    // Read audio data
+    // Write audio data
+    Write(data, samples);
+}
+
+// Input audio data, capture_us receives the capture time of the first sample
+bool AudioCodec::InputData(std::vector<int16_t> &data, int64_t *capture_us)
+{
+    // With an input stream, take a whole chunk from the ring or nothing
+    if (capture_ring != nullptr)
+    {
+        if (GetInputStreamAvailable() < data.size())
+        {
+            return false;
+        }
+        return ReadInputStream(data.data(), data.size(), capture_us) == data.size();
+    }
+
+    // Read audio data, the blocking read returns once the last sample arrived
     int samples = Read(data.data(), data.size());
+    if (capture_us != nullptr && input_sample_rate > 0)
+    {
+        *capture_us = esp_timer_get_time() - static_cast<int64_t>(data.size()) * 1000000 / (input_sample_rate * input_channels);
+    }
 
     // Return true if samples were read
     return samples > 0;
+}
+
+// Enable the output stream, must run while the TX channel is not yet enabled
+bool AudioCodec::EnableOutputStream(size_t ring_samples)
+{
+    // Only codecs with an I2S TX channel can be driven by its DMA events
+    if (tx_handle == nullptr || stream_ring != nullptr || ring_samples == 0)
+    {
+        return false;
+    }
+
+    // Allocate the ring in internal memory, the interrupt reads it
+    stream_ring = static_cast<int16_t *>(heap_caps_calloc(ring_samples, sizeof(int16_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT));
+    if (stream_ring == nullptr)
+    {
+        ESP_LOGE(TAG, "Failed to allocate output stream ring");
+        return false;
+    }
+    stream_capacity = ring_samples;
+    stream_delay_us = GetOutputDmaDelayUs();
+
+    // Register the DMA sent callback
+    i2s_event_callbacks_t callbacks = {};
+    callbacks.on_sent = OnStreamSent;
+    esp_err_t ret = i2s_channel_register_event_callback(tx_handle, &callbacks, this);
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Failed to register output stream callback: %s", esp_err_to_name(ret));
+        heap_caps_free(stream_ring);
+        stream_ring = nullptr;
+        stream_capacity = 0;
+        return false;
+    }
+
+    // Return true on success
+    ESP_LOGI(TAG, "Output stream enabled, %u samples", (unsigned)ring_samples);
+    return true;
+}
+
+// Push samples to the output stream, returns samples accepted
+size_t AudioCodec::WriteOutputStream(const int16_t *data, size_t samples)
+{
+    // Copy what fits behind the queued samples
+    size_t head = stream_head.load(std::memory_order_relaxed);
+    size_t tail = stream_tail.load(std::memory_order_acquire);
+    size_t count = std::min(samples, stream_capacity - (head - tail));
+    size_t offset = head % stream_capacity;
+    size_t first = std::min(count, stream_capacity - offset);
+    memcpy(stream_ring + offset, data, first * sizeof(int16_t));
+    memcpy(stream_ring, data + first, (count - first) * sizeof(int16_t));
+
+    // Publish the samples to the interrupt
+    stream_head.store(head + count, std::memory_order_release);
+    return count;
+}
+
+// Get free samples in the output stream
+size_t AudioCodec::GetOutputStreamSpace() const
+{
+    return stream_capacity - (stream_head.load(std::memory_order_relaxed) - stream_tail.load(std::memory_order_acquire));
+}
+
+// Mark whether playback expects the stream to have data, gaps count as underruns only then
+void AudioCodec::SetOutputStreamActive(bool active)
+{
+    stream_active.store(active, std::memory_order_relaxed);
+}
+
+// Ask to be notified once samples fit, returns true when they already do
+bool AudioCodec::WaitOutputStreamSpace(TaskHandle_t task, size_t samples)
+{
+    // Arm the wakeup before checking to not miss one
+    stream_waiter = task;
+    stream_wake_space = samples;
+    stream_waiting.store(true, std::memory_order_release);
+    if (GetOutputStreamSpace() >= samples)
+    {
+        stream_waiting.store(false, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+// Pull samples for the DMA, fading to silence when the ring runs dry
+size_t IRAM_ATTR AudioCodec::PullOutputStream(int16_t *dest, size_t samples)
+{
+    // Copy queued samples
+    size_t tail = stream_tail.load(std::memory_order_relaxed);
+    size_t head = stream_head.load(std::memory_order_acquire);
+    size_t count = std::min(samples, head - tail);
+    size_t offset = tail % stream_capacity;
+    size_t first = std::min(count, stream_capacity - offset);
+    memcpy(dest, stream_ring + offset, first * sizeof(int16_t));
+    memcpy(dest + first, stream_ring, (count - first) * sizeof(int16_t));
+    stream_tail.store(tail + count, std::memory_order_release);
+    if (count > 0)
+    {
+        stream_last = dest[count - 1];
+        stream_dry = false;
+    }
+
+    // Fill the gap, ramping down from the last sample played
+    if (count < samples)
+    {
+        for (size_t i = count; i < samples; ++i)
+        {
+            size_t step = i - count;
+            dest[i] = step < AUDIO_CODEC_UNDERRUN_FADE ? static_cast<int16_t>(stream_last * static_cast<int32_t>(AUDIO_CODEC_UNDERRUN_FADE - 1 - step) / AUDIO_CODEC_UNDERRUN_FADE) : 0;
+        }
+        stream_last = 0;
+
+        // Count gaps while playback expects data
+        if (stream_active.load(std::memory_order_relaxed))
+        {
+            if (!stream_dry)
+            {
+                stream_underruns++;
+            }
+            stream_underrun_samples += samples - count;
+        }
+        stream_dry = true;
+    }
+
+    // Return samples taken from the ring
+    return count;
+}
+
+// TX DMA sent callback
+bool IRAM_ATTR AudioCodec::OnStreamSent(i2s_chan_handle_t, i2s_event_data_t *event, void *user_ctx)
+{
+    // Refill the buffer that was just sent, the DMA reaches it again after one ring of descriptors
+    AudioCodec *self = static_cast<AudioCodec *>(user_ctx);
+    int64_t now_us = esp_timer_get_time();
+    size_t tail = self->stream_tail.load(std::memory_order_relaxed);
+    self->stream_dma_events++;
+    self->PullOutputStream(static_cast<int16_t *>(event->dma_buf), event->size / sizeof(int16_t));
+
+    // Stamp the first sample of the refilled buffer with the time it starts playing
+    uint32_t sequence = self->stream_stamp_sequence.load(std::memory_order_relaxed);
+    self->stream_stamp_sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    self->stream_stamp_index = tail;
+    self->stream_stamp_us = now_us + self->stream_delay_us;
+    self->stream_stamp_sequence.store(sequence + 2, std::memory_order_release);
+
+    // Wake the producer once its samples fit
+    BaseType_t woken = pdFALSE;
+    if (self->stream_waiting.load(std::memory_order_acquire) && self->GetOutputStreamSpace() >= self->stream_wake_space)
+    {
+        self->stream_waiting.store(false, std::memory_order_relaxed);
+        vTaskNotifyGiveFromISR(self->stream_waiter, &woken);
+    }
+    return woken == pdTRUE;
+}
+
+// Get output stream statistics
+AudioCodecStreamStats AudioCodec::GetOutputStreamStats() const
+{
+    AudioCodecStreamStats stats;
+    stats.dma_events = stream_dma_events.load();
+    stats.underruns = stream_underruns.load();
+    stats.underrun_samples = stream_underrun_samples.load();
+    return stats;
+}
+
+// Get the time the next sample written starts playing
+int64_t AudioCodec::GetOutputPlayTime() const
+{
+    // Nothing written now plays before the descriptors already queued are sent
+    int64_t earliest_us = esp_timer_get_time() + GetOutputDmaDelayUs();
+    if (stream_ring == nullptr)
+    {
+        return earliest_us;
+    }
+
+    // Date the write position from the newest DMA stamp, retrying while the interrupt updates it
+    uint32_t sequence;
+    size_t stamp_index;
+    int64_t stamp_us;
+    do
+    {
+        sequence = stream_stamp_sequence.load(std::memory_order_acquire);
+        stamp_index = stream_stamp_index;
+        stamp_us = stream_stamp_us;
+        std::atomic_thread_fence(std::memory_order_acquire);
+    } while ((sequence & 1) != 0 || sequence != stream_stamp_sequence.load(std::memory_order_relaxed));
+    size_t head = stream_head.load(std::memory_order_relaxed);
+    int64_t play_us = stamp_us + static_cast<int64_t>(head - stamp_index) * 1000000 / (output_sample_rate * output_channels);
+
+    // A drained ring plays new samples once the next buffer is refilled
+    return std::max(play_us, earliest_us);
+}
+
+// Enable the input stream, must run while the RX channel is not yet enabled
+bool AudioCodec::EnableInputStream(size_t ring_samples)
+{
+    // Only codecs with an I2S RX channel can be driven by its DMA events
+    if (rx_handle == nullptr || capture_ring != nullptr || ring_samples == 0)
+    {
+        return false;
+    }
+
+    // Allocate the ring in internal memory, the interrupt writes it
+    capture_ring = static_cast<int16_t *>(heap_caps_calloc(ring_samples, sizeof(int16_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT));
+    if (capture_ring == nullptr)
+    {
+        ESP_LOGE(TAG, "Failed to allocate input stream ring");
+        return false;
+    }
+    capture_capacity = ring_samples;
+
+    // Register the DMA received callback
+    i2s_event_callbacks_t callbacks = {};
+    callbacks.on_recv = OnCaptureRecv;
+    esp_err_t ret = i2s_channel_register_event_callback(rx_handle, &callbacks, this);
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Failed to register input stream callback: %s", esp_err_to_name(ret));
+        heap_caps_free(capture_ring);
+        capture_ring = nullptr;
+        capture_capacity = 0;
+        return false;
+    }
+
+    // Return true on success
+    ESP_LOGI(TAG, "Input stream enabled, %u samples", (unsigned)ring_samples);
+    return true;
+}
+
+// Take samples from the input stream, capture_us receives the capture time of the first one
+size_t AudioCodec::ReadInputStream(int16_t *dest, size_t samples, int64_t *capture_us)
+{
+    // Copy queued samples
+    size_t tail = capture_tail.load(std::memory_order_relaxed);
+    size_t head = capture_head.load(std::memory_order_acquire);
+    size_t count = std::min(samples, head - tail);
+    size_t offset = tail % capture_capacity;
+    size_t first = std::min(count, capture_capacity - offset);
+    memcpy(dest, capture_ring + offset, first * sizeof(int16_t));
+    memcpy(dest + first, capture_ring, (count - first) * sizeof(int16_t));
+
+    // Date the first sample from the newest DMA stamp, retrying while the interrupt updates it
+    if (capture_us != nullptr)
+    {
+        uint32_t sequence;
+        size_t stamp_index;
+        int64_t stamp_us;
+        do
+        {
+            sequence = capture_stamp_sequence.load(std::memory_order_acquire);
+            stamp_index = capture_stamp_index;
+            stamp_us = capture_stamp_us;
+            std::atomic_thread_fence(std::memory_order_acquire);
+        } while ((sequence & 1) != 0 || sequence != capture_stamp_sequence.load(std::memory_order_relaxed));
+        *capture_us = stamp_us - static_cast<int64_t>(stamp_index - tail) * 1000000 / (input_sample_rate * input_channels);
+    }
+
+    // Release the samples to the interrupt
+    capture_tail.store(tail + count, std::memory_order_release);
+    return count;
+}
+
+// Get queued samples in the input stream
+size_t AudioCodec::GetInputStreamAvailable() const
+{
+    return capture_head.load(std::memory_order_acquire) - capture_tail.load(std::memory_order_relaxed);
+}
+
+// Mark whether capture is consumed, the interrupt discards samples otherwise
+void AudioCodec::SetInputStreamActive(bool active)
+{
+    capture_active.store(active, std::memory_order_relaxed);
+}
+
+// Ask to be notified once samples are queued, returns true when they already are
+bool AudioCodec::WaitInputStreamData(TaskHandle_t task, size_t samples)
+{
+    // Arm the wakeup before checking to not miss one
+    capture_waiter = task;
+    capture_wake_samples = samples;
+    capture_waiting.store(true, std::memory_order_release);
+    if (GetInputStreamAvailable() >= samples)
+    {
+        capture_waiting.store(false, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+// Drop queued samples, called by the consumer
+void AudioCodec::ResetInputStream()
+{
+    capture_tail.store(capture_head.load(std::memory_order_acquire), std::memory_order_release);
+}
+
+// RX DMA received callback
+bool IRAM_ATTR AudioCodec::OnCaptureRecv(i2s_chan_handle_t, i2s_event_data_t *event, void *user_ctx)
+{
+    // Discard capture nobody consumes
+    AudioCodec *self = static_cast<AudioCodec *>(user_ctx);
+    int64_t now_us = esp_timer_get_time();
+    self->capture_dma_events++;
+    if (!self->capture_active.load(std::memory_order_relaxed))
+    {
+        return false;
+    }
+
+    // Drop the whole buffer when it does not fit, counting each overrun once
+    size_t samples = event->size / sizeof(int16_t);
+    size_t head = self->capture_head.load(std::memory_order_relaxed);
+    size_t tail = self->capture_tail.load(std::memory_order_acquire);
+    if (samples > self->capture_capacity - (head - tail))
+    {
+        if (!self->capture_dropping)
+        {
+            self->capture_overruns++;
+        }
+        self->capture_dropped_samples += samples;
+        self->capture_dropping = true;
+        return false;
+    }
+    self->capture_dropping = false;
+
+    // Copy the buffer behind the queued samples
+    const int16_t *source = static_cast<const int16_t *>(event->dma_buf);
+    size_t offset = head % self->capture_capacity;
+    size_t first = std::min(samples, self->capture_capacity - offset);
+    memcpy(self->capture_ring + offset, source, first * sizeof(int16_t));
+    memcpy(self->capture_ring, source + first, (samples - first) * sizeof(int16_t));
+
+    // Stamp the end of the buffer, then publish it
+    uint32_t sequence = self->capture_stamp_sequence.load(std::memory_order_relaxed);
+    self->capture_stamp_sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    self->capture_stamp_index = head + samples;
+    self->capture_stamp_us = now_us;
+    self->capture_stamp_sequence.store(sequence + 2, std::memory_order_release);
+    self->capture_head.store(head + samples, std::memory_order_release);
+
+    // Wake the consumer once a full chunk is queued
+    BaseType_t woken = pdFALSE;
+    if (self->capture_waiting.load(std::memory_order_acquire) && head + samples - tail >= self->capture_wake_samples)
+    {
+        self->capture_waiting.store(false, std::memory_order_relaxed);
+        vTaskNotifyGiveFromISR(self->capture_waiter, &woken);
+    }
+    return woken == pdTRUE;
+}
+
+// Get input stream statistics
+AudioCodecCaptureStats AudioCodec::GetInputStreamStats() const
+{
+    AudioCodecCaptureStats stats;
+    stats.dma_events = capture_dma_events.load();
+    stats.overruns = capture_overruns.load();
+    stats.dropped_samples = capture_dropped_samples.load();
+    return stats;
 }
\ No newline at end of file
@@ -0,0 +1,364 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// Include the headers
+#include "jitter_basic.h"
+
+// Define log tag
+#define TAG "[client:components:audio:jitter:basic]"
+
+// Constructor
+AudioJitterBuffer::AudioJitterBuffer()
+{
+}
+
+// Destructor
+AudioJitterBuffer::~AudioJitterBuffer()
+{
+}
+
+// Preallocate slots
+void AudioJitterBuffer::Initialize(size_t payload_reserve)
+{
+    // Allocate slots once
+    slots.resize(JITTER_BUFFER_CAPACITY);
+    for (auto &slot : slots)
+    {
+        slot.payload.reserve(payload_reserve);
+    }
+
+    // Start from an empty state
+    ApplyReset();
+}
+
+// Get slot for a timestamp on the frame grid
+AudioJitterPacket &AudioJitterBuffer::SlotFor(uint32_t timestamp)
+{
+    // Map frame sequence since the talkspurt base onto the slot array
+    int32_t capacity = static_cast<int32_t>(slots.size());
+    int32_t sequence = static_cast<int32_t>(timestamp - base_timestamp) / frame_duration;
+    return slots[((sequence % capacity) + capacity) % capacity];
+}
+
+// Snap a timestamp to the frame grid of the talkspurt
+bool AudioJitterBuffer::AlignTimestamp(uint32_t &timestamp) const
+{
+    // Round the offset from the base to the nearest whole frame
+    int32_t offset = static_cast<int32_t>(timestamp - base_timestamp);
+    int32_t frames = (offset + (offset < 0 ? -frame_duration : frame_duration) / 2) / frame_duration;
+    int32_t error = offset - frames * frame_duration;
+
+    // Reject timestamps too far between frames to belong to one
+    if (std::abs(error) * JITTER_BUFFER_ALIGN_TOLERANCE > frame_duration)
+    {
+        return false;
+    }
+    timestamp = base_timestamp + static_cast<uint32_t>(frames * frame_duration);
+    return true;
+}
+
+// Get signed frame distance between two timestamps
+int32_t AudioJitterBuffer::FramesBetween(uint32_t from, uint32_t to) const
+{
+    // Signed difference handles timestamp wrap
+    return static_cast<int32_t>(to - from) / frame_duration;
+}
+
+// Update interarrival jitter estimate
+void AudioJitterBuffer::UpdateJitter(uint32_t timestamp, int64_t arrival_us)
+{
+    // Relative transit time of this packet
+    int64_t transit_us = arrival_us - static_cast<int64_t>(timestamp) * 1000;
+    if (has_transit)
+    {
+        // Smooth absolute transit delta with gain 1/16
+        int64_t delta_us = transit_us - last_transit_us;
+        if (delta_us < 0)
+        {
+            delta_us = -delta_us;
+        }
+        jitter_us += (delta_us - jitter_us) / 16;
+        jitter_ms = static_cast<int>(jitter_us / 1000);
+    }
+    last_transit_us = transit_us;
+    last_arrival_us = arrival_us;
+    has_transit = true;
+}
+
+// Update adaptive target depth
+void AudioJitterBuffer::UpdateTargetDepth()
+{
+    // Cover three jitter deviations plus one frame
+    int64_t frame_us = static_cast<int64_t>(frame_duration) * 1000;
+    int target = 1 + static_cast<int>((3 * jitter_us + frame_us - 1) / frame_us);
+    if (target < 1 + depth_boost)
+    {
+        target = 1 + depth_boost;
+    }
+
+    // Clamp to configured bounds
+    if (target < JITTER_BUFFER_MIN_DEPTH)
+    {
+        target = JITTER_BUFFER_MIN_DEPTH;
+    }
+    if (target > JITTER_BUFFER_MAX_DEPTH)
+    {
+        target = JITTER_BUFFER_MAX_DEPTH;
+    }
+    target_depth = target;
+}
+
+// Drop all buffered packets
+void AudioJitterBuffer::ApplyReset()
+{
+    // Invalidate slots
+    for (auto &slot : slots)
+    {
+        slot.valid = false;
+    }
+
+    // Reset playout state
+    anchored = false;
+    playing = false;
+    consecutive_concealed = 0;
+    has_transit = false;
+    depth = 0;
+}
+
+// Request reset from any task
+void AudioJitterBuffer::RequestReset()
+{
+    reset_requested = true;
+}
+
+// Insert a received packet
+void AudioJitterBuffer::Push(std::vector<uint8_t> &payload, int sample_rate_, int frame_duration_, uint32_t timestamp, int64_t arrival_us)
+{
+    // Apply pending reset
+    if (reset_requested.exchange(false))
+    {
+        ApplyReset();
+    }
+
+    // Check for a valid frame duration
+    if (frame_duration_ <= 0)
+    {
+        rejected_count++;
+        return;
+    }
+
+    // A talkspurt keeps one format, a new one starts with the next talkspurt
+    if (anchored && (frame_duration_ != frame_duration || sample_rate_ != sample_rate))
+    {
+        rejected_count++;
+        return;
+    }
+    if (frame_duration_ != frame_duration || sample_rate_ != sample_rate)
+    {
+        frame_duration = frame_duration_;
+        sample_rate = sample_rate_;
+        ApplyReset();
+    }
+
+    // Anchor playout and the frame grid at the first packet of a talkspurt
+    if (!anchored)
+    {
+        anchored = true;
+        base_timestamp = timestamp;
+        next_timestamp = timestamp;
+    }
+
+    // Snap the timestamp to the frame grid, slots are only unique on it
+    if (!AlignTimestamp(timestamp))
+    {
+        rejected_count++;
+        return;
+    }
+
+    // Check position relative to playout point
+    int32_t ahead = FramesBetween(next_timestamp, timestamp);
+    if (ahead < 0)
+    {
+        // An earlier packet can still move the anchor before playout starts
+        if (!playing && -ahead + depth.load() < static_cast<int32_t>(slots.size()))
+        {
+            next_timestamp = timestamp;
+            ahead = 0;
+        }
+        else
+        {
+            late_count++;
+            return;
+        }
+    }
+
+    // Resynchronize when the packet is outside the slot window
+    if (ahead >= static_cast<int32_t>(slots.size()))
+    {
+        ApplyReset();
+        anchored = true;
+        base_timestamp = timestamp;
+        next_timestamp = timestamp;
+    }
+
+    // Store packet, ignoring duplicates
+    auto &slot = SlotFor(timestamp);
+    if (slot.valid && slot.timestamp == timestamp)
+    {
+        return;
+    }
+    if (!slot.valid)
+    {
+        depth++;
+    }
+    slot.valid = true;
+    slot.sample_rate = sample_rate_;
+    slot.frame_duration = frame_duration_;
+    slot.timestamp = timestamp;
+    slot.arrival_us = arrival_us;
+    slot.payload.swap(payload);
+
+    // Update jitter estimate and target depth
+    UpdateJitter(timestamp, arrival_us);
+    UpdateTargetDepth();
+}
+
+// Get the next playout action
+AudioJitterAction AudioJitterBuffer::Pop(const AudioJitterPacket *&packet, int64_t now_us)
+{
+    // Apply pending reset
+    if (reset_requested.exchange(false))
+    {
+        ApplyReset();
+    }
+
+    // Nothing to play
+    packet = nullptr;
+    if (!anchored || frame_duration <= 0)
+    {
+        return AudioJitterNone;
+    }
+
+    // Prebuffer until target depth is reached, or until the sender has been
+    // quiet for as long as the target depth so short utterances still play
+    if (!playing)
+    {
+        int64_t quiet_us = now_us - last_arrival_us;
+        if (depth.load() == 0 || (depth.load() < target_depth.load() && quiet_us < static_cast<int64_t>(target_depth.load()) * frame_duration * 1000))
+        {
+            return AudioJitterNone;
+        }
+        playing = true;
+        consecutive_concealed = 0;
+    }
+
+    // Skip a frame when the buffer runs far above target to cut latency
+    int current_depth = depth.load();
+    int target = target_depth.load();
+    if (current_depth > target * 2 && current_depth > target + 3)
+    {
+        auto &skipped = SlotFor(next_timestamp);
+        if (skipped.valid && skipped.timestamp == next_timestamp)
+        {
+            skipped.valid = false;
+            depth--;
+        }
+        next_timestamp += frame_duration;
+    }
+
+    // Play the expected frame if it arrived
+    auto &slot = SlotFor(next_timestamp);
+    uint32_t playout_timestamp = next_timestamp;
+    next_timestamp += frame_duration;
+    if (slot.valid && slot.timestamp != playout_timestamp && FramesBetween(slot.timestamp, playout_timestamp) > 0)
+    {
+        // Drop a stale packet left behind by a collision
+        slot.valid = false;
+        depth--;
+    }
+    if (slot.valid && slot.timestamp == playout_timestamp)
+    {
+        slot.valid = false;
+        depth--;
+        consecutive_concealed = 0;
+
+        // Decay underrun boost after a stable period
+        if (depth_boost > 0 && ++frames_since_boost >= JITTER_BUFFER_BOOST_DECAY_FRAMES)
+        {
+            depth_boost--;
+            frames_since_boost = 0;
+            UpdateTargetDepth();
+        }
+
+        packet = &slot;
+        return AudioJitterDecode;
+    }
+
+    // Buffer ran dry
+    if (depth.load() == 0)
+    {
+        // Talkspurt is over after a few concealed frames
+        if (++consecutive_concealed > JITTER_BUFFER_MAX_CONCEAL)
+        {
+            playing = false;
+            anchored = false;
+            return AudioJitterNone;
+        }
+
+        // Underrun: buffer deeper from now on
+        if (consecutive_concealed == 1 && depth_boost < JITTER_BUFFER_MAX_DEPTH)
+        {
+            depth_boost++;
+            frames_since_boost = 0;
+            UpdateTargetDepth();
+        }
+
+        concealed_count++;
+        return AudioJitterConceal;
+    }
+
+    // Frame is missing but later ones exist: it is lost
+    lost_count++;
+    consecutive_concealed++;
+
+    // Recover from the next packet's in-band FEC when it is already here
+    auto &next = SlotFor(next_timestamp);
+    if (next.valid && next.timestamp == next_timestamp)
+    {
+        recovered_count++;
+        packet = &next;
+        return AudioJitterFec;
+    }
+
+    // Otherwise use packet loss concealment
+    concealed_count++;
+    return AudioJitterConceal;
+}
+
+// Get statistics
+AudioJitterStats AudioJitterBuffer::GetStats() const
+{
+    AudioJitterStats stats;
+    stats.depth = depth.load();
+    stats.target_depth = target_depth.load();
+    stats.jitter_ms = jitter_ms.load();
+    stats.late = late_count.load();
+    stats.lost = lost_count.load();
+    stats.concealed = concealed_count.load();
+    stats.recovered = recovered_count.load();
+    stats.rejected = rejected_count.load();
+    return stats;
+}
\ No newline at end of file
@@ -0,0 +1,232 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// Include the headers
+#include "mixer_basic.h"
+
+// Define log tag
+#define TAG "[client:components:audio:mixer:basic]"
+
+// Constructor
+AudioMixer::AudioMixer()
+{
+}
+
+// Destructor
+AudioMixer::~AudioMixer()
+{
+}
+
+// Convert a linear gain to Q15, capped so a full-scale sample cannot overflow
+int32_t AudioMixer::ToQ15(float gain)
+{
+    if (gain < 0.0f)
+    {
+        gain = 0.0f;
+    }
+    if (gain > 1.99f)
+    {
+        gain = 1.99f;
+    }
+    return static_cast<int32_t>(gain * AUDIO_MIXER_UNITY_GAIN + 0.5f);
+}
+
+// Configure ramp speed and preallocate the longest segment
+void AudioMixer::Configure(int sample_rate, size_t max_samples)
+{
+    // Ramp from silence to unity within AUDIO_MIXER_RAMP_MS
+    int ramp_samples = sample_rate / 1000 * AUDIO_MIXER_RAMP_MS;
+    ramp_step = ramp_samples > 0 ? AUDIO_MIXER_UNITY_GAIN / ramp_samples : AUDIO_MIXER_UNITY_GAIN;
+
+    // Allocate segment buffers once
+    accumulator.assign(max_samples, 0);
+    output.assign(max_samples, 0);
+}
+
+// Add a source
+int AudioMixer::AddSource(int priority, float gain)
+{
+    // Check capacity
+    if (source_count >= AUDIO_MIXER_MAX_SOURCES)
+    {
+        ESP_LOGE(TAG, "Too many mixer sources");
+        return -1;
+    }
+
+    // Initialize the source at its steady gain
+    auto &source = sources[source_count];
+    source.priority = priority;
+    source.gain = ToQ15(gain);
+    source.target = source.gain;
+    source.applied = source.gain;
+    return source_count++;
+}
+
+// Set the gain of a source
+void AudioMixer::SetGain(int source, float gain)
+{
+    if (source >= 0 && source < source_count)
+    {
+        sources[source].gain = ToQ15(gain);
+    }
+}
+
+// Set the gain applied to ducked sources
+void AudioMixer::SetDuckGain(float gain)
+{
+    duck_gain = ToQ15(gain);
+}
+
+// Start a segment
+void AudioMixer::Begin(size_t samples, uint32_t active_mask)
+{
+    // Clear the accumulator
+    segment_samples = samples < accumulator.size() ? samples : accumulator.size();
+    std::fill(accumulator.begin(), accumulator.begin() + segment_samples, 0);
+
+    // Find the highest priority that is playing
+    int top = INT32_MIN;
+    for (int i = 0; i < source_count; ++i)
+    {
+        if ((active_mask & (1u << i)) && sources[i].priority > top)
+        {
+            top = sources[i].priority;
+        }
+    }
+
+    // Duck every source below it
+    for (int i = 0; i < source_count; ++i)
+    {
+        auto &source = sources[i];
+        source.ducked = source.priority < top;
+        source.target = source.ducked ? (source.gain * duck_gain) >> 15 : source.gain;
+
+        // A source that is not playing starts at its target without a ramp
+        if (!(active_mask & (1u << i)))
+        {
+            source.applied = source.target;
+        }
+    }
+}
+
+// Mix samples of a source into the segment
+void AudioMixer::Add(int source, const int16_t *pcm, size_t offset, size_t samples)
+{
+    // Check bounds
+    if (source < 0 || source >= source_count || offset >= segment_samples)
+    {
+        return;
+    }
+    if (samples > segment_samples - offset)
+    {
+        samples = segment_samples - offset;
+    }
+    auto &src = sources[source];
+    int32_t *acc = accumulator.data() + offset;
+    size_t i = 0;
+
+    // Ramp towards the target gain one step per sample
+    while (i < samples && src.applied != src.target)
+    {
+        if (src.applied < src.target)
+        {
+            src.applied = std::min(src.applied + ramp_step, src.target);
+        }
+        else
+        {
+            src.applied = std::max(src.applied - ramp_step, src.target);
+        }
+        acc[i] += (pcm[i] * src.applied) >> 15;
+        ++i;
+    }
+
+    // Mix the rest at a steady gain, skipping the multiply at unity
+    int32_t gain = src.applied;
+    if (gain == AUDIO_MIXER_UNITY_GAIN)
+    {
+        for (; i < samples; ++i)
+        {
+            acc[i] += pcm[i];
+        }
+    }
+    else
+    {
+        for (; i < samples; ++i)
+        {
+            acc[i] += (pcm[i] * gain) >> 15;
+        }
+    }
+
+    // Count mixed samples
+    src.samples.fetch_add(samples, std::memory_order_relaxed);
+}
+
+// Count a source underrun
+void AudioMixer::Underrun(int source)
+{
+    if (source >= 0 && source < source_count)
+    {
+        sources[source].underruns.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+// Saturate the segment to 16 bits
+const int16_t *AudioMixer::End()
+{
+    // Clamp each sample, counting the ones that clipped
+    const int32_t *acc = accumulator.data();
+    int16_t *out = output.data();
+    uint32_t clip_count = 0;
+    for (size_t i = 0; i < segment_samples; ++i)
+    {
+        int32_t value = acc[i];
+        if (value > INT16_MAX)
+        {
+            value = INT16_MAX;
+            clip_count++;
+        }
+        else if (value < INT16_MIN)
+        {
+            value = INT16_MIN;
+            clip_count++;
+        }
+        out[i] = static_cast<int16_t>(value);
+    }
+    if (clip_count > 0)
+    {
+        clipped.fetch_add(clip_count, std::memory_order_relaxed);
+    }
+
+    // Return mixed segment
+    return out;
+}
+
+// Get statistics of a source
+AudioMixerStats AudioMixer::GetStats(int source) const
+{
+    AudioMixerStats stats;
+    if (source < 0 || source >= source_count)
+    {
+        return stats;
+    }
+    const auto &src = sources[source];
+    stats.samples = src.samples.load(std::memory_order_relaxed);
+    stats.underruns = src.underruns.load(std::memory_order_relaxed);
+    stats.clipped = clipped.load(std::memory_order_relaxed);
+    stats.gain_percent = src.applied * 100 / AUDIO_MIXER_UNITY_GAIN;
+    stats.ducked = src.ducked;
+    return stats;
+}
\ No newline at end of file
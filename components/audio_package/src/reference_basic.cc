@@ -0,0 +1,249 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// Include the headers
+#include "reference_basic.h"
+
+// Define log tag
+#define TAG "[client:components:audio:reference:basic]"
+
+// Constructor
+AudioReference::AudioReference()
+{
+}
+
+// Destructor
+AudioReference::~AudioReference()
+{
+}
+
+// Allocate history at the given rate
+void AudioReference::Initialize(int sample_rate_)
+{
+    // Allocate history and estimation scratch once
+    std::lock_guard<std::mutex> lock(mutex);
+    sample_rate = sample_rate_;
+    history.assign(sample_rate / 1000 * AUDIO_REFERENCE_HISTORY_MS, 0);
+    written = 0;
+    base_index = 0;
+    base_us = 0;
+}
+
+// Append samples to the history
+void AudioReference::AppendLocked(const int16_t *pcm, size_t samples)
+{
+    size_t capacity = history.size();
+    for (size_t i = 0; i < samples; ++i)
+    {
+        history[(written + i) % capacity] = pcm != nullptr ? pcm[i] : 0;
+    }
+    written += samples;
+}
+
+// Copy history starting at a point in time, zero where nothing was played
+void AudioReference::CopyLocked(int16_t *dest, size_t samples, int64_t start_us)
+{
+    // Map time to a sample index on the history timeline
+    size_t capacity = history.size();
+    int64_t start = static_cast<int64_t>(base_index) + (start_us - base_us) * sample_rate / 1000000;
+    int64_t oldest = written > capacity ? static_cast<int64_t>(written - capacity) : 0;
+    int64_t newest = static_cast<int64_t>(written);
+
+    // Copy samples that are still in history
+    for (size_t i = 0; i < samples; ++i)
+    {
+        int64_t index = start + static_cast<int64_t>(i);
+        dest[i] = (capacity > 0 && index >= oldest && index < newest) ? history[index % capacity] : 0;
+    }
+}
+
+// Record samples that start playing at play_us
+void AudioReference::Write(const int16_t *pcm, size_t samples, int64_t play_us)
+{
+    // Lock history
+    std::lock_guard<std::mutex> lock(mutex);
+    size_t capacity = history.size();
+    if (capacity == 0)
+    {
+        return;
+    }
+
+    // Start the timeline with the first samples
+    if (written == 0)
+    {
+        base_index = 0;
+        base_us = play_us;
+    }
+
+    // Playback resumed after a pause: pad the pause with silence and rebase
+    int64_t head_us = base_us + static_cast<int64_t>(written - base_index) * 1000000 / sample_rate;
+    int64_t gap_us = play_us - head_us;
+    if (gap_us > 1000)
+    {
+        uint64_t gap = static_cast<uint64_t>(gap_us) * sample_rate / 1000000;
+        AppendLocked(nullptr, std::min<uint64_t>(gap, capacity));
+        written += gap > capacity ? gap - capacity : 0;
+        base_index = written;
+        base_us = play_us;
+        gaps++;
+    }
+    else if (-gap_us > AUDIO_REFERENCE_HISTORY_MS * 1000)
+    {
+        // The clock jumped back further than the history, restart the timeline
+        base_index = written;
+        base_us = play_us;
+    }
+
+    // Append samples
+    AppendLocked(pcm, samples);
+}
+
+// Read the reference aligned to mic samples captured from capture_us
+void AudioReference::Read(int16_t *dest, size_t samples, int64_t capture_us)
+{
+    // Take the samples whose echo reaches the mic slightly after this frame
+    int64_t start_us = capture_us - delay_us.load() + AUDIO_REFERENCE_LEAD_MS * 1000;
+    std::lock_guard<std::mutex> lock(mutex);
+    CopyLocked(dest, samples, start_us);
+}
+
+// Correlate mic samples with the history to refine the echo delay
+void AudioReference::EstimateDelay(const int16_t *mic, size_t samples, int64_t capture_us)
+{
+    // Copy the history the echo of this frame can come from
+    size_t max_delay = sample_rate / 1000 * AUDIO_REFERENCE_MAX_DELAY_MS;
+    window.resize(max_delay + samples);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        CopyLocked(window.data(), window.size(), capture_us - AUDIO_REFERENCE_MAX_DELAY_MS * 1000);
+    }
+
+    // Decimate both signals to keep the search cheap
+    size_t mic_count = samples / AUDIO_REFERENCE_DECIMATION;
+    size_t reference_count = window.size() / AUDIO_REFERENCE_DECIMATION;
+    size_t max_lag = max_delay / AUDIO_REFERENCE_DECIMATION;
+    mic_decimated.resize(mic_count);
+    reference_decimated.resize(reference_count);
+    for (size_t i = 0; i < mic_count; ++i)
+    {
+        int32_t sum = 0;
+        for (int j = 0; j < AUDIO_REFERENCE_DECIMATION; ++j)
+        {
+            sum += mic[i * AUDIO_REFERENCE_DECIMATION + j];
+        }
+        mic_decimated[i] = sum / AUDIO_REFERENCE_DECIMATION;
+    }
+    for (size_t i = 0; i < reference_count; ++i)
+    {
+        int32_t sum = 0;
+        for (int j = 0; j < AUDIO_REFERENCE_DECIMATION; ++j)
+        {
+            sum += window[i * AUDIO_REFERENCE_DECIMATION + j];
+        }
+        reference_decimated[i] = sum / AUDIO_REFERENCE_DECIMATION;
+    }
+
+    // Skip frames where either side is near silence
+    int64_t mic_energy = 0;
+    for (size_t i = 0; i < mic_count; ++i)
+    {
+        mic_energy += static_cast<int64_t>(mic_decimated[i]) * mic_decimated[i];
+    }
+    int64_t reference_energy = 0;
+    for (size_t i = 0; i < mic_count; ++i)
+    {
+        reference_energy += static_cast<int64_t>(reference_decimated[max_lag + i]) * reference_decimated[max_lag + i];
+    }
+    if (mic_count == 0 || mic_energy < static_cast<int64_t>(mic_count) * 100 * 100)
+    {
+        return;
+    }
+
+    // Search lags from the newest reference backwards, sliding the reference energy
+    float best = 0.0f;
+    size_t best_lag = 0;
+    for (size_t lag = 0; lag <= max_lag; ++lag)
+    {
+        // Slide the energy window one step back in time
+        size_t start = max_lag - lag;
+        if (lag > 0)
+        {
+            int64_t entering = reference_decimated[start];
+            int64_t leaving = reference_decimated[start + mic_count];
+            reference_energy += entering * entering - leaving * leaving;
+        }
+        if (reference_energy <= 0)
+        {
+            continue;
+        }
+
+        // Normalized correlation at this lag
+        int64_t correlation = 0;
+        for (size_t i = 0; i < mic_count; ++i)
+        {
+            correlation += static_cast<int64_t>(mic_decimated[i]) * reference_decimated[start + i];
+        }
+        float score = static_cast<float>(correlation) / std::sqrt(static_cast<float>(mic_energy) * static_cast<float>(reference_energy));
+        if (score > best)
+        {
+            best = score;
+            best_lag = lag;
+        }
+    }
+    if (best < AUDIO_REFERENCE_MIN_CORRELATION)
+    {
+        return;
+    }
+
+    // Adopt an estimate once consecutive frames agree on it
+    int64_t estimate_us = static_cast<int64_t>(best_lag) * AUDIO_REFERENCE_DECIMATION * 1000000 / sample_rate;
+    int64_t step_us = AUDIO_REFERENCE_DECIMATION * 1000000 / sample_rate;
+    if (candidate_us >= 0 && std::abs(estimate_us - candidate_us) <= step_us)
+    {
+        candidate_count++;
+    }
+    else
+    {
+        candidate_us = estimate_us;
+        candidate_count = 1;
+    }
+    if (candidate_count >= AUDIO_REFERENCE_AGREEING_ESTIMATES && delay_us.load() != estimate_us)
+    {
+        ESP_LOGI(TAG, "Echo delay %d ms, correlation %.2f", static_cast<int>(estimate_us / 1000), best);
+        delay_us = estimate_us;
+        estimates++;
+    }
+}
+
+// Forget history
+void AudioReference::Reset()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    std::fill(history.begin(), history.end(), 0);
+    written = 0;
+    base_index = 0;
+    base_us = 0;
+}
+
+// Get statistics
+AudioReferenceStats AudioReference::GetStats() const
+{
+    AudioReferenceStats stats;
+    stats.delay_ms = static_cast<int>(delay_us.load() / 1000);
+    stats.estimates = estimates.load();
+    stats.gaps = gaps.load();
+    return stats;
+}
\ No newline at end of file
@@ -20,6 +20,18 @@ limitations under the License.
 // Define log tag
 #define TAG "[client:components:audio:service:basic]"
 
+// Map a configured core number to a FreeRTOS affinity
+static BaseType_t AudioTaskCore(int core)
+{
+#if CONFIG_FREERTOS_UNICORE
+    // Single core targets cannot pin to another core
+    return tskNO_AFFINITY;
+#else
+    // Negative core numbers leave placement to the scheduler
+    return core < 0 ? tskNO_AFFINITY : core;
+#endif
+}
+
 // Constructor
 AudioService::AudioService()
 {
@@ -43,27 +55,147 @@ void AudioService::Initialize(AudioCodec *codec_data)
 {
     // Store codec reference
     codec = codec_data;
+
+    // Drive capture from I2S RX DMA events, must be set up before the channels start
+    if (AUDIO_INPUT_STREAM)
+    {
+        input_stream = codec->EnableInputStream(codec->GetInputSampleRate() / 1000 * AUDIO_INPUT_STREAM_MS * codec->GetInputChannels());
+    }
+
+    // Drive playback from I2S TX DMA events, must be set up before the channels start
+    if (AUDIO_OUTPUT_STREAM)
+    {
+        output_stream = codec->EnableOutputStream(codec->GetOutputSampleRate() / 1000 * AUDIO_OUTPUT_STREAM_MS);
+    }
     codec->Start();
 
-    // Initialize opus encoder and decoder
-    opus_decoder = std::make_unique<OpusDecoderWrapper>(codec->GetOutputSampleRate(), 1, OPUS_FRAME_DURATION_MS);
+    // Initialize one decoder per playback source, at the codec rate when Opus can
+    // output it, so packets of any rate or duration decode without a resampler
+    int output_rate = codec->GetOutputSampleRate();
+    int decode_rate = OpusDecoderWrapper::IsSupportedRate(output_rate) ? output_rate : 48000;
+    for (auto *source : {&stream_source, &prompt_source})
+    {
+        source->decoder = std::make_unique<OpusDecoderWrapper>(decode_rate, 1, OPUS_FRAME_DURATION_MS);
+        if (decode_rate != output_rate)
+        {
+            source->resampler.Configure(decode_rate, output_rate);
+        }
+    }
+
+    // Initialize opus encoder
     opus_encoder = std::make_unique<OpusEncoderWrapper>(16000, 1, OPUS_FRAME_DURATION_MS);
     opus_encoder->SetComplexity(0);
 
+    // Start the encoder at the controller's initial bitrate
+    bitrate_controller.Configure(AUDIO_BITRATE_MIN, AUDIO_BITRATE_MAX, AUDIO_BITRATE_START);
+    ApplyEncoderSettings();
+
+    // Gate the uplink on a local wake word when a WakeNet model is flashed
+    if (AUDIO_WAKE_WORD && wake_word.Initialize())
+    {
+        wake_enabled = true;
+        uplink_awake = false;
+        uplink_awake_applied = false;
+        wake_preroll.resize(AUDIO_WAKE_PREROLL_MS / OPUS_FRAME_DURATION_MS);
+        for (auto &frame : wake_preroll)
+        {
+            frame.pcm.reserve(16000 / 1000 * OPUS_FRAME_DURATION_MS);
+        }
+    }
+
+    // Hold encoded frames during silence, one extra slot for the onset frame
+    vad_gate_enabled = AUDIO_VAD_GATE;
+    if (vad_gate_enabled)
+    {
+        vad_preroll.resize(AUDIO_VAD_PREROLL_MS / OPUS_FRAME_DURATION_MS + 1);
+        for (auto &frame : vad_preroll)
+        {
+            frame.payload.reserve(AUDIO_SERVICE_PACKET_RESERVE);
+        }
+    }
+
+    // Enable the configured tap points
+    if (AUDIO_TAP)
+    {
+        tap.Enable(AUDIO_TAP_MASK);
+    }
+
     // Configure resamplers if needed
     if (codec->GetInputSampleRate() != 16000)
     {
-        input_resampler.Configure(codec->GetInputSampleRate(), 16000);
-        reference_resampler.Configure(codec->GetInputSampleRate(), 16000);
+        input_resampler.Configure(codec->GetInputSampleRate(), 16000, codec->GetInputChannels());
+    }
+
+    // Preallocate queue slots so the audio path never allocates per frame
+    uplink_frame.reserve(AUDIO_SERVICE_PACKET_RESERVE);
+    size_t input_frame_samples = 16000 / 1000 * OPUS_FRAME_DURATION_MS;
+    size_t output_frame_samples = codec->GetOutputSampleRate() / 1000 * AUDIO_SERVICE_MAX_FRAME_DURATION_MS;
+    auto init_packet = [](AudioServiceStreamPacket &packet)
+    {
+        packet.payload.reserve(AUDIO_SERVICE_PACKET_RESERVE);
+    };
+    audio_decode_queue.Allocate(MAX_DECODE_PACKETS_IN_QUEUE, init_packet);
+    audio_prompt_queue.Allocate(MAX_PROMPT_PACKETS_IN_QUEUE, init_packet);
+    audio_send_queue.Allocate(MAX_SEND_PACKETS_IN_QUEUE, init_packet);
+    audio_encode_queue.Allocate(MAX_ENCODE_TASKS_IN_QUEUE, [input_frame_samples](AudioServiceTask &task)
+                                { task.pcm.reserve(input_frame_samples); });
+    for (auto *source : {&stream_source, &prompt_source})
+    {
+        source->playback_queue.Allocate(MAX_PLAYBACK_TASKS_IN_QUEUE, [output_frame_samples](AudioServiceTask &task)
+                                        { task.pcm.reserve(output_frame_samples); });
+        source->resample_buffer.reserve(output_frame_samples);
+    }
+    jitter_buffer.Initialize(AUDIO_SERVICE_PACKET_RESERVE);
+    prompt_cache.SetBudget(AUDIO_PROMPT_CACHE_BUDGET);
+
+    // Configure mixer, prompts duck the stream while they play
+    mixer.Configure(codec->GetOutputSampleRate(), codec->GetOutputSampleRate() / 1000 * AUDIO_MIXER_SEGMENT_MS);
+    stream_source.mixer_source = mixer.AddSource(0);
+    prompt_source.mixer_source = mixer.AddSource(1);
+    mixer.SetDuckGain(AUDIO_MIXER_DUCK_PERCENT / 100.0f);
+
+    // Record playback as the echo reference when the codec has no reference channel
+    loopback_enabled = AUDIO_SOFTWARE_REFERENCE && !codec->GetInputReference();
+    if (loopback_enabled)
+    {
+        loopback_reference.Initialize(16000);
+        if (codec->GetOutputSampleRate() != 16000)
+        {
+            loopback_resampler.Configure(codec->GetOutputSampleRate(), 16000);
+        }
+        loopback_buffer.reserve(loopback_resampler.GetOutputSamples(codec->GetOutputSampleRate() / 1000 * AUDIO_MIXER_SEGMENT_MS));
     }
 
     // Set audio processor to AFE processor
     audio_processor = std::make_unique<AfeAudioProcessor>();
 
     // Initialize audio processor
-    auto output_callback = [this](std::vector<int16_t> &&data)
+    auto output_callback = [this](const int16_t *data, size_t samples)
     {
-        PushTaskToEncodeQueue(AudioTaskTypeEncodeToSendQueue, std::move(data));
+        // Match this output to the capture time of the chunk it came from
+        int64_t origin_us = 0;
+        int64_t offset_us = 0;
+        uint32_t fed = input_feed_count.load(std::memory_order_acquire);
+        if (input_feed_samples > 0)
+        {
+            uint32_t chunk = input_output_samples / input_feed_samples;
+            if (chunk < fed && fed - chunk <= AUDIO_LATENCY_FEED_HISTORY)
+            {
+                origin_us = input_feed_times[chunk % AUDIO_LATENCY_FEED_HISTORY];
+                offset_us = static_cast<int64_t>(input_output_samples % input_feed_samples) * 1000000 / 16000;
+            }
+        }
+        input_output_samples += samples;
+        UtilsLatency::Instance().Record(UtilsLatencyUplinkAfe, origin_us, UtilsLatency::Now());
+
+        // Tap processed audio on the capture timeline
+        if (tap.IsEnabled(AudioTapAfe))
+        {
+            tap.WritePcm(AudioTapAfe, data, samples, 16000, 1, origin_us > 0 ? origin_us + offset_us : UtilsLatency::Now());
+        }
+
+        // Copy the lent frame into a pooled encode slot
+        PushTaskToEncodeQueue(AudioTaskTypeEncodeToSendQueue, data, samples, origin_us);
     };
 
     // Set audio processor output callback to push encoded data to send queue
@@ -97,6 +229,22 @@ void AudioService::Initialize(AudioCodec *codec_data)
 
     // Create the timer
     ESP_ERROR_CHECK(esp_timer_create(&audio_service_power_timer_args, &audio_service_power_timer));
+
+    // Initialize prewarm timer, powers the codec up off the caller's task
+    esp_timer_create_args_t audio_service_prewarm_timer_args = {
+        .callback = [](void *arg)
+        {
+            AudioService *audio_service = (AudioService *)arg;
+            audio_service->ApplyPrewarm();
+        },
+        .arg = this,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "audio_service_prewarm_timer",
+        .skip_unhandled_events = true,
+    };
+
+    // Create the timer
+    ESP_ERROR_CHECK(esp_timer_create(&audio_service_prewarm_timer_args, &audio_service_prewarm_timer));
 }
 
 // Start audio service
@@ -128,18 +276,29 @@ void AudioService::Start()
     };
 
     // Create audio output task
-    xTaskCreate(audio_output_task, "audio_output_task", 2048, this, 4, &audio_output_task_handle);
+    xTaskCreate(audio_output_task, "audio_output_task", AUDIO_OUTPUT_TASK_STACK_SIZE, this, 4, &audio_output_task_handle);
 
-    // Define opus codec task lambda
-    auto audio_opus_codec_task = [](void *arg)
+    // Define opus decode task lambda
+    auto audio_opus_decode_task = [](void *arg)
     {
         AudioService *audio_service = (AudioService *)arg;
-        audio_service->OpusCodecTask();
+        audio_service->OpusDecodeTask();
         vTaskDelete(nullptr);
     };
 
-    // Create opus codec task
-    xTaskCreate(audio_opus_codec_task, "audio_opus_codec_task", 2048 * 13, this, 2, &opus_codec_task_handle);
+    // Create opus decode task
+    xTaskCreatePinnedToCore(audio_opus_decode_task, "audio_opus_decode_task", AUDIO_DECODE_TASK_STACK_SIZE, this, AUDIO_DECODE_TASK_PRIORITY, &opus_decode_task_handle, AudioTaskCore(AUDIO_DECODE_TASK_CORE));
+
+    // Define opus encode task lambda
+    auto audio_opus_encode_task = [](void *arg)
+    {
+        AudioService *audio_service = (AudioService *)arg;
+        audio_service->OpusEncodeTask();
+        vTaskDelete(nullptr);
+    };
+
+    // Create opus encode task
+    xTaskCreatePinnedToCore(audio_opus_encode_task, "audio_opus_encode_task", AUDIO_ENCODE_TASK_STACK_SIZE, this, AUDIO_ENCODE_TASK_PRIORITY, &opus_encode_task_handle, AudioTaskCore(AUDIO_ENCODE_TASK_CORE));
 }
 
 // Stop audio service
@@ -152,14 +311,33 @@ void AudioService::Stop()
     // Set audio processor not running event bit
     xEventGroupSetBits(event_group, AS_EVENT_AUDIO_PROCESSOR_RUNNING);
 
-    // lock audio queue mutex and notify all waiting tasks
-    std::lock_guard<std::mutex> lock(audio_queue_mutex);
-
     // Clear audio queues
-    audio_encode_queue.clear();
-    audio_decode_queue.clear();
-    audio_playback_queue.clear();
-    audio_queue_cv.notify_all();
+    audio_encode_queue.RequestClear();
+    audio_decode_queue.RequestClear();
+    audio_prompt_queue.RequestClear();
+    stream_source.playback_queue.RequestClear();
+    prompt_source.playback_queue.RequestClear();
+    jitter_buffer.RequestReset();
+
+    // Wake all audio tasks so they observe the stop flag
+    NotifyAudioTasks();
+}
+
+// Wake audio tasks blocked on their notifications
+void AudioService::NotifyAudioTasks()
+{
+    if (audio_output_task_handle != nullptr)
+    {
+        xTaskNotifyGive(audio_output_task_handle);
+    }
+    if (opus_decode_task_handle != nullptr)
+    {
+        xTaskNotifyGive(opus_decode_task_handle);
+    }
+    if (opus_encode_task_handle != nullptr)
+    {
+        xTaskNotifyGive(opus_encode_task_handle);
+    }
 }
 
 // Read audio data from playback queue
@@ -168,64 +346,45 @@ bool AudioService::ReadAudioData(std::vector<int16_t> &data, int sample_rate, in
     // Check if codec input is enabled
     if (!codec->GetInputEnabled())
     {
-        // Disable audio power timer to permit codec input
-        esp_timer_stop(audio_service_power_timer);
-
-        // Permit codec input after stopping the timer
-        esp_timer_start_periodic(audio_service_power_timer, AUDIO_POWER_CHECK_INTERVAL_MS * 1000);
-
-        // Enable codec input
-        codec->EnableInput(true);
+        PowerUp(true, false, esp_timer_get_time());
     }
 
     // Resample if needed
     if (codec->GetInputSampleRate() != sample_rate)
     {
-        // Resize data buffer and read input data
-        data.resize(samples * codec->GetInputSampleRate() / sample_rate * codec->GetInputChannels());
-        if (!codec->InputData(data))
+        // Read input data into the persistent capture buffer
+        input_capture_buffer.resize(samples * codec->GetInputSampleRate() / sample_rate * codec->GetInputChannels());
+        if (!codec->InputData(input_capture_buffer, &input_capture_us))
         {
             // Return false if input failed
             return false;
         }
-
-        // Perform resampling
-        if (codec->GetInputChannels() == 2)
+        if (tap.IsEnabled(AudioTapMic))
         {
-            auto mic_channel = std::vector<int16_t>(data.size() / 2);
-            auto reference_channel = std::vector<int16_t>(data.size() / 2);
-            for (size_t i = 0, j = 0; i < mic_channel.size(); ++i, j += 2)
-            {
-                mic_channel[i] = data[j];
-                reference_channel[i] = data[j + 1];
-            }
-            auto resampled_mic = std::vector<int16_t>(input_resampler.GetOutputSamples(mic_channel.size()));
-            auto resampled_reference = std::vector<int16_t>(reference_resampler.GetOutputSamples(reference_channel.size()));
-            input_resampler.Process(mic_channel.data(), mic_channel.size(), resampled_mic.data());
-            reference_resampler.Process(reference_channel.data(), reference_channel.size(), resampled_reference.data());
-            data.resize(resampled_mic.size() + resampled_reference.size());
-            for (size_t i = 0, j = 0; i < resampled_mic.size(); ++i, j += 2)
-            {
-                data[j] = resampled_mic[i];
-                data[j + 1] = resampled_reference[i];
-            }
+            tap.WritePcm(AudioTapMic, input_capture_buffer.data(), input_capture_buffer.size(), codec->GetInputSampleRate(), codec->GetInputChannels(), input_capture_us);
         }
-        else
+
+        // Resample all channels in one pass, mic and reference stay interleaved
+        data.resize(input_resampler.GetOutputSamples(input_capture_buffer.size()));
+        input_resampler.Process(input_capture_buffer.data(), input_capture_buffer.size(), data.data());
+        if (tap.IsEnabled(AudioTapResampled))
         {
-            auto resampled = std::vector<int16_t>(input_resampler.GetOutputSamples(data.size()));
-            input_resampler.Process(data.data(), data.size(), resampled.data());
-            data = std::move(resampled);
+            tap.WritePcm(AudioTapResampled, data.data(), data.size(), sample_rate, codec->GetInputChannels(), input_capture_us);
         }
     }
     else
     {
         // Read input data directly
         data.resize(samples * codec->GetInputChannels());
-        if (!codec->InputData(data))
+        if (!codec->InputData(data, &input_capture_us))
         {
             // Return false if input failed
             return false;
         }
+        if (tap.IsEnabled(AudioTapMic))
+        {
+            tap.WritePcm(AudioTapMic, data.data(), data.size(), sample_rate, codec->GetInputChannels(), input_capture_us);
+        }
     }
 
     // Update last input time
@@ -239,8 +398,16 @@ bool AudioService::ReadAudioData(std::vector<int16_t> &data, int sample_rate, in
 void AudioService::AudioInputTask()
 {
     // Audio input task loop
+    bool capturing = false;
     while (true)
     {
+        // Let the input stream discard capture while the processor is stopped
+        if (input_stream && capturing && !(xEventGroupGetBits(event_group) & AS_EVENT_AUDIO_PROCESSOR_RUNNING))
+        {
+            codec->SetInputStreamActive(false);
+            capturing = false;
+        }
+
         // Wait until audio processor is running
         EventBits_t bits = xEventGroupWaitBits(event_group, AS_EVENT_AUDIO_PROCESSOR_RUNNING, pdFALSE, pdFALSE, portMAX_DELAY);
 
@@ -250,24 +417,51 @@ void AudioService::AudioInputTask()
             break;
         }
 
-        // Check if audio input need warmup
-        if (audio_input_need_warmup)
+        // Resume the input stream without audio captured before the processor ran
+        if (input_stream && !capturing)
         {
-            audio_input_need_warmup = false;
-            vTaskDelay(pdMS_TO_TICKS(120));
+            codec->ResetInputStream();
+            codec->SetInputStreamActive(true);
+            capturing = true;
+        }
+
+        // Prime capture until the codec delivers signal
+        if (input_power_state == AudioPowerWarming && (bits & AS_EVENT_AUDIO_PROCESSOR_RUNNING))
+        {
+            PrimeInput();
             continue;
         }
 
         // Process audio if processor is running
         if (bits & AS_EVENT_AUDIO_PROCESSOR_RUNNING)
         {
-            std::vector<int16_t> data;
             int samples = audio_processor->GetFeedSize();
+
+            // With an input stream, sleep until the DMA has queued a full feed chunk
+            size_t chunk = static_cast<size_t>(samples) * codec->GetInputSampleRate() / 16000 * codec->GetInputChannels();
+            if (input_stream && samples > 0 && !codec->WaitInputStreamData(audio_input_task_handle, chunk))
+            {
+                ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(AUDIO_INPUT_STREAM_WAIT_MS));
+                continue;
+            }
             if (samples > 0)
             {
-                if (ReadAudioData(data, 16000, samples))
+                if (ReadAudioData(input_data_buffer, 16000, samples))
                 {
-                    audio_processor->Feed(std::move(data));
+                    // Pair mic samples with what the speaker played meanwhile
+                    if (loopback_enabled)
+                    {
+                        AddLoopbackReference(input_data_buffer, input_capture_us);
+                    }
+
+                    // Remember the time the last sample of this chunk was captured
+                    uint32_t fed = input_feed_count.load(std::memory_order_relaxed);
+                    input_feed_times[fed % AUDIO_LATENCY_FEED_HISTORY] = input_capture_us + samples * 1000000LL / 16000;
+                    input_feed_samples = samples;
+
+                    // Feed audio processor
+                    audio_processor->Feed(input_data_buffer);
+                    input_feed_count.store(fed + 1, std::memory_order_release);
                     continue;
                 }
             }
@@ -281,356 +475,1281 @@ void AudioService::AudioInputTask()
 // Audio output task
 void AudioService::AudioOutputTask()
 {
+    // Register as consumer of every playback queue
+    stream_source.playback_queue.SetConsumer(xTaskGetCurrentTaskHandle());
+    prompt_source.playback_queue.SetConsumer(xTaskGetCurrentTaskHandle());
+
     // Audio output task loop
     while (true)
     {
-        // Lock audio queue mutex
-        std::unique_lock<std::mutex> lock(audio_queue_mutex);
-
-        // Initialize wait condition
-        auto wait_condition = [this]()
-        {
-            return !audio_playback_queue.empty() || service_stopped;
-        };
-
-        // Wait for playback queue to have data or service to stop
-        audio_queue_cv.wait(lock, wait_condition);
-
         // Check for service stopped
         if (service_stopped)
         {
             break;
         }
 
-        // Pop audio task from playback queue
-        auto task = std::move(audio_playback_queue.front());
-        audio_playback_queue.pop_front();
-        audio_queue_cv.notify_all();
-        lock.unlock();
-
-        // Output audio data using codec
-        if (!codec->GetOutputEnabled())
+        // Mix the next segment, or wait for decoded frames
+        if (!MixSources())
         {
-            esp_timer_stop(audio_service_power_timer);
-            esp_timer_start_periodic(audio_service_power_timer, AUDIO_POWER_CHECK_INTERVAL_MS * 1000);
-            codec->EnableOutput(true);
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            continue;
         }
 
-        // Output audio data
-        codec->OutputData(task->pcm);
-
         // Update last output time
         last_output_time = std::chrono::steady_clock::now();
     }
 }
 
-// Opus codec task
-void AudioService::OpusCodecTask()
+// Mix the next segment of all playing sources into the codec
+bool AudioService::MixSources()
 {
-    // Opus codec task loop
-    while (true)
-    {
-        // Lock audio queue mutex
-        std::unique_lock<std::mutex> lock(audio_queue_mutex);
-
-        // Define wait condition
-        auto wait_condition = [this]()
-        {
-            return service_stopped || (!audio_encode_queue.empty() && audio_send_queue.size() < MAX_SEND_PACKETS_IN_QUEUE) || (!audio_decode_queue.empty() && audio_playback_queue.size() < MAX_PLAYBACK_TASKS_IN_QUEUE);
-        };
-
-        // Wait for encode/decode tasks or service to stop
-        audio_queue_cv.wait(lock, wait_condition);
+    // Find the frame each source plays and the longest segment all of them can fill
+    AudioServiceSource *sources[] = {&stream_source, &prompt_source};
+    size_t segment = codec->GetOutputSampleRate() / 1000 * AUDIO_MIXER_SEGMENT_MS;
+    uint32_t active_mask = 0;
 
-        // Check for service stopped
-        if (service_stopped)
+    // With an output stream, mix once a full segment fits; the DMA interrupt wakes this task
+    if (output_stream && !codec->WaitOutputStreamSpace(audio_output_task_handle, segment))
+    {
+        return false;
+    }
+    bool ready = false;
+    for (auto *source : sources)
+    {
+        // Restart at the front frame when it changed, also after a clear
+        auto *task = source->playback_queue.Front();
+        if (task != source->playing)
         {
-            break;
+            source->playing = task;
+            source->played = 0;
         }
 
-        // If there are tasks to encode
-        if (!audio_decode_queue.empty() && audio_playback_queue.size() < MAX_PLAYBACK_TASKS_IN_QUEUE)
+        // A source that runs dry while more frames are on the way has underrun
+        bool pending = source->pending.load(std::memory_order_acquire);
+        if (task == nullptr)
         {
-            // Pop packet from decode queue
-            auto packet = std::move(audio_decode_queue.front());
-            audio_decode_queue.pop_front();
-            audio_queue_cv.notify_all();
-            lock.unlock();
-
-            // Create audio task for playback
-            auto task = std::make_unique<AudioServiceTask>();
-            task->type = AudioTaskTypeDecodeToPlaybackQueue;
-            task->timestamp = packet->timestamp;
-
-            // Set decode sample rate if needed
-            SetDecodeSampleRate(packet->sample_rate, packet->frame_duration);
-
-            // Decode opus data
-            if (opus_decoder->Decode(std::move(packet->payload), task->pcm))
-            {
-                // If resampling is needed
-                if (opus_decoder->SampleRate() != codec->GetOutputSampleRate())
-                {
-                    int target_size = output_resampler.GetOutputSamples(task->pcm.size());
-                    std::vector<int16_t> resampled(target_size);
-                    output_resampler.Process(task->pcm.data(), task->pcm.size(), resampled.data());
-                    task->pcm = std::move(resampled);
-                }
-
-                // Push task to playback queue
-                lock.lock();
-                audio_playback_queue.push_back(std::move(task));
-                audio_queue_cv.notify_all();
-            }
-            else
+            if (source->had_data && pending)
             {
-                lock.lock();
+                mixer.Underrun(source->mixer_source);
             }
+            source->had_data = false;
+            active_mask |= pending ? 1u << source->mixer_source : 0;
+            continue;
         }
 
-        // If there are tasks to decode
-        if (!audio_encode_queue.empty() && audio_send_queue.size() < MAX_SEND_PACKETS_IN_QUEUE)
+        // Shorten the segment to what this frame has left
+        size_t size = task->view != nullptr ? task->view_size : task->pcm.size();
+        if (source->played >= size)
         {
-            // Pop task from encode queue
-            auto task = std::move(audio_encode_queue.front());
-            audio_encode_queue.pop_front();
-            audio_queue_cv.notify_all();
-            lock.unlock();
-
-            // Create audio stream packet for sending
-            auto packet = std::make_unique<AudioServiceStreamPacket>();
-            packet->frame_duration = OPUS_FRAME_DURATION_MS;
-            packet->sample_rate = 16000;
-            packet->timestamp = task->timestamp;
-            if (!opus_encoder->Encode(std::move(task->pcm), packet->payload))
-            {
-                continue;
-            }
-
-            // Push packet to send queue
-            if (task->type == AudioTaskTypeEncodeToSendQueue)
-            {
-                {
-                    std::lock_guard<std::mutex> lock(audio_queue_mutex);
-                    audio_send_queue.push_back(std::move(packet));
-                }
-                if (callbacks.on_send_queue_available)
-                {
-                    callbacks.on_send_queue_available();
-                }
-            }
-
-            lock.lock();
+            source->played = 0;
         }
+        segment = std::min(segment, size - source->played);
+        source->had_data = true;
+        active_mask |= 1u << source->mixer_source;
+        ready = true;
     }
-}
 
-// Set decode sample rate and frame duration
-void AudioService::SetDecodeSampleRate(int sample_rate, int frame_duration)
-{
-    // Check if current decoder matches requested sample rate and frame duration
-    if (opus_decoder->SampleRate() == sample_rate && opus_decoder->DurationMS() == frame_duration)
+    // Gaps in the output stream count as underruns only while a source plays
+    if (output_stream)
     {
-        // No need to reconfigure
-        return;
+        codec->SetOutputStreamActive(active_mask != 0);
     }
 
-    // Recreate opus decoder with new sample rate and frame duration
-    opus_decoder.reset();
-    opus_decoder = std::make_unique<OpusDecoderWrapper>(sample_rate, 1, frame_duration);
-
-    // Reconfigure output resampler
-    if (codec)
+    // Nothing to play
+    if (!ready || segment == 0)
     {
-        // Check if resampling is needed
-        if (opus_decoder->SampleRate() != codec->GetOutputSampleRate())
-        {
-            output_resampler.Configure(opus_decoder->SampleRate(), codec->GetOutputSampleRate());
-        }
+        return false;
     }
-}
-
-// Push task to encode queue
-void AudioService::PushTaskToEncodeQueue(AudioServiceTaskType type, std::vector<int16_t> &&pcm)
-{
-    auto task = std::make_unique<AudioServiceTask>();
-    task->type = type;
-    task->pcm = std::move(pcm);
 
-    // Lock audio queue mutex
-    std::unique_lock<std::mutex> lock(audio_queue_mutex);
+    // Output audio data using codec
+    if (!codec->GetOutputEnabled())
+    {
+        PowerUp(false, true, esp_timer_get_time());
+    }
 
-    // If the encode queue is full
-    if (type == AudioTaskTypeEncodeToSendQueue && !timestamp_queue.empty())
+    // Mix every source with data, reading prompt cache views in place
+    mixer.Begin(segment, active_mask);
+    for (auto *source : sources)
     {
-        // Assign timestamp if available
-        if (timestamp_queue.size() <= MAX_TIMESTAMPS_IN_QUEUE)
+        auto *task = source->playing;
+        if (task != nullptr)
         {
-            // Assign the oldest timestamp
-            task->timestamp = timestamp_queue.front();
+            const int16_t *pcm = task->view != nullptr ? task->view : task->pcm.data();
+            mixer.Add(source->mixer_source, pcm + source->played, 0, segment);
+            source->played += segment;
         }
-
-        // Pop used timestamp
-        timestamp_queue.pop_front();
+    }
+    const int16_t *mixed = mixer.End();
+    if (tap.IsEnabled(AudioTapPlayback))
+    {
+        tap.WritePcm(AudioTapPlayback, mixed, segment, codec->GetOutputSampleRate(), 1, UtilsLatency::Now());
+    }
+    if (loopback_enabled)
+    {
+        RecordLoopback(mixed, segment);
+    }
+    if (output_stream)
+    {
+        codec->WriteOutputStream(mixed, segment);
+    }
+    else
+    {
+        codec->OutputData(mixed, segment);
     }
 
-    // Initialize wait condition
-    auto wait_condition = [this]()
+    // Report time to first sample after a power-up
+    if (output_power_state == AudioPowerWarming)
     {
-        return audio_encode_queue.size() < MAX_ENCODE_TASKS_IN_QUEUE;
-    };
+        output_power_state = AudioPowerOn;
+        UtilsLatency::Instance().Record(UtilsLatencyPowerOutput, output_power_request_us, UtilsLatency::Now());
+    }
 
-    // Wait until there is space in the encode queue
-    audio_queue_cv.wait(lock, wait_condition);
+    // Return finished frames to their playback queues
+    for (auto *source : sources)
+    {
+        auto *task = source->playing;
+        if (task == nullptr || source->played < (task->view != nullptr ? task->view_size : task->pcm.size()))
+        {
+            continue;
+        }
 
-    // Push task to encode queue
-    audio_encode_queue.push_back(std::move(task));
+        // Record playback latency of stream frames
+        int64_t now_us = UtilsLatency::Now();
+        UtilsLatency::Instance().Record(UtilsLatencyDownlinkPlayback, task->stage_us, now_us);
+        UtilsLatency::Instance().Record(UtilsLatencyDownlinkTotal, task->origin_us, now_us);
+
+        // Release the slot
+        task->view = nullptr;
+        task->cached.reset();
+        source->playing = nullptr;
+        source->played = 0;
+        source->playback_queue.Release();
+        frames_played++;
+    }
 
-    // Notify waiting tasks
-    audio_queue_cv.notify_all();
+    // Return true when a segment was written
+    return true;
 }
 
-// Push packet to decode queue
-bool AudioService::PushPacketToDecodeQueue(std::unique_ptr<AudioServiceStreamPacket> packet, bool wait)
+// Record mixed samples as the echo reference
+void AudioService::RecordLoopback(const int16_t *pcm, size_t samples)
 {
-    // Lock audio queue mutex
-    std::unique_lock<std::mutex> lock(audio_queue_mutex);
-
-    // If audio decode queue is full
-    if (audio_decode_queue.size() >= MAX_DECODE_PACKETS_IN_QUEUE)
+    // The output stream dates samples from its DMA events
+    int rate = codec->GetOutputSampleRate();
+    int64_t play_us = codec->GetOutputPlayTime();
+    if (!output_stream)
     {
-        if (wait)
+        // Blocking writes queue behind what the DMA still holds; after a stall they wait out its descriptors
+        int64_t queued_us = loopback_start_us + static_cast<int64_t>(loopback_played_samples * 1000000 / rate);
+        if (queued_us < play_us)
         {
-            // Initialize wait condition
-            auto wait_condition = [this]()
-            {
-                return audio_decode_queue.size() < MAX_DECODE_PACKETS_IN_QUEUE;
-            };
-
-            // Wait until there is space in the decode queue
-            audio_queue_cv.wait(lock, wait_condition);
+            loopback_start_us = play_us;
+            loopback_played_samples = 0;
         }
         else
         {
-            return false;
+            play_us = queued_us;
         }
+        loopback_played_samples += samples;
     }
 
-    // Push packet to decode queue
-    audio_decode_queue.push_back(std::move(packet));
-
-    // Notify waiting tasks
-    audio_queue_cv.notify_all();
-
-    // Return true on success
-    return true;
-}
-
-// Pop packet from send queue
-std::unique_ptr<AudioServiceStreamPacket> AudioService::PopPacketFromSendQueue()
-{
-    // Lock audio queue mutex
-    std::lock_guard<std::mutex> lock(audio_queue_mutex);
-
-    // If send queue is empty, return nullptr
-    if (audio_send_queue.empty())
-    {
-        return nullptr;
-    }
-
-    // Pop packet from send queue
-    auto packet = std::move(audio_send_queue.front());
-
-    // Remove packet from send queue
-    audio_send_queue.pop_front();
-
-    // Notify waiting tasks
-    audio_queue_cv.notify_all();
-
-    // Return the packet
-    return packet;
-}
-
-// Enable or disable voice processing
-void AudioService::EnableVoiceProcessing(bool enable)
-{
-    // Enable or disable audio processor
-    if (enable)
+    // Store at the AFE rate
+    if (rate != 16000)
     {
-        // Initialize audio processor if not already done
-        if (!audio_processor_initialized)
-        {
-            audio_processor->Initialize(codec, OPUS_FRAME_DURATION_MS);
-            audio_processor_initialized = true;
-        }
-
-        ResetDecoder();
-        audio_input_need_warmup = true;
-        audio_processor->Start();
-        xEventGroupSetBits(event_group, AS_EVENT_AUDIO_PROCESSOR_RUNNING);
+        loopback_buffer.resize(loopback_resampler.GetOutputSamples(samples));
+        loopback_resampler.Process(pcm, samples, loopback_buffer.data());
+        loopback_reference.Write(loopback_buffer.data(), loopback_buffer.size(), play_us);
     }
     else
     {
-        audio_processor->Stop();
-        xEventGroupClearBits(event_group, AS_EVENT_AUDIO_PROCESSOR_RUNNING);
+        loopback_reference.Write(pcm, samples, play_us);
     }
 }
 
-// Play sound from OGG data
-void AudioService::PlaySound(const std::string_view &ogg)
+// Interleave the loopback reference with mono mic samples captured from capture_us
+void AudioService::AddLoopbackReference(std::vector<int16_t> &data, int64_t capture_us)
 {
-    // If codec output is not enabled, enable it
-    if (!codec->GetOutputEnabled())
+    // Refine the echo delay now and then
+    size_t samples = data.size();
+    if (capture_us - loopback_estimate_us >= AUDIO_REFERENCE_ESTIMATE_INTERVAL_MS * 1000)
     {
-        esp_timer_stop(audio_service_power_timer);
-        esp_timer_start_periodic(audio_service_power_timer, AUDIO_POWER_CHECK_INTERVAL_MS * 1000);
-        codec->EnableOutput(true);
+        loopback_reference.EstimateDelay(data.data(), samples, capture_us);
+        loopback_estimate_us = capture_us;
     }
 
-    // Parse OGG data and play sound
-    const uint8_t *buf = reinterpret_cast<const uint8_t *>(ogg.data());
-    size_t size = ogg.size();
-    size_t offset = 0;
+    // Read the aligned reference
+    input_loopback_reference.resize(samples);
+    loopback_reference.Read(input_loopback_reference.data(), samples, capture_us);
 
-    // Lambda function to find next OGG page
-    auto find_page = [&](size_t start) -> size_t
+    // Interleave mic and reference, one 32-bit frame at a time
+    input_loopback_buffer.resize(samples * 2);
+    const int16_t *mic = data.data();
+    const int16_t *reference = input_loopback_reference.data();
+    int16_t *dst = input_loopback_buffer.data();
+    for (size_t i = 0; i < samples; ++i)
     {
-        for (size_t i = start; i + 4 <= size; ++i)
-        {
-            if (buf[i] == 'O' && buf[i + 1] == 'g' && buf[i + 2] == 'g' && buf[i + 3] == 'S')
-            {
-                return i;
-            }
-        }
-        return static_cast<size_t>(-1);
-    };
+        uint32_t frame = static_cast<uint16_t>(mic[i]) | (static_cast<uint32_t>(static_cast<uint16_t>(reference[i])) << 16);
+        std::memcpy(dst + i * 2, &frame, sizeof(frame));
+    }
+    data.swap(input_loopback_buffer);
+}
 
-    // OGG decoding state variables
-    bool seen_head = false;
-    bool seen_tags = false;
-    int sample_rate = 16000;
+// Opus decode task
+void AudioService::OpusDecodeTask()
+{
+    // Register as decode and prompt queue consumer
+    audio_decode_queue.SetConsumer(xTaskGetCurrentTaskHandle());
+    audio_prompt_queue.SetConsumer(xTaskGetCurrentTaskHandle());
 
-    // Loop through OGG pages
+    // Opus decode task loop
     while (true)
     {
-        size_t pos = find_page(offset);
-        if (pos == static_cast<size_t>(-1))
+        // Check for service stopped
+        if (service_stopped)
         {
             break;
         }
 
-        offset = pos;
-        if (offset + 27 > size)
-        {
-            break;
-        }
+        // Track whether a frame was produced in this pass
+        bool busy = false;
 
-        const uint8_t *page = buf + offset;
-        uint8_t page_segments = page[26];
-        size_t seg_table_off = offset + 27;
-        if (seg_table_off + page_segments > size)
+        // Move received stream packets into the jitter buffer
+        AudioServiceStreamPacket *received = nullptr;
+        while ((received = audio_decode_queue.Front()) != nullptr)
         {
-            break;
+            jitter_buffer.Push(received->payload, received->sample_rate, received->frame_duration, received->timestamp, received->origin_us);
+            audio_decode_queue.Release();
+        }
+
+        // Decode the next prompt frame, prompts play alongside the stream
+        if (!prompt_source.playback_queue.Full())
+        {
+            auto *prompt = audio_prompt_queue.Front();
+            if (prompt != nullptr && prompt->cache_play != nullptr)
+            {
+                // Stream cached PCM, keeping the slot until the last chunk
+                if (PlayCachedPrompt(*prompt))
+                {
+                    audio_prompt_queue.Release();
+                }
+                busy = true;
+            }
+            else if (prompt != nullptr)
+            {
+                // Decode the prompt, filling its cache entry on the way
+                DecodePrompt(*prompt);
+                audio_prompt_queue.Release();
+                busy = true;
+            }
+        }
+        prompt_source.pending.store(!audio_prompt_queue.Empty(), std::memory_order_release);
+
+        // Pull the next playout frame from the jitter buffer; an underrun
+        // is only concealed once stream playback has run dry
+        auto &stream_queue = stream_source.playback_queue;
+        if (!stream_queue.Full() && (!jitter_buffer.Empty() || !jitter_buffer.IsPlaying() || stream_queue.Empty()))
+        {
+            const AudioJitterPacket *packet = nullptr;
+            auto action = jitter_buffer.Pop(packet, esp_timer_get_time());
+            if (action != AudioJitterNone)
+            {
+                if (packet != nullptr)
+                {
+                    int64_t origin_us = action == AudioJitterDecode ? packet->arrival_us : 0;
+                    DecodeToPlaybackQueue(stream_source, action, packet->payload.data(), packet->payload.size(), packet->frame_duration, packet->timestamp, origin_us);
+                }
+                else
+                {
+                    DecodeToPlaybackQueue(stream_source, action, nullptr, 0, jitter_buffer.FrameDuration(), 0, 0);
+                }
+                busy = true;
+            }
+        }
+        stream_source.pending.store(jitter_buffer.IsPlaying(), std::memory_order_release);
+
+        // Wait for new work when idle
+        if (!busy)
+        {
+            // Ask to be woken when stream playback drains, either because it
+            // is full or because a jitter underrun waits for it to run dry
+            if (stream_queue.Full() || (jitter_buffer.IsPlaying() && !stream_queue.Empty()))
+            {
+                stream_queue.NotifyOnSpace(tskDEFAULT_INDEX_TO_NOTIFY);
+            }
+
+            // Ask to be woken when prompt playback drains with prompts waiting
+            if (prompt_source.playback_queue.Full() && !audio_prompt_queue.Empty())
+            {
+                prompt_source.playback_queue.NotifyOnSpace(tskDEFAULT_INDEX_TO_NOTIFY);
+            }
+
+            // Poll while prebuffering so a short talkspurt is not held back
+            ulTaskNotifyTake(pdTRUE, jitter_buffer.IsPrebuffering() ? pdMS_TO_TICKS(jitter_buffer.FrameDuration()) : portMAX_DELAY);
+        }
+    }
+}
+
+// Opus encode task
+void AudioService::OpusEncodeTask()
+{
+    // Register as encode queue consumer
+    audio_encode_queue.SetConsumer(xTaskGetCurrentTaskHandle());
+
+    // Opus encode task loop
+    while (true)
+    {
+        // Check for service stopped
+        if (service_stopped)
+        {
+            break;
+        }
+
+        // Wait for room in the send queue on its own notification index, so
+        // encode queue wakeups stay pending; time out to observe a stop
+        if (audio_send_queue.Full())
+        {
+            audio_send_queue.WaitForSpace(pdMS_TO_TICKS(100));
+            continue;
+        }
+
+        // Apply a packetization change
+        int packet_ms = uplink_packet_ms.load();
+        if (packet_ms != uplink_packet_ms_applied)
+        {
+            int frames = (packet_ms > 0 ? packet_ms : AUDIO_UPLINK_MAX_PACKET_MS) / OPUS_FRAME_DURATION_MS;
+            bitrate_controller.SetPacketFrames(frames, packet_ms == 0);
+            uplink_packet_ms_applied = packet_ms;
+        }
+
+        // Send the joined frames once the packet is complete
+        if (uplink_packetizer.Count() > 0 && uplink_packetizer.Count() >= bitrate_controller.PacketFrames())
+        {
+            FlushUplinkPacket();
+            continue;
+        }
+
+        // Send frames held during silence in a burst at speech onset, ahead of live frames
+        if (vad_replay > 0)
+        {
+            SendVadReplayFrame();
+            continue;
+        }
+
+        // Apply wake gate requests and close the gate after silence
+        if (wake_enabled)
+        {
+            UpdateWakeGate();
+        }
+
+        // Wait for a task to encode, send a partial packet when capture pauses
+        auto *task = FrontEncodeTask();
+        if (task == nullptr)
+        {
+            if (uplink_packetizer.Count() == 0)
+            {
+                ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            }
+            else if (ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(OPUS_FRAME_DURATION_MS * 2)) == 0 && audio_encode_queue.Empty())
+            {
+                FlushUplinkPacket();
+            }
+            continue;
+        }
+
+        // Resume from a clean encoder state after muting
+        bool muted = uplink_muted.load();
+        if (muted != uplink_muted_applied)
+        {
+            if (!muted)
+            {
+                opus_encoder->ResetState();
+            }
+            uplink_muted_applied = muted;
+            uplink_muted_frames = 0;
+            ClearVadPreroll();
+        }
+
+        // Closed wake gate: nothing is encoded or sent until the wake word fires
+        if (wake_enabled && !uplink_awake_applied && task->type == AudioTaskTypeEncodeToSendQueue)
+        {
+            GateWakeFrame(task);
+            continue;
+        }
+
+        // Muted uplink: skip the encoder and send a DTX frame per update interval
+        if (muted && task->type == AudioTaskTypeEncodeToSendQueue)
+        {
+            EncodeMutedFrame(task);
+            continue;
+        }
+
+        // Apply rate decisions taken on send audio queued behind the packet in flight and uplink losses
+        size_t queued = audio_send_queue.Size();
+        int queue_ms = static_cast<int>(queued > 0 ? queued - 1 : 0) * bitrate_controller.PacketFrames() * OPUS_FRAME_DURATION_MS;
+        bool rate_changed = bitrate_controller.Update(UtilsLatency::Now(), queue_ms);
+        if (rate_changed || uplink_fec.load() != opus_encoder->IsFecEnabled())
+        {
+            ApplyEncoderSettings();
+        }
+
+        // Encode pcm data
+        int64_t encode_start_us = UtilsLatency::Now();
+        bool encoded = opus_encoder->Encode(std::move(task->pcm), uplink_frame);
+        AudioServiceTaskType type = task->type;
+        uint32_t task_timestamp = task->timestamp;
+        int64_t task_origin_us = task->origin_us;
+        int64_t task_stage_us = task->stage_us;
+        ReleaseEncodeTask();
+        if (!encoded || type != AudioTaskTypeEncodeToSendQueue)
+        {
+            continue;
+        }
+        frames_encoded++;
+        int64_t now_us = UtilsLatency::Now();
+        UtilsLatency::Instance().Record(UtilsLatencyUplinkEncode, task_stage_us, now_us);
+
+        // Track recent frame size and encode time
+        uplink_frame_bytes = (uplink_frame_bytes * 7 + uplink_frame.size()) / 8;
+        uplink_encode_us = (uplink_encode_us * 7 + static_cast<uint32_t>(now_us - encode_start_us)) / 8;
+
+        // Tap every encoded frame, including those the VAD gate holds back
+        if (tap.IsEnabled(AudioTapUplink))
+        {
+            tap.WriteOpus(AudioTapUplink, uplink_frame.data(), uplink_frame.size(), 16000, task_origin_us > 0 ? task_origin_us : now_us);
+        }
+
+        // VAD gate: silence is held back, speech onset is sent with the frames before it
+        if (vad_gate_enabled && HoldVadFrame(task_timestamp))
+        {
+            continue;
+        }
+
+        // Join the frame to the pending packet, send that packet first if the frame cannot join it
+        if (!uplink_packetizer.Add(uplink_frame.data(), uplink_frame.size()))
+        {
+            FlushUplinkPacket();
+            uplink_packetizer.Add(uplink_frame.data(), uplink_frame.size());
+        }
+
+        // The packet is stamped with its first frame
+        if (uplink_packetizer.Count() == 1)
+        {
+            uplink_packet_timestamp = task_timestamp;
+            uplink_packet_origin_us = task_origin_us;
+        }
+    }
+}
+
+// Replace a muted frame with a DTX frame, or drop it between DTX updates
+void AudioService::EncodeMutedFrame(AudioServiceTask *task)
+{
+    // Send the frames joined before muting on their own
+    if (uplink_packetizer.Count() > 0)
+    {
+        FlushUplinkPacket();
+        return;
+    }
+
+    // Drop the frame without encoding
+    uint32_t task_timestamp = task->timestamp;
+    int64_t task_origin_us = task->origin_us;
+    ReleaseEncodeTask();
+    frames_muted++;
+    muted_encode_us_saved += uplink_encode_us;
+
+    // Keep the stream alive at the DTX cadence
+    if (uplink_muted_frames++ % (AUDIO_UPLINK_DTX_INTERVAL_MS / OPUS_FRAME_DURATION_MS) != 0)
+    {
+        muted_bytes_saved += uplink_frame_bytes;
+        return;
+    }
+    const uint8_t dtx_frame = AUDIO_UPLINK_DTX_TOC;
+    uplink_packetizer.Add(&dtx_frame, sizeof(dtx_frame));
+    uplink_packet_timestamp = task_timestamp;
+    uplink_packet_origin_us = task_origin_us;
+    FlushUplinkPacket();
+    muted_bytes_saved += uplink_frame_bytes > sizeof(dtx_frame) ? uplink_frame_bytes - sizeof(dtx_frame) : 0;
+}
+
+// Keep the encoded frame in the VAD pre-roll ring, overwriting the oldest
+void AudioService::StoreVadFrame(uint32_t timestamp)
+{
+    // A frame pushed out of the ring is never sent
+    AudioServiceStreamPacket &frame = vad_preroll[vad_preroll_head];
+    if (vad_preroll_count == vad_preroll.size())
+    {
+        vad_dropped_bytes += frame.payload.size();
+    }
+    frame.payload.assign(uplink_frame.begin(), uplink_frame.end());
+    frame.timestamp = timestamp;
+    vad_preroll_head = (vad_preroll_head + 1) % vad_preroll.size();
+    vad_preroll_count = std::min(vad_preroll_count + 1, vad_preroll.size());
+}
+
+// Decide whether the frame just encoded is held back, returns true when it is
+bool AudioService::HoldVadFrame(uint32_t timestamp)
+{
+    // Speech keeps the gate open, with a hangover so pauses between words are sent
+    int64_t now_us = UtilsLatency::Now();
+    if (voice_detected)
+    {
+        vad_last_voice_us = now_us;
+    }
+    bool open = vad_last_voice_us != 0 && now_us - vad_last_voice_us < AUDIO_VAD_HANGOVER_MS * 1000LL;
+    if (open)
+    {
+        // Speech onset: send the held frames and this one in a burst, oldest first
+        if (!vad_open)
+        {
+            StoreVadFrame(timestamp);
+            vad_replay = vad_preroll_count;
+            vad_preroll_count = 0;
+            vad_open = true;
+            vad_bursts++;
+            vad_burst_frames += vad_replay;
+            return true;
+        }
+        return false;
+    }
+
+    // Silence: hold the frame
+    if (vad_open)
+    {
+        vad_open = false;
+        vad_silent_frames = 0;
+    }
+    StoreVadFrame(timestamp);
+    frames_held++;
+
+    // Send the speech tail joined before the silence, then keep the stream alive at the DTX cadence
+    if (uplink_packetizer.Count() > 0)
+    {
+        FlushUplinkPacket();
+    }
+    else if (vad_silent_frames % (AUDIO_UPLINK_DTX_INTERVAL_MS / OPUS_FRAME_DURATION_MS) == 0)
+    {
+        const uint8_t dtx_frame = AUDIO_UPLINK_DTX_TOC;
+        uplink_packetizer.Add(&dtx_frame, sizeof(dtx_frame));
+        uplink_packet_timestamp = timestamp;
+        uplink_packet_origin_us = 0;
+        FlushUplinkPacket();
+        vad_keepalive_bytes += sizeof(dtx_frame);
+    }
+    vad_silent_frames++;
+    return true;
+}
+
+// Join the next held frame of an onset burst to the pending packet
+void AudioService::SendVadReplayFrame()
+{
+    // Send the pending packet first when the frame cannot join it, then retry
+    AudioServiceStreamPacket &frame = vad_preroll[(vad_preroll_head + vad_preroll.size() - vad_replay) % vad_preroll.size()];
+    if (!uplink_packetizer.Add(frame.payload.data(), frame.payload.size()))
+    {
+        FlushUplinkPacket();
+        return;
+    }
+
+    // Held frames are late by design, keep them out of latency stats
+    if (uplink_packetizer.Count() == 1)
+    {
+        uplink_packet_timestamp = frame.timestamp;
+        uplink_packet_origin_us = 0;
+    }
+    vad_replay--;
+}
+
+// Forget held frames, they are stale once the uplink was muted or gated
+void AudioService::ClearVadPreroll()
+{
+    vad_preroll_count = 0;
+    vad_replay = 0;
+    vad_open = true;
+    vad_last_voice_us = 0;
+}
+
+// Push the joined uplink frames to the send queue as one packet
+void AudioService::FlushUplinkPacket()
+{
+    // Acquire slot for sending, the caller made sure one is free
+    int frames = uplink_packetizer.Count();
+    auto *send_packet = audio_send_queue.Acquire();
+    if (send_packet == nullptr)
+    {
+        uplink_packetizer.Reset();
+        return;
+    }
+    if (!uplink_packetizer.Flush(send_packet->payload))
+    {
+        return;
+    }
+
+    // Push packet to send queue
+    send_packet->frame_duration = frames * OPUS_FRAME_DURATION_MS;
+    send_packet->sample_rate = 16000;
+    send_packet->timestamp = uplink_packet_timestamp;
+    send_packet->origin_us = uplink_packet_origin_us;
+    send_packet->stage_us = UtilsLatency::Now();
+    audio_send_queue.Commit();
+    if (callbacks.on_send_queue_available)
+    {
+        callbacks.on_send_queue_available();
+    }
+}
+
+// Get the next frame to encode, replayed pre-roll comes before queued frames
+AudioServiceTask *AudioService::FrontEncodeTask()
+{
+    if (wake_replay > 0)
+    {
+        return &wake_preroll[(wake_preroll_head + wake_preroll.size() - wake_replay) % wake_preroll.size()];
+    }
+    return audio_encode_queue.Front();
+}
+
+// Consume the frame returned by FrontEncodeTask
+void AudioService::ReleaseEncodeTask()
+{
+    if (wake_replay > 0)
+    {
+        wake_replay--;
+        return;
+    }
+    audio_encode_queue.Release();
+}
+
+// Apply wake gate requests, closing the gate once the conversation went quiet
+void AudioService::UpdateWakeGate()
+{
+    // Speech and server playback keep an open gate open
+    int64_t now_us = UtilsLatency::Now();
+    bool awake = uplink_awake.load();
+    if (awake && uplink_awake_applied)
+    {
+        if (voice_detected || uplink_muted.load())
+        {
+            wake_last_voice_us = now_us;
+        }
+        else if (now_us - wake_last_voice_us > AUDIO_WAKE_IDLE_MS * 1000LL)
+        {
+            ESP_LOGI(TAG, "Uplink idle, waiting for the wake word");
+            uplink_awake = false;
+            awake = false;
+        }
+    }
+    if (awake == uplink_awake_applied)
+    {
+        return;
+    }
+
+    // Opened without a wake word, e.g. by a button: start from live audio
+    if (awake)
+    {
+        opus_encoder->ResetState();
+        wake_last_voice_us = now_us;
+    }
+    else
+    {
+        // Closed: never replay audio that was already sent, and restart detection
+        wake_preroll_count = 0;
+        wake_replay = 0;
+        wake_word.Reset();
+        ClearVadPreroll();
+    }
+    uplink_awake_applied = awake;
+}
+
+// Run a frame through WakeNet while the gate is closed, keeping it as pre-roll
+void AudioService::GateWakeFrame(AudioServiceTask *task)
+{
+    // Send the frames joined before the gate closed on their own
+    if (uplink_packetizer.Count() > 0)
+    {
+        FlushUplinkPacket();
+        return;
+    }
+
+    // Keep the frame in the pre-roll ring, late by design so kept out of latency stats
+    bool detected = wake_word.Detect(task->pcm.data(), task->pcm.size());
+    if (!wake_preroll.empty())
+    {
+        AudioServiceTask &frame = wake_preroll[wake_preroll_head];
+        frame.type = task->type;
+        frame.pcm.assign(task->pcm.begin(), task->pcm.end());
+        frame.timestamp = task->timestamp;
+        frame.origin_us = 0;
+        frame.stage_us = 0;
+        wake_preroll_head = (wake_preroll_head + 1) % wake_preroll.size();
+        wake_preroll_count = std::min(wake_preroll_count + 1, wake_preroll.size());
+    }
+    audio_encode_queue.Release();
+    frames_gated++;
+    if (!detected)
+    {
+        return;
+    }
+
+    // Open the gate and replay the pre-roll, oldest first, ahead of live frames
+    int64_t now_us = UtilsLatency::Now();
+    wake_detected_us = now_us;
+    wake_last_voice_us = now_us;
+    uplink_awake = true;
+    uplink_awake_applied = true;
+    wake_replay = wake_preroll_count;
+    wake_preroll_count = 0;
+    opus_encoder->ResetState();
+    if (callbacks.on_wake_word)
+    {
+        callbacks.on_wake_word(wake_word.GetWakeWord());
+    }
+}
+
+// Apply controller decisions and the FEC setting to the encoder
+void AudioService::ApplyEncoderSettings()
+{
+    // Rate and bandwidth follow the controller
+    opus_encoder->SetBitrate(bitrate_controller.Bitrate());
+    opus_encoder->SetBandwidth(bitrate_controller.Bandwidth());
+
+    // FEC sizes its redundancy by the expected loss, keep a floor while it is on
+    bool fec = uplink_fec.load();
+    int loss_percent = bitrate_controller.LossPercent();
+    if (fec && loss_percent < AUDIO_UPLINK_FEC_MIN_LOSS)
+    {
+        loss_percent = AUDIO_UPLINK_FEC_MIN_LOSS;
+    }
+    opus_encoder->SetFec(fec);
+    opus_encoder->SetPacketLoss(loss_percent);
+}
+
+// Set the lost frame duration of a source, keeps decoder state
+void AudioService::SetDecodeFrameDuration(AudioServiceSource &source, int frame_duration)
+{
+    // Check if current decoder matches requested frame duration
+    if (source.decoder->DurationMS() == frame_duration)
+    {
+        // No need to reconfigure
+        return;
+    }
+
+    // Resize concealed frames only, decoded frames follow their packets
+    source.decoder->SetDuration(frame_duration);
+}
+
+// Push task to encode queue
+void AudioService::PushTaskToEncodeQueue(AudioServiceTaskType type, const int16_t *pcm, size_t samples, int64_t origin_us)
+{
+    // Wait until there is space in the encode queue
+    AudioServiceTask *task = nullptr;
+    while ((task = audio_encode_queue.Acquire()) == nullptr)
+    {
+        if (service_stopped)
+        {
+            return;
+        }
+        audio_encode_queue.WaitForSpace(pdMS_TO_TICKS(100));
+    }
+
+    // Copy pcm into the preallocated slot
+    task->type = type;
+    task->timestamp = 0;
+    task->origin_us = origin_us;
+    task->stage_us = UtilsLatency::Now();
+    task->pcm.assign(pcm, pcm + samples);
+
+    // Assign timestamp if available
+    if (type == AudioTaskTypeEncodeToSendQueue)
+    {
+        std::lock_guard<std::mutex> lock(timestamp_queue_mutex);
+        if (!timestamp_queue.empty())
+        {
+            if (timestamp_queue.size() <= MAX_TIMESTAMPS_IN_QUEUE)
+            {
+                // Assign the oldest timestamp
+                task->timestamp = timestamp_queue.front();
+            }
+
+            // Pop used timestamp
+            timestamp_queue.pop_front();
+        }
+    }
+
+    // Push task to encode queue
+    audio_encode_queue.Commit();
+}
+
+// Push packet to decode queue
+bool AudioService::PushPacketToDecodeQueue(const uint8_t *payload, size_t size, int sample_rate, int frame_duration, uint32_t timestamp, bool wait)
+{
+    // Power the speaker up while the jitter buffer prebuffers
+    if (!codec->GetOutputEnabled())
+    {
+        Prewarm(AudioPowerHintDownlink);
+    }
+
+    // Push packet to the stream decode queue
+    return PushPacketToRing(audio_decode_queue, payload, size, sample_rate, frame_duration, timestamp, wait);
+}
+
+// Push packet to a packet ring
+bool AudioService::PushPacketToRing(AudioRing<AudioServiceStreamPacket> &ring, const uint8_t *payload, size_t size, int sample_rate, int frame_duration, uint32_t timestamp, bool wait)
+{
+    // Wait until there is space in the ring
+    AudioServiceStreamPacket *packet = nullptr;
+    while ((packet = ring.Acquire()) == nullptr)
+    {
+        // Return false if ring is full and not waiting
+        if (!wait || service_stopped)
+        {
+            return false;
+        }
+
+        // Wait for the decoder to release a slot
+        ring.WaitForSpace(pdMS_TO_TICKS(100));
+    }
+
+    // Copy packet into the preallocated slot
+    packet->sample_rate = sample_rate;
+    packet->frame_duration = frame_duration;
+    packet->timestamp = timestamp;
+    packet->origin_us = esp_timer_get_time();
+    packet->payload.assign(payload, payload + size);
+    packet->view = nullptr;
+    packet->view_size = 0;
+    packet->cache_fill.reset();
+    packet->cache_last = false;
+    packet->cache_play.reset();
+    ring.Commit();
+
+    // Return true on success
+    return true;
+}
+
+// Push a flash-resident prompt packet without copying it
+bool AudioService::PushViewToPromptQueue(const uint8_t *payload, size_t size, int sample_rate, int frame_duration, const std::shared_ptr<AudioPromptPcm> &cache_fill, bool cache_last)
+{
+    // Wait until there is space in the prompt queue
+    AudioServiceStreamPacket *packet = nullptr;
+    while ((packet = audio_prompt_queue.Acquire()) == nullptr)
+    {
+        // Return false if service is stopped
+        if (service_stopped)
+        {
+            return false;
+        }
+
+        // Wait for the decoder to release a slot
+        audio_prompt_queue.WaitForSpace(pdMS_TO_TICKS(100));
+    }
+
+    // Point the slot at the packet
+    packet->sample_rate = sample_rate;
+    packet->frame_duration = frame_duration;
+    packet->timestamp = 0;
+    packet->origin_us = 0;
+    packet->payload.clear();
+    packet->view = payload;
+    packet->view_size = size;
+    packet->cache_fill = cache_fill;
+    packet->cache_last = cache_last;
+    packet->cache_play.reset();
+    audio_prompt_queue.Commit();
+
+    // Return true on success
+    return true;
+}
+
+// Push a cached prompt to be streamed without decoding
+bool AudioService::PushCachedToPromptQueue(const std::shared_ptr<AudioPromptPcm> &cached)
+{
+    // Wait until there is space in the prompt queue
+    AudioServiceStreamPacket *packet = nullptr;
+    while ((packet = audio_prompt_queue.Acquire()) == nullptr)
+    {
+        // Return false if service is stopped
+        if (service_stopped)
+        {
+            return false;
+        }
+
+        // Wait for the decoder to release a slot
+        audio_prompt_queue.WaitForSpace(pdMS_TO_TICKS(100));
+    }
+
+    // Point the slot at the cached PCM
+    packet->view = nullptr;
+    packet->view_size = 0;
+    packet->payload.clear();
+    packet->cache_fill.reset();
+    packet->cache_last = false;
+    packet->cache_play = cached;
+    packet->cache_offset = 0;
+    audio_prompt_queue.Commit();
+
+    // Return true on success
+    return true;
+}
+
+// Hand the next chunk of a cached prompt to the playback queue
+bool AudioService::PlayCachedPrompt(AudioServiceStreamPacket &prompt)
+{
+    // Acquire slot for playback
+    auto *task = prompt_source.playback_queue.Acquire();
+    if (task == nullptr)
+    {
+        return false;
+    }
+
+    // Point the slot at the next chunk
+    auto &cached = prompt.cache_play;
+    size_t chunk = codec->GetOutputSampleRate() / 1000 * AUDIO_PROMPT_CACHE_CHUNK_MS;
+    size_t remaining = cached->samples - prompt.cache_offset;
+    if (chunk > remaining)
+    {
+        chunk = remaining;
+    }
+    task->type = AudioTaskTypeDecodeToPlaybackQueue;
+    task->timestamp = 0;
+    task->origin_us = 0;
+    task->stage_us = 0;
+    task->cached = cached;
+    task->view = cached->data + prompt.cache_offset;
+    task->view_size = chunk;
+    prompt_source.playback_queue.Commit();
+
+    // Release the cache entry after the last chunk
+    prompt.cache_offset += chunk;
+    if (prompt.cache_offset >= cached->samples)
+    {
+        cached.reset();
+        return true;
+    }
+    return false;
+}
+
+// Decode one prompt frame, filling its cache entry on the way
+void AudioService::DecodePrompt(AudioServiceStreamPacket &prompt)
+{
+    // Decode from the flash view or the copied payload
+    const uint8_t *data = prompt.view != nullptr ? prompt.view : prompt.payload.data();
+    size_t size = prompt.view != nullptr ? prompt.view_size : prompt.payload.size();
+    bool decoded = DecodeToPlaybackQueue(prompt_source, AudioJitterDecode, data, size, prompt.frame_duration, prompt.timestamp, 0, prompt.cache_fill.get());
+    if (prompt.cache_fill == nullptr)
+    {
+        return;
+    }
+
+    // A failed frame leaves the entry incomplete so it is decoded again next time
+    prompt.cache_fill->failed |= !decoded;
+    if (prompt.cache_last && !prompt.cache_fill->failed)
+    {
+        prompt.cache_fill->complete = true;
+    }
+    prompt.cache_fill.reset();
+}
+
+// Decode one frame into the playback queue of a source
+bool AudioService::DecodeToPlaybackQueue(AudioServiceSource &source, AudioJitterAction action, const uint8_t *payload, size_t size, int frame_duration, uint32_t timestamp, int64_t origin_us, AudioPromptPcm *cache_fill)
+{
+    // Acquire slot for playback
+    auto *task = source.playback_queue.Acquire();
+    if (task == nullptr)
+    {
+        return false;
+    }
+    task->type = AudioTaskTypeDecodeToPlaybackQueue;
+    task->timestamp = timestamp;
+    task->view = nullptr;
+
+    // Record time spent in the jitter buffer
+    int64_t decode_start_us = UtilsLatency::Now();
+    UtilsLatency::Instance().Record(UtilsLatencyDownlinkJitter, origin_us, decode_start_us);
+
+    // Set lost frame duration if needed
+    SetDecodeFrameDuration(source, frame_duration);
+
+    // Decode, recover from FEC, or conceal a missing frame
+    bool decoded = false;
+    switch (action)
+    {
+    case AudioJitterFec:
+        decoded = source.decoder->DecodeFec(payload, size, task->pcm);
+        break;
+    case AudioJitterConceal:
+        decoded = source.decoder->Conceal(task->pcm);
+        break;
+    default:
+        decoded = source.decoder->Decode(payload, size, task->pcm);
+        break;
+    }
+    if (!decoded)
+    {
+        decode_errors++;
+        return false;
+    }
+    if (action == AudioJitterConceal)
+    {
+        frames_concealed++;
+    }
+    else
+    {
+        frames_decoded++;
+    }
+
+    // If resampling is needed
+    if (source.decoder->SampleRate() != codec->GetOutputSampleRate())
+    {
+        source.resample_buffer.resize(source.resampler.GetOutputSamples(task->pcm.size()));
+        source.resampler.Process(task->pcm.data(), task->pcm.size(), source.resample_buffer.data());
+        task->pcm.swap(source.resample_buffer);
+    }
+
+    // Tap decoded stream and prompt frames at the output rate
+    if (tap.IsEnabled(AudioTapDecoded))
+    {
+        tap.WritePcm(AudioTapDecoded, task->pcm.data(), task->pcm.size(), codec->GetOutputSampleRate(), 1, decode_start_us);
+    }
+
+    // Keep a copy of a prompt frame for the prompt cache
+    if (cache_fill != nullptr)
+    {
+        cache_fill->Append(task->pcm.data(), task->pcm.size());
+    }
+
+    // Record decode latency and tag the frame for playback
+    int64_t now_us = UtilsLatency::Now();
+    UtilsLatency::Instance().Record(UtilsLatencyDownlinkDecode, origin_us > 0 ? decode_start_us : 0, now_us);
+    task->origin_us = origin_us;
+    task->stage_us = origin_us > 0 ? now_us : 0;
+
+    // Push task to playback queue
+    source.playback_queue.Commit();
+
+    // Return true on success
+    return true;
+}
+
+// Pop packet from send queue
+bool AudioService::PopPacketFromSendQueue(AudioServiceStreamPacket &packet)
+{
+    // If send queue is empty, return false
+    auto *front = audio_send_queue.Front();
+    if (front == nullptr)
+    {
+        return false;
+    }
+
+    // Copy packet out of the slot
+    packet.sample_rate = front->sample_rate;
+    packet.frame_duration = front->frame_duration;
+    packet.timestamp = front->timestamp;
+    packet.payload.assign(front->payload.begin(), front->payload.end());
+
+    // Record time the packet waited for the application
+    int64_t now_us = UtilsLatency::Now();
+    UtilsLatency::Instance().Record(UtilsLatencyUplinkDispatch, front->stage_us, now_us);
+
+    // Record the time from a wake word to the first packet captured after it,
+    // replayed pre-roll and frames already in flight do not count
+    int64_t wake_us = wake_detected_us.load();
+    if (wake_us != 0 && front->origin_us >= wake_us && wake_detected_us.compare_exchange_strong(wake_us, 0))
+    {
+        UtilsLatency::Instance().Record(UtilsLatencyWakeFirstPacket, wake_us, now_us);
+    }
+    packet.origin_us = front->origin_us;
+    packet.stage_us = now_us;
+
+    // Return slot to send queue
+    audio_send_queue.Release();
+
+    // Return true on success
+    return true;
+}
+
+// Report uplink frames sent and failed since the last report
+void AudioService::ReportUplink(uint32_t sent, uint32_t failed)
+{
+    // Hand the results to the rate controller, applied by the encode task
+    bitrate_controller.Report(sent, failed);
+}
+
+// Enable or disable voice processing
+void AudioService::EnableVoiceProcessing(bool enable)
+{
+    // Enable or disable audio processor
+    if (enable)
+    {
+        // Initialize audio processor if not already done
+        if (!audio_processor_initialized)
+        {
+            audio_processor->Initialize(codec, OPUS_FRAME_DURATION_MS, loopback_enabled);
+            audio_processor_initialized = true;
+        }
+
+        ResetDecoder();
+        input_feed_count = 0;
+        input_output_samples = 0;
+
+        // Prime capture before feeding the AFE, a codec already delivering signal stays on
+        {
+            std::lock_guard<std::mutex> lock(power_mutex);
+            if (input_power_state == AudioPowerOff)
+            {
+                input_power_request_us = esp_timer_get_time();
+                input_power_state = AudioPowerWarming;
+            }
+        }
+        audio_processor->Start();
+        xEventGroupSetBits(event_group, AS_EVENT_AUDIO_PROCESSOR_RUNNING);
+    }
+    else
+    {
+        audio_processor->Stop();
+        xEventGroupClearBits(event_group, AS_EVENT_AUDIO_PROCESSOR_RUNNING);
+    }
+}
+
+// Enable or disable uplink in-band FEC
+void AudioService::EnableUplinkFec(bool enable)
+{
+    // The encode task applies the change before its next frame
+    uplink_fec = enable;
+}
+
+// Open or close the wake word gate
+void AudioService::SetUplinkAwake(bool awake)
+{
+    // The encode task applies the change before its next frame
+    uplink_awake = awake;
+}
+
+// Mute or unmute the uplink
+void AudioService::SetUplinkMuted(bool muted)
+{
+    // The encode task applies the change before its next frame
+    uplink_muted = muted;
+}
+
+// Select the AFE profile
+void AudioService::SetProcessorProfile(AudioProcessorProfile profile)
+{
+    // The processing task switches stages before its next fetch
+    if (audio_processor != nullptr)
+    {
+        audio_processor->SetProfile(profile);
+    }
+}
+
+// Enable or disable the AFE CPU governor
+void AudioService::EnableProcessorGovernor(bool enable)
+{
+    if (audio_processor != nullptr)
+    {
+        audio_processor->EnableGovernor(enable);
+    }
+}
+
+// Set uplink packet duration
+void AudioService::SetUplinkPacketDuration(int duration_ms)
+{
+    // Round to whole frames within what one Opus packet holds
+    int frames = duration_ms / OPUS_FRAME_DURATION_MS;
+    frames = frames < 0 ? 0 : (frames > OPUS_PACKETIZER_MAX_FRAMES ? OPUS_PACKETIZER_MAX_FRAMES : frames);
+
+    // The encode task applies the change before its next frame
+    uplink_packet_ms = frames * OPUS_FRAME_DURATION_MS;
+}
+
+// Play a pre-indexed sound straight from flash
+void AudioService::PlaySound(const Lang::Sounds::Sound &sound)
+{
+    // If codec output is not enabled, enable it
+    if (!codec->GetOutputEnabled())
+    {
+        PowerUp(false, true, esp_timer_get_time());
+    }
+
+    // Stream the prompt from the cache on a hit
+    auto cached = prompt_cache.Lookup(sound.ogg.data());
+    if (cached != nullptr)
+    {
+        PushCachedToPromptQueue(cached);
+        return;
+    }
+
+    // Reserve a cache entry sized for the decoded prompt on a miss
+    size_t duration_ms = 0;
+    for (size_t i = 0; i < sound.count; ++i)
+    {
+        duration_ms += sound.packets[i].duration;
+    }
+    auto cache_fill = prompt_cache.Reserve(sound.ogg.data(), codec->GetOutputSampleRate() / 1000 * duration_ms);
+
+    // Queue views of the embedded packets
+    const uint8_t *buf = reinterpret_cast<const uint8_t *>(sound.ogg.data());
+    for (size_t i = 0; i < sound.count; ++i)
+    {
+        const auto &packet = sound.packets[i];
+        if (!PushViewToPromptQueue(buf + packet.offset, packet.size, sound.sample_rate, packet.duration, cache_fill, i + 1 == sound.count))
+        {
+            break;
+        }
+    }
+}
+
+// Play sound by parsing OGG data at runtime, for sounds loaded from storage
+void AudioService::PlaySound(const std::string_view &ogg)
+{
+    // If codec output is not enabled, enable it
+    if (!codec->GetOutputEnabled())
+    {
+        PowerUp(false, true, esp_timer_get_time());
+    }
+
+    // Parse OGG data and play sound
+    const uint8_t *buf = reinterpret_cast<const uint8_t *>(ogg.data());
+    size_t size = ogg.size();
+    size_t offset = 0;
+
+    // Lambda function to find next OGG page
+    auto find_page = [&](size_t start) -> size_t
+    {
+        for (size_t i = start; i + 4 <= size; ++i)
+        {
+            if (buf[i] == 'O' && buf[i + 1] == 'g' && buf[i + 2] == 'g' && buf[i + 3] == 'S')
+            {
+                return i;
+            }
+        }
+        return static_cast<size_t>(-1);
+    };
+
+    // OGG decoding state variables
+    bool seen_head = false;
+    bool seen_tags = false;
+    int sample_rate = 16000;
+
+    // Loop through OGG pages
+    while (true)
+    {
+        size_t pos = find_page(offset);
+        if (pos == static_cast<size_t>(-1))
+        {
+            break;
+        }
+
+        offset = pos;
+        if (offset + 27 > size)
+        {
+            break;
+        }
+
+        const uint8_t *page = buf + offset;
+        uint8_t page_segments = page[26];
+        size_t seg_table_off = offset + 27;
+        if (seg_table_off + page_segments > size)
+        {
+            break;
         }
 
         size_t body_size = 0;
@@ -693,12 +1812,14 @@ void AudioService::PlaySound(const std::string_view &ogg)
                 continue;
             }
 
-            auto packet = std::make_unique<AudioServiceStreamPacket>();
-            packet->sample_rate = sample_rate;
-            packet->frame_duration = 60;
-            packet->payload.resize(pkt_len);
-            std::memcpy(packet->payload.data(), pkt_ptr, pkt_len);
-            PushPacketToDecodeQueue(std::move(packet), true);
+            // Take frame duration from the packet TOC
+            int frame_duration = opus_packet_get_nb_samples(pkt_ptr, pkt_len, 48000) / 48;
+            if (frame_duration <= 0)
+            {
+                continue;
+            }
+
+            PushPacketToRing(audio_prompt_queue, pkt_ptr, pkt_len, sample_rate, frame_duration, 0, true);
         }
 
         offset = body_off + body_size;
@@ -708,29 +1829,34 @@ void AudioService::PlaySound(const std::string_view &ogg)
 // Check if audio service is idle
 bool AudioService::IsIdle()
 {
-    // Check if all audio queues are empty
-    std::lock_guard<std::mutex> lock(audio_queue_mutex);
-
     // Return true if all queues are empty
-    return audio_encode_queue.empty() && audio_decode_queue.empty() && audio_playback_queue.empty();
+    return audio_encode_queue.Empty() && audio_decode_queue.Empty() && audio_prompt_queue.Empty() && jitter_buffer.Empty() && stream_source.playback_queue.Empty() && prompt_source.playback_queue.Empty();
 }
 
 void AudioService::ResetDecoder()
 {
-    // Lock audio queue mutex
-    std::lock_guard<std::mutex> lock(audio_queue_mutex);
-
-    // Reset opus decoder and clear queues
-    opus_decoder->ResetState();
-    timestamp_queue.clear();
-    audio_decode_queue.clear();
-    audio_playback_queue.clear();
-    audio_queue_cv.notify_all();
+    // Reset opus decoders and clear queues
+    stream_source.decoder->ResetState();
+    prompt_source.decoder->ResetState();
+    stream_source.resampler.Reset();
+    prompt_source.resampler.Reset();
+    {
+        std::lock_guard<std::mutex> lock(timestamp_queue_mutex);
+        timestamp_queue.clear();
+    }
+    audio_decode_queue.RequestClear();
+    audio_prompt_queue.RequestClear();
+    stream_source.playback_queue.RequestClear();
+    prompt_source.playback_queue.RequestClear();
+    jitter_buffer.RequestReset();
 }
 
 // Check and update audio power state
 void AudioService::CheckAndUpdateAudioPowerState()
 {
+    // Lock power state
+    std::lock_guard<std::mutex> lock(power_mutex);
+
     // Get current time
     auto now = std::chrono::steady_clock::now();
 
@@ -743,6 +1869,7 @@ void AudioService::CheckAndUpdateAudioPowerState()
     {
         // Disable codec input
         codec->EnableInput(false);
+        input_power_state = AudioPowerOff;
     }
 
     // Disable codec output if idle
@@ -750,6 +1877,7 @@ void AudioService::CheckAndUpdateAudioPowerState()
     {
         // Disable codec output
         codec->EnableOutput(false);
+        output_power_state = AudioPowerOff;
     }
 
     // Stop the timer if both input and output are disabled
@@ -760,6 +1888,244 @@ void AudioService::CheckAndUpdateAudioPowerState()
     }
 }
 
+// Power up codec directions, request_us is when the need for audio was first seen
+void AudioService::PowerUp(bool input, bool output, int64_t request_us)
+{
+    // Lock power state
+    std::lock_guard<std::mutex> lock(power_mutex);
+    auto now = std::chrono::steady_clock::now();
+    bool powered = false;
+
+    // Enable codec input, capture is primed before it is used
+    if (input)
+    {
+        last_input_time = now;
+        if (!codec->GetInputEnabled())
+        {
+            codec->EnableInput(true);
+            input_power_request_us = request_us;
+            input_power_state = AudioPowerWarming;
+            powered = true;
+        }
+    }
+
+    // Enable codec output, warm until the first segment is written
+    if (output)
+    {
+        last_output_time = now;
+        if (!codec->GetOutputEnabled())
+        {
+            codec->EnableOutput(true);
+            output_power_request_us = request_us;
+            output_power_state = AudioPowerWarming;
+            powered = true;
+        }
+    }
+
+    // Restart the idle check so a fresh power-up is not cut short
+    if (powered)
+    {
+        esp_timer_stop(audio_service_power_timer);
+        esp_timer_start_periodic(audio_service_power_timer, AUDIO_POWER_CHECK_INTERVAL_MS * 1000);
+    }
+}
+
+// Power the codec up ahead of expected audio
+void AudioService::Prewarm(AudioPowerHint hint)
+{
+    // Check if the service is initialized
+    if (codec == nullptr || audio_service_prewarm_timer == nullptr)
+    {
+        return;
+    }
+
+    // Downlink audio needs the speaker; signaling and button presses precede a conversation
+    bool input = hint != AudioPowerHintDownlink;
+    if (codec->GetOutputEnabled() && (!input || codec->GetInputEnabled()))
+    {
+        return;
+    }
+
+    // Keep the earliest request time for time-to-first-sample
+    int64_t expected = 0;
+    prewarm_request_us.compare_exchange_strong(expected, esp_timer_get_time());
+    prewarm_input = prewarm_input || input;
+    prewarm_output = true;
+
+    // Power up on the timer task, already pending requests are merged
+    esp_timer_start_once(audio_service_prewarm_timer, 0);
+}
+
+// Apply pending prewarm requests
+void AudioService::ApplyPrewarm()
+{
+    bool input = prewarm_input.exchange(false);
+    bool output = prewarm_output.exchange(false);
+    int64_t request_us = prewarm_request_us.exchange(0);
+    PowerUp(input, output, request_us);
+}
+
+// Drop captured chunks until the ADC delivers signal
+void AudioService::PrimeInput()
+{
+    // Read one feed chunk
+    int samples = audio_processor->GetFeedSize();
+    if (samples <= 0 || !ReadAudioData(input_data_buffer, 16000, samples))
+    {
+        vTaskDelay(pdMS_TO_TICKS(10));
+        return;
+    }
+
+    // The codec is ready once a chunk carries more than digital silence
+    bool ready = false;
+    for (int16_t sample : input_data_buffer)
+    {
+        if (sample > AUDIO_INPUT_PRIME_LEVEL || sample < -AUDIO_INPUT_PRIME_LEVEL)
+        {
+            ready = true;
+            break;
+        }
+    }
+
+    // Finish priming, reporting time to first sample
+    int64_t now_us = UtilsLatency::Now();
+    if (ready || now_us - input_power_request_us > AUDIO_INPUT_PRIME_MAX_MS * 1000)
+    {
+        input_power_state = AudioPowerOn;
+        UtilsLatency::Instance().Record(UtilsLatencyPowerInput, input_power_request_us, now_us);
+    }
+}
+
+// Get audio service statistics
+AudioServiceStats AudioService::GetStats()
+{
+    // Snapshot counters
+    AudioServiceStats stats;
+    stats.frames_encoded = frames_encoded.load();
+    stats.frames_decoded = frames_decoded.load();
+    stats.frames_concealed = frames_concealed.load();
+    stats.frames_played = frames_played.load();
+    stats.decode_errors = decode_errors.load();
+    stats.frames_muted = frames_muted.load();
+    stats.muted_bytes_saved = muted_bytes_saved.load();
+    stats.muted_encode_us_saved = muted_encode_us_saved.load();
+
+    // Snapshot the codec streams, there is no codec before Initialize
+    if (codec != nullptr)
+    {
+        AudioCodecStreamStats stream_stats = codec->GetOutputStreamStats();
+        stats.output_underruns = stream_stats.underruns;
+        stats.output_underrun_samples = stream_stats.underrun_samples;
+        AudioCodecCaptureStats capture_stats = codec->GetInputStreamStats();
+        stats.input_overruns = capture_stats.overruns;
+        stats.input_dropped_samples = capture_stats.dropped_samples;
+    }
+
+    // Snapshot the wake gate
+    WakeWordStats wake_stats = wake_word.GetStats();
+    stats.wake_enabled = wake_enabled;
+    stats.uplink_awake = uplink_awake.load();
+    stats.wake_detections = wake_stats.detections;
+    stats.frames_gated = frames_gated.load();
+    stats.wake_detect_us = wake_stats.detect_us;
+
+    // Snapshot the VAD gate
+    uint64_t vad_dropped = vad_dropped_bytes.load();
+    uint64_t vad_keepalive = vad_keepalive_bytes.load();
+    stats.vad_gate = vad_gate_enabled;
+    stats.frames_held = frames_held.load();
+    stats.vad_bursts = vad_bursts.load();
+    stats.vad_burst_frames = vad_burst_frames.load();
+    stats.vad_bytes_saved = vad_dropped > vad_keepalive ? vad_dropped - vad_keepalive : 0;
+
+    // Snapshot the jitter buffer
+    stats.jitter = jitter_buffer.GetStats();
+
+    // Snapshot the prompt cache
+    stats.prompt_cache = prompt_cache.GetStats();
+
+    // Snapshot the mixer sources
+    stats.stream_mixer = mixer.GetStats(stream_source.mixer_source);
+    stats.prompt_mixer = mixer.GetStats(prompt_source.mixer_source);
+
+    // Snapshot the echo reference
+    stats.loopback = loopback_enabled;
+    stats.reference = loopback_reference.GetStats();
+
+    // Snapshot the AFE profile and load, the processor is created by Initialize
+    if (audio_processor)
+    {
+        stats.processor = audio_processor->GetStats();
+    }
+
+    // Snapshot tap point counters
+    stats.tap = tap.GetStats();
+
+    // Snapshot queue depths
+    stats.decode_queue = audio_decode_queue.Size() + stats.jitter.depth;
+    stats.prompt_queue = audio_prompt_queue.Size();
+    stats.send_queue = audio_send_queue.Size();
+    stats.encode_queue = audio_encode_queue.Size();
+    stats.playback_queue = stream_source.playback_queue.Size() + prompt_source.playback_queue.Size();
+
+    // Snapshot encoder settings
+    stats.bitrate = bitrate_controller.Bitrate();
+    stats.loss_percent = bitrate_controller.LossPercent();
+    stats.fec = uplink_fec.load();
+    stats.packet_ms = bitrate_controller.PacketFrames() * OPUS_FRAME_DURATION_MS;
+    AudioBitrateStats bitrate_stats = bitrate_controller.GetStats();
+    stats.bandwidth = bitrate_stats.bandwidth;
+    stats.bitrate_decreases = bitrate_stats.decreases;
+    stats.bitrate_increases = bitrate_stats.increases;
+
+    // Snapshot heap usage
+    stats.free_heap = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    stats.min_free_heap = heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT);
+    return stats;
+}
+
+// Format audio service statistics as one JSON line
+std::string AudioService::GetStatsJson()
+{
+    // Format statistics on the heap, the line outgrows the stack of the health log task
+    auto stats = GetStats();
+    std::string buffer(AUDIO_SERVICE_STATS_JSON_SIZE, '\0');
+    int length = snprintf(buffer.data(), buffer.size(),
+             "{\"encoded\":%lu,\"decoded\":%lu,\"concealed\":%lu,\"played\":%lu,\"decode_errors\":%lu,"
+             "\"queues\":{\"decode\":%u,\"prompt\":%u,\"send\":%u,\"encode\":%u,\"playback\":%u},"
+             "\"uplink\":{\"bitrate\":%d,\"bandwidth\":%d,\"loss\":%d,\"fec\":%s,\"packet_ms\":%d,\"decreases\":%lu,\"increases\":%lu},"
+             "\"muted\":{\"frames\":%lu,\"bytes_saved\":%llu,\"encode_ms_saved\":%llu},"
+             "\"output\":{\"underruns\":%lu,\"underrun_samples\":%lu},"
+             "\"input\":{\"overruns\":%lu,\"dropped_samples\":%lu},"
+             "\"wake\":{\"enabled\":%s,\"awake\":%s,\"detections\":%lu,\"gated\":%lu,\"detect_us\":%lu},"
+             "\"vad_gate\":{\"enabled\":%s,\"held\":%lu,\"bursts\":%lu,\"burst_frames\":%lu,\"bytes_saved\":%llu},"
+             "\"jitter\":{\"depth\":%d,\"target\":%d,\"jitter_ms\":%d,\"late\":%lu,\"lost\":%lu,\"concealed\":%lu,\"recovered\":%lu,\"rejected\":%lu},"
+             "\"prompt_cache\":{\"bytes\":%u,\"budget\":%u,\"entries\":%u,\"hits\":%lu,\"misses\":%lu},"
+             "\"mixer\":{\"clipped\":%lu,\"stream\":{\"samples\":%llu,\"underruns\":%lu,\"gain\":%d,\"ducked\":%s},\"prompt\":{\"samples\":%llu,\"underruns\":%lu,\"gain\":%d,\"ducked\":%s}},"
+             "\"reference\":{\"loopback\":%s,\"delay_ms\":%d,\"estimates\":%lu,\"gaps\":%lu},"
+             "\"afe\":{\"profile\":%d,\"ceiling\":%d,\"governor\":%s,\"load\":%d,\"fetch_cycles\":%lu,\"switches\":%lu},"
+             "\"tap\":{\"mask\":%lu,\"records\":%lu,\"dropped\":%lu,\"bytes\":%llu},"
+             "\"heap\":{\"free\":%u,\"min_free\":%u}}",
+             (unsigned long)stats.frames_encoded, (unsigned long)stats.frames_decoded, (unsigned long)stats.frames_concealed, (unsigned long)stats.frames_played, (unsigned long)stats.decode_errors,
+             (unsigned)stats.decode_queue, (unsigned)stats.prompt_queue, (unsigned)stats.send_queue, (unsigned)stats.encode_queue, (unsigned)stats.playback_queue,
+             stats.bitrate, stats.bandwidth, stats.loss_percent, stats.fec ? "true" : "false", stats.packet_ms, (unsigned long)stats.bitrate_decreases, (unsigned long)stats.bitrate_increases,
+             (unsigned long)stats.frames_muted, (unsigned long long)stats.muted_bytes_saved, (unsigned long long)(stats.muted_encode_us_saved / 1000),
+             (unsigned long)stats.output_underruns, (unsigned long)stats.output_underrun_samples,
+             (unsigned long)stats.input_overruns, (unsigned long)stats.input_dropped_samples,
+             stats.wake_enabled ? "true" : "false", stats.uplink_awake ? "true" : "false", (unsigned long)stats.wake_detections, (unsigned long)stats.frames_gated, (unsigned long)stats.wake_detect_us,
+             stats.vad_gate ? "true" : "false", (unsigned long)stats.frames_held, (unsigned long)stats.vad_bursts, (unsigned long)stats.vad_burst_frames, (unsigned long long)stats.vad_bytes_saved,
+             stats.jitter.depth, stats.jitter.target_depth, stats.jitter.jitter_ms, (unsigned long)stats.jitter.late, (unsigned long)stats.jitter.lost, (unsigned long)stats.jitter.concealed, (unsigned long)stats.jitter.recovered, (unsigned long)stats.jitter.rejected,
+             (unsigned)stats.prompt_cache.bytes, (unsigned)stats.prompt_cache.budget, (unsigned)stats.prompt_cache.entries, (unsigned long)stats.prompt_cache.hits, (unsigned long)stats.prompt_cache.misses,
+             (unsigned long)stats.stream_mixer.clipped, (unsigned long long)stats.stream_mixer.samples, (unsigned long)stats.stream_mixer.underruns, stats.stream_mixer.gain_percent, stats.stream_mixer.ducked ? "true" : "false",
+             (unsigned long long)stats.prompt_mixer.samples, (unsigned long)stats.prompt_mixer.underruns, stats.prompt_mixer.gain_percent, stats.prompt_mixer.ducked ? "true" : "false",
+             stats.loopback ? "true" : "false", stats.reference.delay_ms, (unsigned long)stats.reference.estimates, (unsigned long)stats.reference.gaps,
+             stats.processor.profile, stats.processor.ceiling, stats.processor.governor ? "true" : "false", stats.processor.load_percent, (unsigned long)stats.processor.fetch_cycles, (unsigned long)stats.processor.switches,
+             (unsigned long)stats.tap.mask, (unsigned long)stats.tap.records, (unsigned long)stats.tap.dropped, (unsigned long long)stats.tap.bytes,
+             (unsigned)stats.free_heap, (unsigned)stats.min_free_heap);
+    buffer.resize(length < 0 ? 0 : std::min(static_cast<size_t>(length), buffer.size() - 1));
+    return buffer;
+}
+
 // Set audio callbacks
 void AudioService::SetCallbacks(AudioServiceCallbacks &cb)
 {
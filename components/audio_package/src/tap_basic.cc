@@ -0,0 +1,321 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// Include the headers
+#include "tap_basic.h"
+
+// Define log tag
+#define TAG "[client:components:audio:tap:basic]"
+
+// Constructor
+AudioTap::AudioTap()
+{
+}
+
+// Destructor
+AudioTap::~AudioTap()
+{
+}
+
+// Enable taps
+void AudioTap::Enable(uint32_t enable_mask)
+{
+    // Allocate rings of newly enabled taps, kept for the life of the program
+    std::lock_guard<std::mutex> lock(sink_mutex);
+    uint32_t allocated = 0;
+    for (int point = 0; point < AudioTapPointCount; ++point)
+    {
+        Ring &ring = rings[point];
+        if (((enable_mask >> point) & 1) && ring.data == nullptr)
+        {
+            size_t capacity = AUDIO_TAP_BUFFER_KB * 1024;
+            ring.data = static_cast<uint8_t *>(heap_caps_malloc(capacity, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+            if (ring.data == nullptr)
+            {
+                ring.data = static_cast<uint8_t *>(heap_caps_malloc(capacity, MALLOC_CAP_8BIT));
+            }
+            if (ring.data == nullptr)
+            {
+                ESP_LOGW(TAG, "Failed to allocate %u bytes for tap %s", (unsigned)capacity, PointName(static_cast<AudioTapPoint>(point)));
+                continue;
+            }
+            ring.capacity = capacity;
+        }
+        if (ring.data != nullptr)
+        {
+            allocated |= 1u << point;
+        }
+    }
+
+    // Start the drain task once
+    if (drain_task_handle == nullptr)
+    {
+        batch.resize(AUDIO_TAP_DRAIN_BYTES);
+        auto drain_task = [](void *arg)
+        {
+            AudioTap *tap = (AudioTap *)arg;
+            tap->DrainTask();
+            vTaskDelete(nullptr);
+        };
+        xTaskCreate(drain_task, "audio_tap_task", AUDIO_TAP_TASK_STACK_SIZE, this, AUDIO_TAP_TASK_PRIORITY, &drain_task_handle);
+    }
+
+    // Publish the rings before their taps are enabled
+    mask.store(enable_mask & allocated, std::memory_order_release);
+    ESP_LOGI(TAG, "Enabled taps 0x%02x", (unsigned)(enable_mask & allocated));
+}
+
+// Disable all taps, queued records still drain
+void AudioTap::Disable()
+{
+    mask.store(0, std::memory_order_release);
+}
+
+// Copy into a ring, wrapping at its end
+void AudioTap::CopyIn(Ring &ring, size_t position, const void *src, size_t size)
+{
+    size_t offset = position % ring.capacity;
+    size_t first = std::min(size, ring.capacity - offset);
+    memcpy(ring.data + offset, src, first);
+    memcpy(ring.data, static_cast<const uint8_t *>(src) + first, size - first);
+}
+
+// Copy out of a ring, wrapping at its end
+void AudioTap::CopyOut(Ring &ring, size_t position, void *dest, size_t size)
+{
+    size_t offset = position % ring.capacity;
+    size_t first = std::min(size, ring.capacity - offset);
+    memcpy(dest, ring.data + offset, first);
+    memcpy(static_cast<uint8_t *>(dest) + first, ring.data, size - first);
+}
+
+// Queue one record, dropping it when the ring is full
+bool AudioTap::Push(AudioTapPoint point, AudioTapFormat format, int sample_rate, int channels, const void *payload, size_t size, int64_t timestamp_us)
+{
+    // Recheck with acquire so the ring allocation is visible
+    if (!((mask.load(std::memory_order_acquire) >> point) & 1))
+    {
+        return false;
+    }
+
+    // Drop the record instead of waiting for the drain task
+    Ring &ring = rings[point];
+    size_t total = sizeof(AudioTapRecord) + size;
+    size_t head = ring.head.load(std::memory_order_relaxed);
+    size_t tail = ring.tail.load(std::memory_order_acquire);
+    if (total > ring.capacity - (head - tail))
+    {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // Write header and payload, then publish them together
+    AudioTapRecord record = {};
+    record.magic = AUDIO_TAP_MAGIC;
+    record.point = static_cast<uint8_t>(point);
+    record.format = static_cast<uint8_t>(format);
+    record.channels = static_cast<uint8_t>(channels);
+    record.sample_rate = static_cast<uint32_t>(sample_rate);
+    record.size = static_cast<uint32_t>(size);
+    record.timestamp_us = timestamp_us;
+    CopyIn(ring, head, &record, sizeof(record));
+    CopyIn(ring, head + sizeof(record), payload, size);
+    ring.head.store(head + total, std::memory_order_release);
+
+    // Count the record
+    records.fetch_add(1, std::memory_order_relaxed);
+    bytes.fetch_add(total, std::memory_order_relaxed);
+    return true;
+}
+
+// Copy interleaved PCM into a tap
+void AudioTap::WritePcm(AudioTapPoint point, const int16_t *pcm, size_t samples, int sample_rate, int channels, int64_t timestamp_us)
+{
+    // Split long buffers so every record fits one drain batch
+    size_t frame_bytes = sizeof(int16_t) * channels;
+    size_t max_frames = (AUDIO_TAP_DRAIN_BYTES - sizeof(AudioTapRecord)) / frame_bytes;
+    size_t frames = samples / channels;
+    for (size_t done = 0; done < frames;)
+    {
+        size_t count = std::min(max_frames, frames - done);
+        int64_t offset_us = static_cast<int64_t>(done) * 1000000 / sample_rate;
+        if (!Push(point, AudioTapPcm16, sample_rate, channels, pcm + done * channels, count * frame_bytes, timestamp_us + offset_us))
+        {
+            return;
+        }
+        done += count;
+    }
+}
+
+// Copy an Opus packet into a tap
+void AudioTap::WriteOpus(AudioTapPoint point, const uint8_t *data, size_t size, int sample_rate, int64_t timestamp_us)
+{
+    // Packets larger than a batch are never split
+    if (sizeof(AudioTapRecord) + size > AUDIO_TAP_DRAIN_BYTES)
+    {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    Push(point, AudioTapOpus, sample_rate, 1, data, size, timestamp_us);
+}
+
+// Drain to a file
+bool AudioTap::OpenFile(const char *path, size_t max_bytes)
+{
+    // Replace any open capture file
+    std::lock_guard<std::mutex> lock(sink_mutex);
+    if (file != nullptr)
+    {
+        fclose(file);
+    }
+    file = fopen(path, "wb");
+    file_bytes = 0;
+    file_max_bytes = max_bytes;
+    if (file == nullptr)
+    {
+        ESP_LOGE(TAG, "Failed to open tap file %s", path);
+        return false;
+    }
+    ESP_LOGI(TAG, "Writing taps to %s, at most %u bytes", path, (unsigned)max_bytes);
+    return true;
+}
+
+// Drain to a callback
+void AudioTap::SetSink(std::function<bool(const uint8_t *data, size_t size)> sink_)
+{
+    std::lock_guard<std::mutex> lock(sink_mutex);
+    sink = sink_;
+}
+
+// Hand a batch of whole records to the sink
+bool AudioTap::FlushBatch(size_t size)
+{
+    // A full capture file stops taking records
+    std::lock_guard<std::mutex> lock(sink_mutex);
+    if (file != nullptr)
+    {
+        if (file_bytes + size > file_max_bytes || fwrite(batch.data(), 1, size, file) != size)
+        {
+            return false;
+        }
+        file_bytes += size;
+        return true;
+    }
+
+    // Otherwise pass the batch to the callback
+    return sink ? sink(batch.data(), size) : false;
+}
+
+// Move queued records to the sink
+void AudioTap::Drain()
+{
+    // Batch whole records from every ring, so each batch parses on its own
+    size_t fill = 0;
+    uint32_t batch_records = 0;
+    for (auto &ring : rings)
+    {
+        if (ring.data == nullptr)
+        {
+            continue;
+        }
+        while (true)
+        {
+            // Read the next record header
+            size_t tail = ring.tail.load(std::memory_order_relaxed);
+            size_t head = ring.head.load(std::memory_order_acquire);
+            if (head - tail < sizeof(AudioTapRecord))
+            {
+                break;
+            }
+            AudioTapRecord record;
+            CopyOut(ring, tail, &record, sizeof(record));
+            size_t total = sizeof(record) + record.size;
+
+            // Flush when the record does not fit the batch
+            if (fill + total > batch.size())
+            {
+                if (!FlushBatch(fill))
+                {
+                    dropped.fetch_add(batch_records, std::memory_order_relaxed);
+                }
+                fill = 0;
+                batch_records = 0;
+            }
+
+            // Copy the record and free its ring space
+            CopyOut(ring, tail, batch.data() + fill, total);
+            ring.tail.store(tail + total, std::memory_order_release);
+            fill += total;
+            batch_records++;
+        }
+    }
+
+    // Flush the last batch
+    if (fill > 0 && !FlushBatch(fill))
+    {
+        dropped.fetch_add(batch_records, std::memory_order_relaxed);
+    }
+
+    // Commit file writes once per drain
+    std::lock_guard<std::mutex> lock(sink_mutex);
+    if (file != nullptr)
+    {
+        fflush(file);
+    }
+}
+
+// Drain task loop
+void AudioTap::DrainTask()
+{
+    while (true)
+    {
+        vTaskDelay(pdMS_TO_TICKS(AUDIO_TAP_DRAIN_MS));
+        Drain();
+    }
+}
+
+// Get statistics
+AudioTapStats AudioTap::GetStats() const
+{
+    AudioTapStats stats;
+    stats.mask = mask.load();
+    stats.records = records.load();
+    stats.dropped = dropped.load();
+    stats.bytes = bytes.load();
+    return stats;
+}
+
+// Get tap point name
+const char *AudioTap::PointName(AudioTapPoint point)
+{
+    switch (point)
+    {
+    case AudioTapMic:
+        return "mic";
+    case AudioTapResampled:
+        return "resampled";
+    case AudioTapAfe:
+        return "afe";
+    case AudioTapDecoded:
+        return "decoded";
+    case AudioTapPlayback:
+        return "playback";
+    case AudioTapUplink:
+        return "uplink";
+    default:
+        return "unknown";
+    }
+}
\ No newline at end of file
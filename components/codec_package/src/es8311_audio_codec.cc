@@ -97,14 +97,15 @@ ES8311AudioCodec::~ES8311AudioCodec()
 // Private method to create duplex channels
 void ES8311AudioCodec::CreateDuplexChannels(gpio_num_t mclk, gpio_num_t bclk, gpio_num_t ws, gpio_num_t dout, gpio_num_t din)
 {
-    // Configure I2S channel
+    // Configure I2S channel, sent buffers are cleared before the callback so
+    // an output stream can refill them and blocking writes still underrun to silence
     i2s_chan_config_t chan_cfg = {
         .id = I2S_NUM_0,
         .role = I2S_ROLE_MASTER,
         .dma_desc_num = AUDIO_CODEC_DMA_DESC_NUM,
         .dma_frame_num = AUDIO_CODEC_DMA_FRAME_NUM,
-        .auto_clear_after_cb = true,
-        .auto_clear_before_cb = false,
+        .auto_clear_after_cb = false,
+        .auto_clear_before_cb = true,
         .intr_priority = 0,
     };
     ESP_ERROR_CHECK(i2s_new_channel(&chan_cfg, &tx_handle, &rx_handle));
@@ -227,10 +228,21 @@ void ES8311AudioCodec::EnableOutput(bool enable)
 // Private method to read audio data
 int ES8311AudioCodec::Read(int16_t *dest, int samples)
 {
-    if (input_enabled)
+    // Nothing is captured while input is disabled
+    if (!input_enabled)
     {
-        ESP_ERROR_CHECK_WITHOUT_ABORT(esp_codec_dev_read(dev, (void *)dest, samples * sizeof(int16_t)));
+        return 0;
     }
+
+    // Report failed reads instead of handing back a stale buffer
+    int ret = esp_codec_dev_read(dev, (void *)dest, samples * sizeof(int16_t));
+    if (ret != ESP_CODEC_DEV_OK)
+    {
+        ESP_LOGW(TAG, "Failed to read audio data: %d", ret);
+        return 0;
+    }
+
+    // Return number of samples read
     return samples;
 }
 
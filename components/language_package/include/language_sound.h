@@ -20,11 +20,41 @@ limitations under the License.
 // Include standard headers
 #include <string>
 #include <string_view>
+#include <cstdint>
+#include <iterator>
 
 // Include ESP headers
 #include <esp_log.h>
 #include <esp_err.h>
 
+// Namespace for language sounds
+namespace Lang
+{
+    // Namespace for sound assets
+    namespace Sounds
+    {
+        // Opus packet within an embedded OGG asset
+        struct Packet
+        {
+            uint32_t offset;
+            uint16_t size;
+            uint16_t duration;
+        };
+
+        // Embedded OGG asset with its build-time packet index
+        struct Sound
+        {
+            std::string_view ogg;
+            const Packet *packets;
+            size_t count;
+            int sample_rate;
+        };
+    }
+}
+
+// Include generated packet index
+#include "language_sound_index.h"
+
 // Namespace for language sounds
 namespace Lang
 {
@@ -38,6 +68,12 @@ namespace Lang
             static_cast<const char *>(ogg_wifi_config_start),
             static_cast<size_t>(ogg_wifi_config_end - ogg_wifi_config_start),
         };
+        static const Sound WIFI_CONFIG{
+            OGG_WIFI_CONFIG,
+            Index::WIFI_CONFIG_PACKETS,
+            std::size(Index::WIFI_CONFIG_PACKETS),
+            Index::WIFI_CONFIG_SAMPLE_RATE,
+        };
 
         // WiFi success sound asset
         extern const char ogg_wifi_success_start[] asm("_binary_wifi_success_ogg_start");
@@ -46,6 +82,12 @@ namespace Lang
             static_cast<const char *>(ogg_wifi_success_start),
             static_cast<size_t>(ogg_wifi_success_end - ogg_wifi_success_start),
         };
+        static const Sound WIFI_SUCCESS{
+            OGG_WIFI_SUCCESS,
+            Index::WIFI_SUCCESS_PACKETS,
+            std::size(Index::WIFI_SUCCESS_PACKETS),
+            Index::WIFI_SUCCESS_SAMPLE_RATE,
+        };
     }
 }
 
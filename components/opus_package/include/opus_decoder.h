@@ -48,9 +48,15 @@ public:
     ~OpusDecoderWrapper();
 
     // Member functions
-    bool Decode(std::vector<uint8_t> &&opus, std::vector<int16_t> &pcm);
+    bool Decode(const uint8_t *opus, size_t size, std::vector<int16_t> &pcm);
+    bool DecodeFec(const uint8_t *opus, size_t size, std::vector<int16_t> &pcm);
+    bool Conceal(std::vector<int16_t> &pcm);
+    void SetDuration(int duration_ms_);
     void ResetState();
 
+    // Output rates the decoder can produce directly, any packet decodes at any of them
+    static bool IsSupportedRate(int sample_rate);
+
     // Sample Rate
     inline int SampleRate() const
     {
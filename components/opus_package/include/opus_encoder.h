@@ -46,6 +46,7 @@ private:
     int duration_ms;
     int frame_size;
     std::vector<int16_t> in_buffer;
+    bool fec_enabled = false;
 
 public:
     // Constructor and Destructor
@@ -69,6 +70,11 @@ public:
     // Public Methods
     void SetDtx(bool enable);
     void SetComplexity(int complexity);
+    void SetBitrate(int bitrate);
+    void SetBandwidth(int bandwidth);
+    void SetPacketLoss(int percent);
+    void SetFec(bool enable);
+    bool IsFecEnabled() const { return fec_enabled; }
     bool Encode(std::vector<int16_t> &&pcm, std::vector<uint8_t> &opus);
     void Encode(std::vector<int16_t> &&pcm, std::function<void(std::vector<uint8_t> &&opus)> handler);
     bool IsBufferEmpty() const { return in_buffer.empty(); }
@@ -0,0 +1,62 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef OPUS_PACKETIZER_H
+#define OPUS_PACKETIZER_H
+
+// Include standard headers
+#include <vector>
+#include <cstdint>
+
+// Include ESP headers
+#include <esp_log.h>
+#include <esp_err.h>
+
+// Include Opus headers
+#include "opus.h"
+
+// Define most frames joined into one packet, Opus packets hold up to 120 ms
+#define OPUS_PACKETIZER_MAX_FRAMES 6
+
+// Joins consecutive single-frame packets into one multi-frame packet
+class OpusPacketizer
+{
+private:
+    // Member variables
+    OpusRepacketizer *repacketizer = nullptr;
+    std::vector<uint8_t> frames[OPUS_PACKETIZER_MAX_FRAMES];
+    int frame_count = 0;
+
+public:
+    // Constructor and Destructor
+    OpusPacketizer();
+    ~OpusPacketizer();
+
+    // Add a packet, false when full or its configuration differs from the
+    // frames already added; flush and add it again in that case
+    bool Add(const uint8_t *opus, size_t size);
+
+    // Write the joined packet and start over, false when nothing was added
+    bool Flush(std::vector<uint8_t> &opus);
+
+    // Drop added frames
+    void Reset();
+
+    // Frames waiting to be flushed
+    int Count() const { return frame_count; }
+};
+
+#endif
\ No newline at end of file
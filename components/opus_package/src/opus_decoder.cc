@@ -49,7 +49,7 @@ OpusDecoderWrapper::~OpusDecoderWrapper()
 }
 
 // Decode function
-bool OpusDecoderWrapper::Decode(std::vector<uint8_t> &&opus, std::vector<int16_t> &pcm)
+bool OpusDecoderWrapper::Decode(const uint8_t *opus, size_t size, std::vector<int16_t> &pcm)
 {
     // Lock mutex
     std::lock_guard<std::mutex> lock(mutex);
@@ -61,11 +61,43 @@ bool OpusDecoderWrapper::Decode(std::vector<uint8_t> &&opus, std::vector<int16_t
         return false;
     }
 
-    // Prepare PCM buffer
-    pcm.resize(frame_size);
+    // Prepare PCM buffer for every frame the packet holds
+    int samples = opus_packet_get_nb_samples(opus, size, sample_rate);
+    pcm.resize(samples > 0 ? samples : frame_size);
 
     // Decode Opus data
-    auto ret = opus_decode(audio_decoder, opus.data(), opus.size(), pcm.data(), pcm.size(), 0);
+    auto ret = opus_decode(audio_decoder, opus, size, pcm.data(), pcm.size(), 0);
+    if (ret < 0)
+    {
+        // Decoding failed
+        return false;
+    }
+
+    // Resize PCM vector to actual decoded size
+    pcm.resize(ret);
+
+    // Successful decode
+    return true;
+}
+
+// Recover the frame before this packet from its in-band FEC data
+bool OpusDecoderWrapper::DecodeFec(const uint8_t *opus, size_t size, std::vector<int16_t> &pcm)
+{
+    // Lock mutex
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Check if decoder is initialized
+    if (audio_decoder == nullptr)
+    {
+        // Decoder not initialized
+        return false;
+    }
+
+    // Prepare PCM buffer for exactly one lost frame
+    pcm.resize(frame_size);
+
+    // Decode FEC data, falling back to PLC when the packet carries none
+    auto ret = opus_decode(audio_decoder, opus, size, pcm.data(), frame_size, 1);
     if (ret < 0)
     {
         // Decoding failed
@@ -79,6 +111,37 @@ bool OpusDecoderWrapper::Decode(std::vector<uint8_t> &&opus, std::vector<int16_t
     return true;
 }
 
+// Synthesize one frame with packet loss concealment
+bool OpusDecoderWrapper::Conceal(std::vector<int16_t> &pcm)
+{
+    // Lock mutex
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Check if decoder is initialized
+    if (audio_decoder == nullptr)
+    {
+        // Decoder not initialized
+        return false;
+    }
+
+    // Prepare PCM buffer for exactly one lost frame
+    pcm.resize(frame_size);
+
+    // Decode with no data to run PLC
+    auto ret = opus_decode(audio_decoder, nullptr, 0, pcm.data(), frame_size, 0);
+    if (ret < 0)
+    {
+        // Concealment failed
+        return false;
+    }
+
+    // Resize PCM vector to actual decoded size
+    pcm.resize(ret);
+
+    // Successful concealment
+    return true;
+}
+
 // Reset decoder state
 void OpusDecoderWrapper::ResetState()
 {
@@ -91,4 +154,21 @@ void OpusDecoderWrapper::ResetState()
         // Define reset state command
         opus_decoder_ctl(audio_decoder, OPUS_RESET_STATE);
     }
+}
+
+// Set the duration of a lost frame for FEC and concealment
+void OpusDecoderWrapper::SetDuration(int duration_ms_)
+{
+    // Lock mutex
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Keep decoder state, only the lost frame size changes
+    duration_ms = duration_ms_;
+    frame_size = sample_rate / 1000 * duration_ms;
+}
+
+// Check for a rate Opus decodes to directly
+bool OpusDecoderWrapper::IsSupportedRate(int sample_rate)
+{
+    return sample_rate == 8000 || sample_rate == 12000 || sample_rate == 16000 || sample_rate == 24000 || sample_rate == 48000;
 }
\ No newline at end of file
@@ -182,4 +182,61 @@ void OpusEncoderWrapper::SetComplexity(int complexity)
         // Set Complexity option
         opus_encoder_ctl(audio_encoder, OPUS_SET_COMPLEXITY(complexity));
     }
+}
+
+// Set Bitrate in bits per second
+void OpusEncoderWrapper::SetBitrate(int bitrate)
+{
+    // Lock mutex
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Set Bitrate option
+    if (audio_encoder != nullptr)
+    {
+        // Set Bitrate option
+        opus_encoder_ctl(audio_encoder, OPUS_SET_BITRATE(bitrate));
+    }
+}
+
+// Set maximum Bandwidth
+void OpusEncoderWrapper::SetBandwidth(int bandwidth)
+{
+    // Lock mutex
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Set Bandwidth option
+    if (audio_encoder != nullptr)
+    {
+        // Set Bandwidth option
+        opus_encoder_ctl(audio_encoder, OPUS_SET_MAX_BANDWIDTH(bandwidth));
+    }
+}
+
+// Set expected Packet Loss percentage
+void OpusEncoderWrapper::SetPacketLoss(int percent)
+{
+    // Lock mutex
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Set Packet Loss option
+    if (audio_encoder != nullptr)
+    {
+        // Set Packet Loss option
+        opus_encoder_ctl(audio_encoder, OPUS_SET_PACKET_LOSS_PERC(percent));
+    }
+}
+
+// Set in-band FEC, only produced while the expected packet loss is above zero
+void OpusEncoderWrapper::SetFec(bool enable)
+{
+    // Lock mutex
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Set FEC option
+    if (audio_encoder != nullptr)
+    {
+        // Set FEC option
+        opus_encoder_ctl(audio_encoder, OPUS_SET_INBAND_FEC(enable ? 1 : 0));
+        fec_enabled = enable;
+    }
 }
\ No newline at end of file
@@ -0,0 +1,113 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// Include headers
+#include "opus_packetizer.h"
+
+// Define log tag
+#define TAG "[client:components:opus:packetizer]"
+
+// Constructor
+OpusPacketizer::OpusPacketizer()
+{
+    // Create Opus repacketizer
+    repacketizer = opus_repacketizer_create();
+    if (repacketizer == nullptr)
+    {
+        ESP_LOGE(TAG, "Failed to create repacketizer");
+    }
+}
+
+// Destructor
+OpusPacketizer::~OpusPacketizer()
+{
+    // Destroy Opus repacketizer
+    if (repacketizer != nullptr)
+    {
+        opus_repacketizer_destroy(repacketizer);
+    }
+}
+
+// Add a packet
+bool OpusPacketizer::Add(const uint8_t *opus, size_t size)
+{
+    // Check capacity
+    if (repacketizer == nullptr || frame_count >= OPUS_PACKETIZER_MAX_FRAMES)
+    {
+        return false;
+    }
+
+    // Keep a copy, the repacketizer only references the data
+    auto &frame = frames[frame_count];
+    frame.assign(opus, opus + size);
+    if (opus_repacketizer_cat(repacketizer, frame.data(), static_cast<opus_int32>(frame.size())) != OPUS_OK)
+    {
+        return false;
+    }
+
+    // Count the frame
+    frame_count++;
+    return true;
+}
+
+// Write the joined packet
+bool OpusPacketizer::Flush(std::vector<uint8_t> &opus)
+{
+    // Check for frames
+    if (repacketizer == nullptr || frame_count == 0)
+    {
+        return false;
+    }
+
+    // A single frame needs no repacketization
+    if (frame_count == 1)
+    {
+        opus.assign(frames[0].begin(), frames[0].end());
+        Reset();
+        return true;
+    }
+
+    // Join frames, the output is at most the frames plus length prefixes
+    size_t max_size = 2;
+    for (int i = 0; i < frame_count; ++i)
+    {
+        max_size += frames[i].size() + 2;
+    }
+    opus.resize(max_size);
+    opus_int32 ret = opus_repacketizer_out(repacketizer, opus.data(), static_cast<opus_int32>(max_size));
+    Reset();
+    if (ret < 0)
+    {
+        ESP_LOGE(TAG, "Failed to join frames: %d", static_cast<int>(ret));
+        opus.clear();
+        return false;
+    }
+
+    // Trim to the written size
+    opus.resize(ret);
+    return true;
+}
+
+// Drop added frames
+void OpusPacketizer::Reset()
+{
+    // Reset Opus repacketizer
+    if (repacketizer != nullptr)
+    {
+        opus_repacketizer_init(repacketizer);
+    }
+    frame_count = 0;
+}
\ No newline at end of file
@@ -21,10 +21,14 @@ limitations under the License.
 #include <string>
 #include <vector>
 #include <functional>
+#include <algorithm>
+#include <cstring>
+#include <atomic>
 
 // Include ESP headers
 #include <esp_log.h>
 #include <esp_err.h>
+#include <esp_timer.h>
 #include <esp_afe_sr_models.h>
 #include <esp_afe_sr_iface.h>
 
@@ -40,6 +44,39 @@ limitations under the License.
 // Define processor running event bit
 #define PROCESSOR_RUNNING 0x01
 
+// Define profile the processor starts with
+#if defined(CONFIG_GEEKROS_AUDIO_AFE_PROFILE_LOW_POWER)
+#define AFE_PROFILE_DEFAULT AudioProcessorProfileLowPower
+#elif defined(CONFIG_GEEKROS_AUDIO_AFE_PROFILE_HIGH_QUALITY)
+#define AFE_PROFILE_DEFAULT AudioProcessorProfileHighQuality
+#else
+#define AFE_PROFILE_DEFAULT AudioProcessorProfileBalanced
+#endif
+
+// Define whether the CPU governor runs and the share of real time the AFE may use
+#ifdef CONFIG_GEEKROS_AUDIO_AFE_GOVERNOR
+#define AFE_GOVERNOR 1
+#else
+#define AFE_GOVERNOR 0
+#endif
+#ifdef CONFIG_GEEKROS_AUDIO_AFE_CPU_BUDGET
+#define AFE_CPU_BUDGET_PERCENT CONFIG_GEEKROS_AUDIO_AFE_CPU_BUDGET
+#else
+#define AFE_CPU_BUDGET_PERCENT 60
+#endif
+
+// Define governor decision interval, headroom a step up must leave, and how long an overrun profile is skipped
+#define AFE_GOVERNOR_INTERVAL_MS 2000
+#define AFE_GOVERNOR_MARGIN_PERCENT 10
+#define AFE_GOVERNOR_HOLD_MS 30000
+
+// Define CPU clock used to report fetch cost in cycles
+#ifdef CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ
+#define AFE_CPU_FREQ_MHZ CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ
+#else
+#define AFE_CPU_FREQ_MHZ 240
+#endif
+
 // AfeAudioProcessor class definition
 class AfeAudioProcessor : public AudioProcessor
 {
@@ -52,19 +89,51 @@ private:
     esp_afe_sr_data_t *afe_data = nullptr;
 
     // Define callback functions
-    std::function<void(std::vector<int16_t> &&data)> output_callback;
+    std::function<void(const int16_t *data, size_t samples)> output_callback;
     std::function<void(bool speaking)> vad_state_change_callback;
 
     // Audio codec pointer
     AudioCodec *codec = nullptr;
 
     // Define variables
-    int frame_samples = 0;
+    size_t frame_samples = 0;
     bool is_speaking = false;
-    std::vector<int16_t> output_buffer;
+
+    // Fixed frame buffer gathering AFE output that straddles fetches, the
+    // task drops a partial frame once Stop() asks it to
+    std::vector<int16_t> output_frame;
+    size_t output_fill = 0;
+    std::atomic<bool> output_drop{false};
+
+    // Profiles: the best one allowed, the one the governor picked and the one applied
+    std::atomic<int> profile_ceiling{AFE_PROFILE_DEFAULT};
+    std::atomic<int> profile_active{AFE_PROFILE_DEFAULT};
+    std::atomic<bool> governor{AFE_GOVERNOR};
+    std::atomic<bool> profile_requested{false};
+    int profile_applied = -1;
+    bool ns_available = false;
+    bool agc_available = false;
+
+    // CPU accounting: end of the last feed, and busy and audio time of the current window
+    std::atomic<int64_t> feed_us{0};
+    int64_t window_start_us = 0;
+    int64_t window_busy_us = 0;
+    int64_t window_audio_us = 0;
+    int profile_load[AudioProcessorProfileCount] = {-1, -1, -1};
+    int64_t profile_hold_until[AudioProcessorProfileCount] = {};
+
+    // Counters
+    std::atomic<int> load_percent{0};
+    std::atomic<uint32_t> fetch_us{0};
+    std::atomic<uint32_t> fetches{0};
+    std::atomic<uint32_t> switches{0};
 
     // Define private methods
     void AudioProcessorTask();
+    void EmitOutput(const int16_t *data, size_t samples);
+    void ApplyProfile(int profile);
+    void AccountFetch(int64_t busy_us, size_t samples, int64_t now_us);
+    static const char *ProfileName(int profile);
 
 public:
     // Constructor and destructor
@@ -72,15 +141,20 @@ public:
     virtual ~AfeAudioProcessor();
 
     // Define public methods
-    void Initialize(AudioCodec *codec_data, int frame_duration_ms) override;
-    void Feed(std::vector<int16_t> &&data) override;
+    void Initialize(AudioCodec *codec_data, int frame_duration_ms, bool loopback_reference = false) override;
+    void Feed(const std::vector<int16_t> &data) override;
     void Start() override;
     void Stop() override;
     bool IsRunning() override;
-    void OnOutput(std::function<void(std::vector<int16_t> &&data)> callback) override;
+    void OnOutput(std::function<void(const int16_t *data, size_t samples)> callback) override;
     void OnVadStateChange(std::function<void(bool speaking)> callback) override;
     size_t GetFeedSize() override;
     void EnableDeviceAec(bool enable) override;
+    // AFE and AEC modes and the AGC stage are fixed when the handle is built;
+    // a later profile change only switches NS and, if built, AGC
+    void SetProfile(AudioProcessorProfile profile) override;
+    void EnableGovernor(bool enable) override;
+    AudioProcessorStats GetStats() override;
 };
 
 #endif
\ No newline at end of file
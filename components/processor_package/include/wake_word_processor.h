@@ -0,0 +1,85 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef AUDIO_WAKE_WORD_PROCESSOR_H_
+#define AUDIO_WAKE_WORD_PROCESSOR_H_
+
+// Include standard headers
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstring>
+#include <atomic>
+
+// Include ESP headers
+#include <esp_log.h>
+#include <esp_err.h>
+#include <esp_timer.h>
+#include <esp_afe_sr_models.h>
+#include <esp_wn_iface.h>
+#include <esp_wn_models.h>
+
+// Include project headers
+#include "model_basic.h"
+
+// Define wake word statistics
+struct WakeWordStats
+{
+    uint32_t detections = 0;
+    uint32_t chunks = 0;
+    uint32_t detect_us = 0;
+};
+
+// WakeWordProcessor class definition. Runs WakeNet on 16 kHz mono frames
+// of any size; all calls must come from the same task.
+class WakeWordProcessor
+{
+private:
+    // WakeNet interface and model data
+    const esp_wn_iface_t *wakenet_iface = nullptr;
+    model_iface_data_t *wakenet_data = nullptr;
+    std::string wake_word;
+
+    // Fixed chunk buffer gathering frames that straddle WakeNet chunks
+    std::vector<int16_t> chunk;
+    size_t chunk_fill = 0;
+
+    // Counters
+    std::atomic<uint32_t> detections{0};
+    std::atomic<uint32_t> chunks{0};
+    std::atomic<uint32_t> detect_us{0};
+
+public:
+    // Constructor and destructor
+    WakeWordProcessor();
+    ~WakeWordProcessor();
+
+    // Load the first WakeNet model, returns false when none is flashed
+    bool Initialize();
+
+    // Run detection over samples, returns true when the wake word fired
+    bool Detect(const int16_t *data, size_t samples);
+
+    // Forget a partial chunk and the detector history
+    void Reset();
+
+    // Getters
+    bool IsInitialized() const { return wakenet_data != nullptr; }
+    const std::string &GetWakeWord() const { return wake_word; }
+    WakeWordStats GetStats() const;
+};
+
+#endif
\ No newline at end of file
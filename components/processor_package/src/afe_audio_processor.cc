@@ -46,21 +46,23 @@ AfeAudioProcessor::~AfeAudioProcessor()
 }
 
 // Initialize method
-void AfeAudioProcessor::Initialize(AudioCodec *codec_data, int frame_duration_ms)
+void AfeAudioProcessor::Initialize(AudioCodec *codec_data, int frame_duration_ms, bool loopback_reference)
 {
     // Store codec and frame samples
     codec = codec_data;
     frame_samples = frame_duration_ms * 16000 / 1000;
 
-    // Reserve output buffer size
-    output_buffer.reserve(frame_samples);
+    // Allocate the output frame once
+    output_frame.assign(frame_samples, 0);
+    output_fill = 0;
 
-    // Get reference channel number
-    int ref_num = codec->GetInputReference() ? 1 : 0;
+    // Get reference channel number, the playback loopback adds one to a mic-only codec
+    int codec_ref_num = codec->GetInputReference() ? 1 : 0;
+    int ref_num = codec_ref_num > 0 || loopback_reference ? 1 : 0;
 
     // Create input format string
     std::string input_format;
-    for (int i = 0; i < codec->GetInputChannels() - ref_num; i++)
+    for (int i = 0; i < codec->GetInputChannels() - codec_ref_num; i++)
     {
         input_format.push_back('M');
     }
@@ -78,9 +80,10 @@ void AfeAudioProcessor::Initialize(AudioCodec *codec_data, int frame_duration_ms
     char *ns_model_name = esp_srmodel_filter(models, ESP_NSNET_PREFIX, NULL);
     char *vad_model_name = esp_srmodel_filter(models, ESP_VADN_PREFIX, NULL);
 
-    // Initialize AFE configuration
-    afe_config_t *afe_config = afe_config_init(input_format.c_str(), NULL, AFE_TYPE_VC, AFE_MODE_HIGH_PERF);
-    afe_config->aec_mode = AEC_MODE_VOIP_HIGH_PERF;
+    // Initialize AFE configuration, the low-power profile also builds the cheaper AFE and AEC variants
+    bool low_cost = profile_ceiling.load() == AudioProcessorProfileLowPower;
+    afe_config_t *afe_config = afe_config_init(input_format.c_str(), NULL, AFE_TYPE_VC, low_cost ? AFE_MODE_LOW_COST : AFE_MODE_HIGH_PERF);
+    afe_config->aec_mode = low_cost ? AEC_MODE_VOIP_LOW_COST : AEC_MODE_VOIP_HIGH_PERF;
     afe_config->vad_mode = VAD_MODE_0;
     afe_config->vad_min_noise_ms = 100;
 
@@ -105,8 +108,11 @@ void AfeAudioProcessor::Initialize(AudioCodec *codec_data, int frame_duration_ms
         afe_config->ns_init = false;
     }
 
-    // Disable AGC
-    afe_config->agc_init = false;
+    // Build NS so profiles can switch it at runtime, AGC only when high quality may run
+    ns_available = ns_model_name != nullptr;
+    agc_available = profile_ceiling.load() == AudioProcessorProfileHighQuality;
+    afe_config->agc_init = agc_available;
+    afe_config->agc_mode = AFE_AGC_MODE_WEBRTC;
     afe_config->memory_alloc_mode = AFE_MEMORY_ALLOC_MORE_PSRAM;
 
 #ifdef CONFIG_USE_DEVICE_AEC
@@ -114,8 +120,8 @@ void AfeAudioProcessor::Initialize(AudioCodec *codec_data, int frame_duration_ms
     afe_config->aec_init = true;
     afe_config->vad_init = false;
 #else
-    // Disable AEC, enable VAD
-    afe_config->aec_init = false;
+    // Enable AEC only against the playback loopback, keep VAD
+    afe_config->aec_init = loopback_reference;
     afe_config->vad_init = true;
 #endif
 
@@ -123,6 +129,9 @@ void AfeAudioProcessor::Initialize(AudioCodec *codec_data, int frame_duration_ms
     afe_iface = const_cast<esp_afe_sr_iface_t *>(esp_afe_handle_from_config(afe_config));
     afe_data = afe_iface->create_from_config(afe_config);
 
+    // Apply the starting profile
+    ApplyProfile(profile_active.load());
+
     // Create audio processing task
     auto audio_communication_task = [](void *param)
     {
@@ -136,7 +145,7 @@ void AfeAudioProcessor::Initialize(AudioCodec *codec_data, int frame_duration_ms
 }
 
 // Feed audio data to AFE processor
-void AfeAudioProcessor::Feed(std::vector<int16_t> &&data)
+void AfeAudioProcessor::Feed(const std::vector<int16_t> &data)
 {
     // Feed data to AFE if initialized
     if (afe_data == nullptr)
@@ -144,8 +153,9 @@ void AfeAudioProcessor::Feed(std::vector<int16_t> &&data)
         return;
     }
 
-    // Feed data
+    // Feed data, noting when the fetch side has work again
     afe_iface->feed(afe_data, data.data());
+    feed_us = esp_timer_get_time();
 }
 
 // Start AFE audio processor
@@ -165,6 +175,9 @@ void AfeAudioProcessor::Stop()
     {
         afe_iface->reset_buffer(afe_data);
     }
+
+    // Drop a partial output frame, the task owns the frame buffer
+    output_drop = true;
 }
 
 // Get feed size
@@ -189,7 +202,7 @@ bool AfeAudioProcessor::IsRunning()
 }
 
 // On output callback
-void AfeAudioProcessor::OnOutput(std::function<void(std::vector<int16_t> &&data)> callback)
+void AfeAudioProcessor::OnOutput(std::function<void(const int16_t *data, size_t samples)> callback)
 {
     // Store output callback
     output_callback = callback;
@@ -216,7 +229,19 @@ void AfeAudioProcessor::AudioProcessorTask()
         // Wait until running
         xEventGroupWaitBits(event_group, PROCESSOR_RUNNING, pdFALSE, pdTRUE, portMAX_DELAY);
 
+        // Forget overrun holds once a profile was requested, then switch stages when the profile changed
+        if (profile_requested.exchange(false))
+        {
+            std::fill(std::begin(profile_hold_until), std::end(profile_hold_until), 0);
+        }
+        int profile = profile_active.load();
+        if (profile != profile_applied)
+        {
+            ApplyProfile(profile);
+        }
+
         // Fetch processed data
+        int64_t start_us = esp_timer_get_time();
         auto res = afe_iface->fetch_with_delay(afe_data, portMAX_DELAY);
         if ((xEventGroupGetBits(event_group) & PROCESSOR_RUNNING) == 0)
         {
@@ -233,6 +258,10 @@ void AfeAudioProcessor::AudioProcessorTask()
             continue;
         }
 
+        // Count the fetch as busy from when its input was there, not while it waited for a feed
+        int64_t end_us = esp_timer_get_time();
+        AccountFetch(std::max<int64_t>(0, end_us - std::max(start_us, feed_us.load())), res->data_size / sizeof(int16_t), end_us);
+
         // VAD state change handling
         if (vad_state_change_callback)
         {
@@ -254,28 +283,41 @@ void AfeAudioProcessor::AudioProcessorTask()
         // Output callback handling
         if (output_callback)
         {
-            // Determine number of samples
-            size_t samples = res->data_size / sizeof(int16_t);
+            EmitOutput(res->data, res->data_size / sizeof(int16_t));
+        }
+    }
+}
 
-            // Add data to buffer
-            output_buffer.insert(output_buffer.end(), res->data, res->data + samples);
+// Cut AFE output into frames, lending whole frames straight from the fetch buffer
+void AfeAudioProcessor::EmitOutput(const int16_t *data, size_t samples)
+{
+    // Start a new frame after a stop
+    if (output_drop.exchange(false))
+    {
+        output_fill = 0;
+    }
 
-            // Call output callback with frame-sized chunks
-            while (output_buffer.size() >= frame_samples)
-            {
-                // Invoke callback
-                if (output_buffer.size() == frame_samples)
-                {
-                    output_callback(std::move(output_buffer));
-                    output_buffer.clear();
-                    output_buffer.reserve(frame_samples);
-                }
-                else
-                {
-                    output_callback(std::vector<int16_t>(output_buffer.begin(), output_buffer.begin() + frame_samples));
-                    output_buffer.erase(output_buffer.begin(), output_buffer.begin() + frame_samples);
-                }
-            }
+    while (samples > 0)
+    {
+        // A whole frame with nothing pending is passed without copying
+        if (output_fill == 0 && samples >= frame_samples)
+        {
+            output_callback(data, frame_samples);
+            data += frame_samples;
+            samples -= frame_samples;
+            continue;
+        }
+
+        // Otherwise gather samples in the frame buffer until it is full
+        size_t count = std::min(samples, frame_samples - output_fill);
+        memcpy(output_frame.data() + output_fill, data, count * sizeof(int16_t));
+        output_fill += count;
+        data += count;
+        samples -= count;
+        if (output_fill == frame_samples)
+        {
+            output_callback(output_frame.data(), frame_samples);
+            output_fill = 0;
         }
     }
 }
@@ -286,8 +328,8 @@ void AfeAudioProcessor::EnableDeviceAec(bool enable)
     if (enable)
     {
 #ifdef CONFIG_USE_DEVICE_AEC
-        afe_iface_->disable_vad(afe_data);
-        afe_iface_->enable_aec(afe_data);
+        afe_iface->disable_vad(afe_data);
+        afe_iface->enable_aec(afe_data);
 #endif
     }
     else
@@ -296,4 +338,145 @@ void AfeAudioProcessor::EnableDeviceAec(bool enable)
         afe_iface->disable_aec(afe_data);
         afe_iface->enable_vad(afe_data);
     }
+}
+
+// Get profile name
+const char *AfeAudioProcessor::ProfileName(int profile)
+{
+    switch (profile)
+    {
+    case AudioProcessorProfileLowPower:
+        return "low-power";
+    case AudioProcessorProfileHighQuality:
+        return "high-quality";
+    default:
+        return "balanced";
+    }
+}
+
+// Switch the stages esp-sr can toggle on a live AFE handle
+void AfeAudioProcessor::ApplyProfile(int profile)
+{
+    // Noise suppression from balanced up
+    if (ns_available)
+    {
+        if (profile >= AudioProcessorProfileBalanced)
+        {
+            afe_iface->enable_ns(afe_data);
+        }
+        else
+        {
+            afe_iface->disable_ns(afe_data);
+        }
+    }
+
+    // Gain control only in high quality, when it was built
+    if (agc_available)
+    {
+        if (profile >= AudioProcessorProfileHighQuality)
+        {
+            afe_iface->enable_agc(afe_data);
+        }
+        else
+        {
+            afe_iface->disable_agc(afe_data);
+        }
+    }
+
+    // Start measuring the new profile from a clean window
+    ESP_LOGI(TAG, "AFE profile %s", ProfileName(profile));
+    profile_applied = profile;
+    window_start_us = 0;
+    window_busy_us = 0;
+    window_audio_us = 0;
+}
+
+// Account a fetch and let the governor pick the best profile that fits the CPU budget
+void AfeAudioProcessor::AccountFetch(int64_t busy_us, size_t samples, int64_t now_us)
+{
+    // Add the fetch to the window
+    fetch_us = static_cast<uint32_t>(busy_us);
+    fetches++;
+    window_busy_us += busy_us;
+    window_audio_us += static_cast<int64_t>(samples) * 1000000 / 16000;
+    if (window_start_us == 0)
+    {
+        window_start_us = now_us;
+    }
+    if (now_us - window_start_us < AFE_GOVERNOR_INTERVAL_MS * 1000 || window_audio_us == 0)
+    {
+        return;
+    }
+
+    // Close the window, remembering what the applied profile costs
+    int load = static_cast<int>(window_busy_us * 100 / window_audio_us);
+    load_percent = load;
+    profile_load[profile_applied] = load;
+    window_start_us = now_us;
+    window_busy_us = 0;
+    window_audio_us = 0;
+    if (!governor.load())
+    {
+        return;
+    }
+
+    // Step down on an overrun and skip that profile for a while, step up when the next one fits
+    int current = profile_applied;
+    int next = current;
+    if (load > AFE_CPU_BUDGET_PERCENT && current > AudioProcessorProfileLowPower)
+    {
+        profile_hold_until[current] = now_us + AFE_GOVERNOR_HOLD_MS * 1000LL;
+        next = current - 1;
+    }
+    else if (current < profile_ceiling.load() && now_us >= profile_hold_until[current + 1])
+    {
+        int estimate = profile_load[current + 1] >= 0 ? profile_load[current + 1] : load;
+        if (estimate + AFE_GOVERNOR_MARGIN_PERCENT <= AFE_CPU_BUDGET_PERCENT)
+        {
+            next = current + 1;
+        }
+    }
+
+    // Hand the decision to the next loop iteration
+    if (next != current)
+    {
+        ESP_LOGI(TAG, "AFE load %d%% of budget %d%%, %s -> %s", load, AFE_CPU_BUDGET_PERCENT, ProfileName(current), ProfileName(next));
+        profile_active = next;
+        switches++;
+    }
+}
+
+// Set the best profile to run
+void AfeAudioProcessor::SetProfile(AudioProcessorProfile profile)
+{
+    // The processing task applies it and forgets earlier overrun holds
+    profile_ceiling = profile;
+    profile_active = profile;
+    profile_requested = true;
+}
+
+// Enable or disable the CPU governor
+void AfeAudioProcessor::EnableGovernor(bool enable)
+{
+    // Without the governor the requested profile runs as is
+    governor = enable;
+    if (!enable)
+    {
+        profile_active = profile_ceiling.load();
+    }
+}
+
+// Get statistics
+AudioProcessorStats AfeAudioProcessor::GetStats()
+{
+    AudioProcessorStats stats;
+    stats.profile = profile_active.load();
+    stats.ceiling = profile_ceiling.load();
+    stats.governor = governor.load();
+    stats.load_percent = load_percent.load();
+    stats.fetch_us = fetch_us.load();
+    stats.fetch_cycles = fetch_us.load() * AFE_CPU_FREQ_MHZ;
+    stats.fetches = fetches.load();
+    stats.switches = switches.load();
+    return stats;
 }
\ No newline at end of file
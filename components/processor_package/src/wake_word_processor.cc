@@ -0,0 +1,144 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// Include headers
+#include "wake_word_processor.h"
+
+// Define log tag
+#define TAG "[client:components:processor:wake]"
+
+// Constructor
+WakeWordProcessor::WakeWordProcessor()
+{
+}
+
+// Destructor
+WakeWordProcessor::~WakeWordProcessor()
+{
+    // Destroy WakeNet data
+    if (wakenet_data != nullptr)
+    {
+        wakenet_iface->destroy(wakenet_data);
+        wakenet_data = nullptr;
+    }
+}
+
+// Load the first WakeNet model
+bool WakeWordProcessor::Initialize()
+{
+    // Initialize only once
+    if (wakenet_data != nullptr)
+    {
+        return true;
+    }
+
+    // Find a WakeNet model among the flashed models
+    srmodel_list_t *models = ModelBasic::Instance().Load();
+    char *wakenet_model_name = models != nullptr ? esp_srmodel_filter(models, ESP_WN_PREFIX, NULL) : nullptr;
+    if (wakenet_model_name == nullptr)
+    {
+        ESP_LOGW(TAG, "No WakeNet model found");
+        return false;
+    }
+
+    // Create the detector
+    wakenet_iface = esp_wn_handle_from_name(wakenet_model_name);
+    if (wakenet_iface == nullptr)
+    {
+        ESP_LOGE(TAG, "Unsupported WakeNet model: %s", wakenet_model_name);
+        return false;
+    }
+    wakenet_data = wakenet_iface->create(wakenet_model_name, DET_MODE_95);
+    if (wakenet_data == nullptr)
+    {
+        ESP_LOGE(TAG, "Failed to create WakeNet: %s", wakenet_model_name);
+        return false;
+    }
+
+    // Allocate the chunk buffer once
+    chunk.assign(wakenet_iface->get_samp_chunksize(wakenet_data), 0);
+    chunk_fill = 0;
+    char *word = wakenet_iface->get_word_name(wakenet_data, 1);
+    wake_word = word != nullptr ? word : "";
+
+    // Return true on success
+    ESP_LOGI(TAG, "WakeNet %s ready, wake word %s, chunk %u", wakenet_model_name, wake_word.c_str(), (unsigned)chunk.size());
+    return true;
+}
+
+// Run detection over samples
+bool WakeWordProcessor::Detect(const int16_t *data, size_t samples)
+{
+    // Check if initialized
+    if (wakenet_data == nullptr || chunk.empty())
+    {
+        return false;
+    }
+
+    // Gather samples into WakeNet chunks and detect on each full one
+    bool detected = false;
+    while (samples > 0)
+    {
+        size_t count = std::min(samples, chunk.size() - chunk_fill);
+        memcpy(chunk.data() + chunk_fill, data, count * sizeof(int16_t));
+        chunk_fill += count;
+        data += count;
+        samples -= count;
+        if (chunk_fill < chunk.size())
+        {
+            break;
+        }
+        chunk_fill = 0;
+
+        // Detect, tracking the cost of one chunk
+        int64_t start_us = esp_timer_get_time();
+        int result = wakenet_iface->detect(wakenet_data, chunk.data());
+        detect_us = (detect_us.load() * 7 + static_cast<uint32_t>(esp_timer_get_time() - start_us)) / 8;
+        chunks++;
+        if (result > 0)
+        {
+            detected = true;
+        }
+    }
+
+    // Count and log detections
+    if (detected)
+    {
+        detections++;
+        ESP_LOGI(TAG, "Wake word detected: %s", wake_word.c_str());
+    }
+    return detected;
+}
+
+// Forget a partial chunk and the detector history
+void WakeWordProcessor::Reset()
+{
+    chunk_fill = 0;
+    if (wakenet_data != nullptr)
+    {
+        wakenet_iface->clean(wakenet_data);
+    }
+}
+
+// Get statistics
+WakeWordStats WakeWordProcessor::GetStats() const
+{
+    WakeWordStats stats;
+    stats.detections = detections.load();
+    stats.chunks = chunks.load();
+    stats.detect_us = detect_us.load();
+    return stats;
+}
\ No newline at end of file
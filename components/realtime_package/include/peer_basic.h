@@ -22,6 +22,7 @@ limitations under the License.
 #include <vector>
 #include <unordered_map>
 #include <mutex>
+#include <atomic>
 #include <functional>
 
 // Include ESP headers
@@ -41,6 +42,9 @@ limitations under the License.
 #include "esp_peer.h"
 #include "esp_peer_default.h"
 
+// Include utils headers
+#include "utils_latency.h"
+
 // Define peer data channel meta structure
 struct PeerDataChannelMeta
 {
@@ -48,6 +52,21 @@ struct PeerDataChannelMeta
     std::string label;
 };
 
+// Define queued outgoing audio frame with latency tags
+struct PeerAudioTxFrame
+{
+    esp_peer_audio_frame_t frame;
+    int64_t origin_us;
+    int64_t queued_us;
+};
+
+// Define outgoing audio counters since the peer was created
+struct PeerAudioTxStats
+{
+    uint32_t sent = 0;
+    uint32_t failed = 0;
+};
+
 // Define peer callbacks structure
 struct PeerCallbacks
 {
@@ -56,7 +75,8 @@ struct PeerCallbacks
     std::function<void(std::string label, std::string event, std::string data)> on_datachannel_calledback;
     std::function<void(std::string label, std::string event, esp_peer_audio_stream_info_t *info)> on_audio_info_calledback;
     std::function<void(std::string label, std::string event, esp_peer_video_stream_info_t *info)> on_video_info_calledback;
-    std::function<void(std::string label, std::string event, const esp_peer_audio_frame_t *frame)> on_audio_frame_received;
+    // Audio frames arrive every few milliseconds, so this callback carries no strings
+    std::function<void(const esp_peer_audio_frame_t *frame)> on_audio_frame_received;
     std::function<void(std::string label, std::string event, const esp_peer_video_frame_t *frame)> on_video_frame_received;
 };
 
@@ -74,6 +94,10 @@ private:
     // Send mutex
     SemaphoreHandle_t send_mutex = nullptr;
 
+    // Outgoing audio counters, feed the uplink rate controller
+    std::atomic<uint32_t> audio_tx_sent{0};
+    std::atomic<uint32_t> audio_tx_failed{0};
+
     // Peer callbacks
     PeerCallbacks callbacks;
 
@@ -157,7 +181,10 @@ public:
     esp_err_t SendVideoFrame(const esp_peer_video_frame_t *frame);
 
     // Send audio frame method
-    esp_err_t SendAudioFrame(const esp_peer_audio_frame_t *frame);
+    esp_err_t SendAudioFrame(const esp_peer_audio_frame_t *frame, int64_t origin_us = 0);
+
+    // Get outgoing audio counters
+    PeerAudioTxStats GetAudioTxStats() const;
 
     // Send data channel message method
     esp_err_t SendDataChannelMessage(esp_peer_data_channel_type_t type, std::string label, const uint8_t *data, int size);
@@ -62,7 +62,7 @@ struct RealtimeCallbacks
     std::function<void(std::string label, std::string event, std::string data)> on_peer_datachannel_calledback;
     std::function<void(std::string label, std::string event, esp_peer_audio_stream_info_t *info)> on_peer_audio_info_calledback;
     std::function<void(std::string label, std::string event, esp_peer_video_stream_info_t *info)> on_peer_video_info_calledback;
-    std::function<void(std::string label, std::string event, const esp_peer_audio_frame_t *frame)> on_peer_audio_calledback;
+    std::function<void(const esp_peer_audio_frame_t *frame)> on_peer_audio_calledback;
     std::function<void(std::string label, std::string event, const esp_peer_video_frame_t *frame)> on_peer_video_calledback;
 };
 
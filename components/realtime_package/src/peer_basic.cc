@@ -287,7 +287,7 @@ int PeerBasic::OnAudioDataHandler(esp_peer_audio_frame_t *frame, void *ctx)
     if (self->callbacks.on_audio_frame_received)
     {
         // Invoke audio frame received callback
-        self->callbacks.on_audio_frame_received("audio", "peer:audio:frame", frame);
+        self->callbacks.on_audio_frame_received(frame);
     }
 
     // Return success
@@ -457,7 +457,7 @@ void PeerBasic::PeerSendAudioTask(void *param)
 
     self->peer_send_audio_task_running = true;
 
-    esp_peer_audio_frame_t frame = {};
+    PeerAudioTxFrame item = {};
 
     while (self->peer_send_audio_task_running)
     {
@@ -466,14 +466,35 @@ void PeerBasic::PeerSendAudioTask(void *param)
             break;
         }
 
-        if (xQueueReceive(self->audio_tx_queue, &frame, portMAX_DELAY) == pdTRUE)
+        if (xQueueReceive(self->audio_tx_queue, &item, portMAX_DELAY) == pdTRUE)
         {
+            esp_peer_audio_frame_t &frame = item.frame;
             if (frame.data && frame.size > 0)
             {
                 if (xSemaphoreTake(self->send_mutex, pdMS_TO_TICKS(50)) == pdTRUE)
                 {
-                    esp_peer_send_audio(self->client_peer, &frame);
+                    int ret = esp_peer_send_audio(self->client_peer, &frame);
                     xSemaphoreGive(self->send_mutex);
+
+                    // Count the result for the rate controller
+                    if (ret == ESP_PEER_ERR_NONE)
+                    {
+                        self->audio_tx_sent++;
+                    }
+                    else
+                    {
+                        self->audio_tx_failed++;
+                    }
+
+                    // Record uplink latency up to the network
+                    int64_t now_us = UtilsLatency::Now();
+                    UtilsLatency::Instance().Record(UtilsLatencyUplinkPeer, item.queued_us, now_us);
+                    UtilsLatency::Instance().Record(UtilsLatencyUplinkTotal, item.origin_us, now_us);
+                }
+                else
+                {
+                    // The sender is blocked, the frame is lost
+                    self->audio_tx_failed++;
                 }
                 free(frame.data);
             }
@@ -557,7 +578,7 @@ esp_err_t PeerBasic::CreatePeer(const std::vector<std::string> &stun_urls)
     }
 
     // Create audio and video transmit queues
-    audio_tx_queue = xQueueCreate(8, sizeof(esp_peer_audio_frame_t));
+    audio_tx_queue = xQueueCreate(8, sizeof(PeerAudioTxFrame));
     video_tx_queue = xQueueCreate(8, sizeof(esp_peer_video_frame_t));
 
     // Define peer extra configuration
@@ -903,8 +924,12 @@ void PeerBasic::CreatePeerDataChannels()
         return;
     }
 
-    // Define data channel names
+    // Define data channel names, with a tap channel when audio taps stream over it
+#ifdef CONFIG_GEEKROS_AUDIO_TAP_SINK_DATA_CHANNEL
+    const char *channels[] = {"chat", "event", "tap"};
+#else
     const char *channels[] = {"chat", "event"};
+#endif
 
     // Create data channels
     for (const char *ch_name : channels)
@@ -970,32 +995,42 @@ esp_err_t PeerBasic::SendVideoFrame(const esp_peer_video_frame_t *frame)
 }
 
 // end audio frame method
-esp_err_t PeerBasic::SendAudioFrame(const esp_peer_audio_frame_t *frame)
+esp_err_t PeerBasic::SendAudioFrame(const esp_peer_audio_frame_t *frame, int64_t origin_us)
 {
     if (!client_peer || !frame || !frame->data || frame->size <= 0 || !audio_tx_queue)
     {
         return ESP_FAIL;
     }
 
-    esp_peer_audio_frame_t copy = *frame;
+    PeerAudioTxFrame copy = {*frame, origin_us, UtilsLatency::Now()};
 
-    uint8_t *buf = (uint8_t *)malloc(copy.size);
+    uint8_t *buf = (uint8_t *)malloc(copy.frame.size);
     if (!buf)
     {
         return ESP_FAIL;
     }
-    memcpy(buf, copy.data, copy.size);
-    copy.data = buf;
+    memcpy(buf, copy.frame.data, copy.frame.size);
+    copy.frame.data = buf;
 
     if (xQueueSend(audio_tx_queue, &copy, 0) != pdTRUE)
     {
         free(buf);
+        audio_tx_failed++;
         return ESP_FAIL;
     }
 
     return ESP_OK;
 }
 
+// Get outgoing audio counters
+PeerAudioTxStats PeerBasic::GetAudioTxStats() const
+{
+    PeerAudioTxStats stats;
+    stats.sent = audio_tx_sent.load();
+    stats.failed = audio_tx_failed.load();
+    return stats;
+}
+
 // Send data channel message method
 esp_err_t PeerBasic::SendDataChannelMessage(esp_peer_data_channel_type_t type, std::string label, const uint8_t *data, int size)
 {
@@ -112,13 +112,13 @@ void RealtimeBasic::RealtimeConnect(void)
         };
 
         // Set audio frame received callback
-        peer_callbacks.on_audio_frame_received = [this](std::string label, std::string event, const esp_peer_audio_frame_t *frame)
+        peer_callbacks.on_audio_frame_received = [this](const esp_peer_audio_frame_t *frame)
         {
             // Invoke callback
             if (callbacks.on_peer_audio_calledback)
             {
                 // Notify audio frame received event
-                callbacks.on_peer_audio_calledback(label, event, frame);
+                callbacks.on_peer_audio_calledback(frame);
             }
         };
 
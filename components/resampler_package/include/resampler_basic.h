@@ -0,0 +1,112 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef RESAMPLER_BASIC_H
+#define RESAMPLER_BASIC_H
+
+// Include standard headers
+#include <vector>
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+
+// Include ESP headers
+#include <esp_log.h>
+#include <esp_err.h>
+
+// Include SDK configuration
+#include "sdkconfig.h"
+
+// Use the esp-dsp dot product where the target accelerates it
+#if CONFIG_IDF_TARGET_ESP32S3
+#define RESAMPLER_SIMD 1
+#include "dsps_dotprod.h"
+#else
+#define RESAMPLER_SIMD 0
+#endif
+
+// Define filter zero crossings on each side, sets the passband sharpness
+#define RESAMPLER_ZERO_CROSSINGS 8
+
+// Define most taps per phase, bounds the cost of large decimation ratios
+#define RESAMPLER_MAX_TAPS 64
+
+// Define passband edge as a fraction of the lower Nyquist frequency
+#define RESAMPLER_CUTOFF 0.9f
+
+// Define Kaiser window shape, about 70 dB stopband
+#define RESAMPLER_KAISER_BETA 7.0f
+
+// Define most interleaved channels processed in one pass
+#define RESAMPLER_MAX_CHANNELS 4
+
+// Polyphase FIR resampler for any rational ratio. Channels stay interleaved
+// and are filtered together in one pass over the input.
+class ResamplerBasic
+{
+private:
+    // Member variables
+    int input_sample_rate = 0;
+    int output_sample_rate = 0;
+    int channels = 1;
+
+    // Reduced ratio: upsample by interpolation, step input by decimation per phase
+    int interpolation = 1;
+    int decimation = 1;
+    int taps = 0;
+
+    // Q14 coefficients, one row of taps per phase, ordered oldest sample
+    // first; the spare bit keeps filter overshoot from wrapping the sum
+    std::vector<int16_t> coefficients;
+
+    // Frames not yet consumed followed by the current input, interleaved
+    std::vector<int16_t> frames;
+    int history_frames = 0;
+    int phase = 0;
+
+    // Frames split per channel for the SIMD dot product
+    std::vector<int16_t> planar_frames;
+
+    // Private methods
+    void Design();
+    static float BesselI0(float x);
+    static int16_t Saturate(int32_t value);
+
+public:
+    // Constructor and Destructor
+    ResamplerBasic();
+    ~ResamplerBasic();
+
+    // Configure resampler
+    void Configure(int input_sample_rate_, int output_sample_rate_, int channels_ = 1);
+
+    // Resample interleaved samples, returns interleaved samples written;
+    // output must hold GetOutputSamples(input_samples)
+    int Process(const int16_t *input, int input_samples, int16_t *output);
+
+    // Interleaved samples the next Process() call will write
+    int GetOutputSamples(int input_samples) const;
+
+    // Forget buffered input
+    void Reset();
+
+    // Getters for sample rates
+    int InputSampleRate() const { return input_sample_rate; }
+    int OutputSampleRate() const { return output_sample_rate; }
+    int Channels() const { return channels; }
+};
+
+#endif
\ No newline at end of file
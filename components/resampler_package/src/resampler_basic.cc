@@ -0,0 +1,238 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// Include headers
+#include "resampler_basic.h"
+
+// Define log tag
+#define TAG "[client:components:resampler:basic]"
+
+// Constructor
+ResamplerBasic::ResamplerBasic()
+{
+}
+
+// Destructor
+ResamplerBasic::~ResamplerBasic()
+{
+}
+
+// Modified Bessel function of the first kind, order zero
+float ResamplerBasic::BesselI0(float x)
+{
+    float sum = 1.0f;
+    float term = 1.0f;
+    for (int k = 1; k < 32; ++k)
+    {
+        term *= (x / (2.0f * k)) * (x / (2.0f * k));
+        sum += term;
+        if (term < sum * 1e-9f)
+        {
+            break;
+        }
+    }
+    return sum;
+}
+
+// Clamp to 16 bits
+int16_t ResamplerBasic::Saturate(int32_t value)
+{
+    return static_cast<int16_t>(value > INT16_MAX ? INT16_MAX : (value < INT16_MIN ? INT16_MIN : value));
+}
+
+// Configure resampler
+void ResamplerBasic::Configure(int input_sample_rate_, int output_sample_rate_, int channels_)
+{
+    // Check for valid parameters
+    if (input_sample_rate_ <= 0 || output_sample_rate_ <= 0 || channels_ <= 0 || channels_ > RESAMPLER_MAX_CHANNELS)
+    {
+        ESP_LOGE(TAG, "Invalid configuration %d -> %d Hz, %d channels", input_sample_rate_, output_sample_rate_, channels_);
+        return;
+    }
+
+    // Save sample rates and channels
+    input_sample_rate = input_sample_rate_;
+    output_sample_rate = output_sample_rate_;
+    channels = channels_;
+
+    // Reduce the ratio to the smallest phase count
+    int a = input_sample_rate;
+    int b = output_sample_rate;
+    while (b != 0)
+    {
+        int t = a % b;
+        a = b;
+        b = t;
+    }
+    interpolation = output_sample_rate / a;
+    decimation = input_sample_rate / a;
+
+    // Design the filter bank and start from silence
+    Design();
+    Reset();
+    ESP_LOGI(TAG, "Resampler %d -> %d Hz, %d channels, %d phases x %d taps", input_sample_rate, output_sample_rate, channels, interpolation, taps);
+}
+
+// Design the windowed-sinc prototype and split it into phases
+void ResamplerBasic::Design()
+{
+    // Widen the filter when decimating so the cutoff keeps its sharpness
+    float ratio = static_cast<float>(interpolation) / decimation;
+    float scale = ratio < 1.0f ? ratio : 1.0f;
+    taps = static_cast<int>(std::ceil(2.0f * RESAMPLER_ZERO_CROSSINGS / scale));
+    taps = (taps + 3) & ~3;
+    taps = taps > RESAMPLER_MAX_TAPS ? RESAMPLER_MAX_TAPS : taps;
+
+    // Prototype runs at the interpolated rate, centered on its middle tap
+    int length = taps * interpolation;
+    float center = (length - 1) * 0.5f;
+    float cutoff = RESAMPLER_CUTOFF * 0.5f * scale / interpolation;
+    float window_norm = BesselI0(RESAMPLER_KAISER_BETA);
+    coefficients.assign(length, 0);
+    std::vector<float> row(taps);
+    for (int phase_index = 0; phase_index < interpolation; ++phase_index)
+    {
+        // Tap j of a phase weighs the j-th oldest frame of its window
+        float sum = 0.0f;
+        for (int j = 0; j < taps; ++j)
+        {
+            int n = (taps - 1 - j) * interpolation + phase_index;
+            float t = n - center;
+            float sinc = t == 0.0f ? 2.0f * cutoff : std::sin(2.0f * M_PI * cutoff * t) / (M_PI * t);
+            float w = t / (center + 0.5f);
+            float window = BesselI0(RESAMPLER_KAISER_BETA * std::sqrt(std::fmax(0.0f, 1.0f - w * w))) / window_norm;
+            row[j] = sinc * window;
+            sum += row[j];
+        }
+
+        // Normalize each phase to unity DC gain, in Q14
+        for (int j = 0; j < taps; ++j)
+        {
+            coefficients[phase_index * taps + j] = static_cast<int16_t>(std::lround(row[j] / sum * (1 << 14)));
+        }
+    }
+}
+
+// Forget buffered input
+void ResamplerBasic::Reset()
+{
+    // Prime with silence so the first output has a full window
+    history_frames = taps > 0 ? taps - 1 : 0;
+    frames.assign(history_frames * channels, 0);
+    phase = 0;
+}
+
+// Interleaved samples the next Process() call will write
+int ResamplerBasic::GetOutputSamples(int input_samples) const
+{
+    // Count outputs whose window fits in the buffered and new frames
+    if (taps == 0)
+    {
+        return 0;
+    }
+    int64_t total = history_frames + input_samples / channels;
+    int64_t limit = (total - taps + 1) * interpolation - 1 - phase;
+    if (limit < 0)
+    {
+        return 0;
+    }
+    return static_cast<int>((limit / decimation + 1) * channels);
+}
+
+// Resample interleaved samples
+int ResamplerBasic::Process(const int16_t *input, int input_samples, int16_t *output)
+{
+    // Check if configured
+    if (taps == 0)
+    {
+        ESP_LOGE(TAG, "Resampler not configured");
+        return 0;
+    }
+
+    // Append input behind the buffered frames
+    int input_frames = input_samples / channels;
+    int total = history_frames + input_frames;
+    frames.resize(static_cast<size_t>(total) * channels);
+    std::memcpy(frames.data() + static_cast<size_t>(history_frames) * channels, input, static_cast<size_t>(input_frames) * channels * sizeof(int16_t));
+
+#if RESAMPLER_SIMD
+    // Split channels so each window is contiguous for the dot product
+    if (channels > 1)
+    {
+        planar_frames.resize(static_cast<size_t>(total) * channels);
+        for (int c = 0; c < channels; ++c)
+        {
+            int16_t *plane = planar_frames.data() + static_cast<size_t>(c) * total;
+            for (int i = 0; i < total; ++i)
+            {
+                plane[i] = frames[i * channels + c];
+            }
+        }
+    }
+#endif
+
+    // Produce every output whose window is complete
+    int position = 0;
+    int written = 0;
+    while (position + taps <= total)
+    {
+        const int16_t *row = coefficients.data() + phase * taps;
+#if RESAMPLER_SIMD
+        for (int c = 0; c < channels; ++c)
+        {
+            const int16_t *window = channels > 1 ? planar_frames.data() + static_cast<size_t>(c) * total + position : frames.data() + position;
+
+            // esp-dsp returns 16 bits of its sum: the top bits rounded up and
+            // the exact low bits rebuild it, so rounding matches the scalar path
+            int16_t high = 0;
+            int16_t low = 0;
+            dsps_dotprod_s16(window, row, &high, taps, 0);
+            dsps_dotprod_s16(window, row, &low, taps, 15);
+            int32_t base = static_cast<int32_t>(high) * (1 << 15);
+            int32_t acc = base - static_cast<uint16_t>(base - static_cast<uint16_t>(low));
+            output[written++] = Saturate((acc + (1 << 13)) >> 14);
+        }
+#else
+        int32_t acc[RESAMPLER_MAX_CHANNELS] = {0};
+        const int16_t *window = frames.data() + static_cast<size_t>(position) * channels;
+        for (int j = 0; j < taps; ++j)
+        {
+            int32_t coefficient = row[j];
+            for (int c = 0; c < channels; ++c)
+            {
+                acc[c] += window[j * channels + c] * coefficient;
+            }
+        }
+        for (int c = 0; c < channels; ++c)
+        {
+            output[written++] = Saturate((acc[c] + (1 << 13)) >> 14);
+        }
+#endif
+
+        // Step to the next output phase
+        phase += decimation;
+        position += phase / interpolation;
+        phase %= interpolation;
+    }
+
+    // Keep the unconsumed frames for the next call
+    history_frames = total - position;
+    std::memmove(frames.data(), frames.data() + static_cast<size_t>(position) * channels, static_cast<size_t>(history_frames) * channels * sizeof(int16_t));
+    frames.resize(static_cast<size_t>(history_frames) * channels);
+
+    // Return interleaved samples written
+    return written;
+}
\ No newline at end of file
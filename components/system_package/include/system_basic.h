@@ -31,6 +31,9 @@ limitations under the License.
 #include "freertos/task.h"
 #include "freertos/event_groups.h"
 
+// Include utils headers
+#include "utils_latency.h"
+
 // SystemBasic class definition
 class SystemBasic
 {
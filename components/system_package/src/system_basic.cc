@@ -73,4 +73,7 @@ void SystemBasic::HealthCheck()
     int free_sram = heap_caps_get_free_size(MALLOC_CAP_INTERNAL);
     int min_free_sram = heap_caps_get_minimum_free_size(MALLOC_CAP_INTERNAL);
     ESP_LOGI(TAG, "Free sram: %u Minimal sram: %u", free_sram, min_free_sram);
+
+    // Log audio latency per stage
+    UtilsLatency::Instance().Dump();
 }
\ No newline at end of file
@@ -0,0 +1,118 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef UTILS_LATENCY_H
+#define UTILS_LATENCY_H
+
+// Include standard headers
+#include <atomic>
+#include <cstdint>
+
+// Include ESP headers
+#include <esp_log.h>
+#include <esp_err.h>
+#include <esp_timer.h>
+
+// Define histogram buckets, 8 per power of two milliseconds
+#define UTILS_LATENCY_BUCKETS 96
+
+// Define audio latency stages
+enum UtilsLatencyStage
+{
+    // Uplink: mic capture to network
+    UtilsLatencyUplinkAfe,
+    UtilsLatencyUplinkEncode,
+    UtilsLatencyUplinkDispatch,
+    UtilsLatencyUplinkPeer,
+    UtilsLatencyUplinkTotal,
+
+    // Downlink: network to speaker
+    UtilsLatencyDownlinkJitter,
+    UtilsLatencyDownlinkDecode,
+    UtilsLatencyDownlinkPlayback,
+    UtilsLatencyDownlinkTotal,
+
+    // Codec power-up to first sample
+    UtilsLatencyPowerInput,
+    UtilsLatencyPowerOutput,
+
+    // Wake word detection to its first uplink packet handed to the network
+    UtilsLatencyWakeFirstPacket,
+
+    // Number of stages
+    UtilsLatencyStageCount,
+};
+
+// Define latency statistics of one stage
+struct UtilsLatencyStats
+{
+    uint32_t count = 0;
+    uint32_t p50_ms = 0;
+    uint32_t p95_ms = 0;
+    uint32_t p99_ms = 0;
+    uint32_t max_ms = 0;
+};
+
+// UtilsLatency class definition
+class UtilsLatency
+{
+private:
+    // Lock-free histogram of one stage
+    struct Histogram
+    {
+        std::atomic<uint32_t> buckets[UTILS_LATENCY_BUCKETS];
+        std::atomic<uint32_t> max_ms;
+    };
+    Histogram histograms[UtilsLatencyStageCount];
+
+    // Private methods
+    static int BucketOf(uint32_t ms);
+    static uint32_t BucketUpperMs(int bucket);
+
+public:
+    // Constructor and Destructor
+    UtilsLatency();
+    ~UtilsLatency();
+
+    // Get the singleton instance of the UtilsLatency class
+    static UtilsLatency &Instance()
+    {
+        static UtilsLatency instance;
+        return instance;
+    }
+
+    // Delete copy constructor and assignment operator
+    UtilsLatency(const UtilsLatency &) = delete;
+    UtilsLatency &operator=(const UtilsLatency &) = delete;
+
+    // Get monotonic timestamp for stage boundaries
+    static int64_t Now() { return esp_timer_get_time(); }
+
+    // Record the time spent in a stage, ignored when start is unset
+    void Record(UtilsLatencyStage stage, int64_t start_us, int64_t end_us);
+
+    // Query and reset statistics
+    UtilsLatencyStats GetStats(UtilsLatencyStage stage);
+    void Reset();
+
+    // Log all stages
+    void Dump();
+
+    // Get stage name
+    static const char *StageName(UtilsLatencyStage stage);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,191 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// Include the headers
+#include "utils_latency.h"
+
+// Define log tag
+#define TAG "[client:components:utils:latency]"
+
+// Constructor
+UtilsLatency::UtilsLatency()
+{
+    // Start with empty histograms
+    Reset();
+}
+
+// Destructor
+UtilsLatency::~UtilsLatency()
+{
+}
+
+// Map milliseconds to a bucket, exact below 8 ms then 8 buckets per octave
+int UtilsLatency::BucketOf(uint32_t ms)
+{
+    if (ms < 8)
+    {
+        return ms;
+    }
+    int octave = 31 - __builtin_clz(ms);
+    int bucket = 8 * (octave - 2) + ((ms >> (octave - 3)) & 7);
+    return bucket < UTILS_LATENCY_BUCKETS ? bucket : UTILS_LATENCY_BUCKETS - 1;
+}
+
+// Get the largest millisecond value a bucket holds
+uint32_t UtilsLatency::BucketUpperMs(int bucket)
+{
+    if (bucket < 8)
+    {
+        return bucket;
+    }
+    int octave = bucket / 8 + 2;
+    int sub = bucket % 8;
+    return ((8u + sub + 1) << (octave - 3)) - 1;
+}
+
+// Record the time spent in a stage
+void UtilsLatency::Record(UtilsLatencyStage stage, int64_t start_us, int64_t end_us)
+{
+    // Ignore frames that were not tagged
+    if (start_us <= 0 || end_us < start_us || stage >= UtilsLatencyStageCount)
+    {
+        return;
+    }
+
+    // Count sample
+    auto &histogram = histograms[stage];
+    uint32_t ms = static_cast<uint32_t>((end_us - start_us) / 1000);
+    histogram.buckets[BucketOf(ms)].fetch_add(1, std::memory_order_relaxed);
+
+    // Track maximum
+    uint32_t max_ms = histogram.max_ms.load(std::memory_order_relaxed);
+    while (ms > max_ms && !histogram.max_ms.compare_exchange_weak(max_ms, ms, std::memory_order_relaxed))
+    {
+    }
+}
+
+// Get statistics of a stage
+UtilsLatencyStats UtilsLatency::GetStats(UtilsLatencyStage stage)
+{
+    // Snapshot counters
+    UtilsLatencyStats stats;
+    auto &histogram = histograms[stage];
+    uint32_t counts[UTILS_LATENCY_BUCKETS];
+    uint32_t total = 0;
+    for (int i = 0; i < UTILS_LATENCY_BUCKETS; ++i)
+    {
+        counts[i] = histogram.buckets[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+    stats.count = total;
+    stats.max_ms = histogram.max_ms.load(std::memory_order_relaxed);
+    if (total == 0)
+    {
+        return stats;
+    }
+
+    // Walk cumulative counts for percentiles
+    uint32_t p50 = (total * 50 + 99) / 100;
+    uint32_t p95 = (total * 95 + 99) / 100;
+    uint32_t p99 = (total * 99 + 99) / 100;
+    uint32_t seen = 0;
+    for (int i = 0; i < UTILS_LATENCY_BUCKETS; ++i)
+    {
+        uint32_t before = seen;
+        seen += counts[i];
+        uint32_t upper = BucketUpperMs(i);
+        if (before < p50 && seen >= p50)
+        {
+            stats.p50_ms = upper;
+        }
+        if (before < p95 && seen >= p95)
+        {
+            stats.p95_ms = upper;
+        }
+        if (before < p99 && seen >= p99)
+        {
+            stats.p99_ms = upper;
+        }
+    }
+
+    // Bucket bounds never exceed the observed maximum
+    stats.p50_ms = stats.p50_ms < stats.max_ms ? stats.p50_ms : stats.max_ms;
+    stats.p95_ms = stats.p95_ms < stats.max_ms ? stats.p95_ms : stats.max_ms;
+    stats.p99_ms = stats.p99_ms < stats.max_ms ? stats.p99_ms : stats.max_ms;
+    return stats;
+}
+
+// Reset all histograms
+void UtilsLatency::Reset()
+{
+    for (auto &histogram : histograms)
+    {
+        for (auto &bucket : histogram.buckets)
+        {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        histogram.max_ms.store(0, std::memory_order_relaxed);
+    }
+}
+
+// Log all stages
+void UtilsLatency::Dump()
+{
+    for (int i = 0; i < UtilsLatencyStageCount; ++i)
+    {
+        auto stage = static_cast<UtilsLatencyStage>(i);
+        auto stats = GetStats(stage);
+        if (stats.count == 0)
+        {
+            continue;
+        }
+        ESP_LOGI(TAG, "%-18s n=%lu p50=%lums p95=%lums p99=%lums max=%lums", StageName(stage), (unsigned long)stats.count, (unsigned long)stats.p50_ms, (unsigned long)stats.p95_ms, (unsigned long)stats.p99_ms, (unsigned long)stats.max_ms);
+    }
+}
+
+// Get stage name
+const char *UtilsLatency::StageName(UtilsLatencyStage stage)
+{
+    switch (stage)
+    {
+    case UtilsLatencyUplinkAfe:
+        return "uplink:afe";
+    case UtilsLatencyUplinkEncode:
+        return "uplink:encode";
+    case UtilsLatencyUplinkDispatch:
+        return "uplink:dispatch";
+    case UtilsLatencyUplinkPeer:
+        return "uplink:peer";
+    case UtilsLatencyUplinkTotal:
+        return "uplink:total";
+    case UtilsLatencyDownlinkJitter:
+        return "downlink:jitter";
+    case UtilsLatencyDownlinkDecode:
+        return "downlink:decode";
+    case UtilsLatencyDownlinkPlayback:
+        return "downlink:playback";
+    case UtilsLatencyDownlinkTotal:
+        return "downlink:total";
+    case UtilsLatencyPowerInput:
+        return "power:input";
+    case UtilsLatencyPowerOutput:
+        return "power:output";
+    case UtilsLatencyWakeFirstPacket:
+        return "wake:first_packet";
+    default:
+        return "unknown";
+    }
+}
\ No newline at end of file
@@ -80,6 +80,12 @@ void Application::ApplicationMain()
     // Initialize system components
     SystemBasic::Instance().Init(GEEKROS_SPIFFS_BASE_PATH, GEEKROS_SPIFFS_LABEL, GEEKROS_SPIFFS_MAX_FILE);
 
+    // Write audio tap records to SPIFFS
+    if (AUDIO_TAP && !AUDIO_TAP_SINK_DATA_CHANNEL)
+    {
+        AudioTap::Instance().OpenFile(GEEKROS_SPIFFS_BASE_PATH "/taps.bin", AUDIO_TAP_FILE_KB * 1024);
+    }
+
     // Initialize system settings
     SystemSettings::Instance().Initialize();
 
@@ -112,7 +118,7 @@ void Application::ApplicationMain()
         audio_service.EnableVoiceProcessing(false);
 
         // Play WiFi configuration sound
-        audio_service.PlaySound(Lang::Sounds::OGG_WIFI_CONFIG);
+        audio_service.PlaySound(Lang::Sounds::WIFI_CONFIG);
 
         // Wait until audio service is idle
         while (!audio_service.IsIdle())
@@ -137,11 +143,33 @@ void Application::ApplicationMain()
         {
             // ESP_LOGI(TAG, "Realtime Peer Data Channel Event: %s label=%s data=%s", event.c_str(), label.c_str(), data.c_str());
 
+            // Stream audio tap records while the tap channel is open, each message holds whole records
+            if (AUDIO_TAP_SINK_DATA_CHANNEL && label == "tap" && event != "peer:datachannel:data")
+            {
+                if (event == "peer:datachannel:open")
+                {
+                    AudioTap::Instance().SetSink([](const uint8_t *data, size_t size)
+                                                 { return RealtimeBasic::Instance().GetPeerInstance()->SendDataChannelMessage(ESP_PEER_DATA_CHANNEL_DATA, "tap", data, size) == ESP_OK; });
+                }
+                else
+                {
+                    AudioTap::Instance().SetSink(nullptr);
+                }
+            }
+
             if (event == "peer:datachannel:open" && label == "event")
             {
                 // Initialize audio service
                 audio_service.Initialize(audio_codec);
 
+                // Apply the uplink settings chosen in menuconfig
+                audio_service.EnableUplinkFec(AUDIO_UPLINK_FEC);
+                audio_service.SetUplinkPacketDuration(AUDIO_UPLINK_PACKET_MS);
+
+                // Apply the voice processing profile and governor chosen in menuconfig
+                audio_service.SetProcessorProfile(AFE_PROFILE_DEFAULT);
+                audio_service.EnableProcessorGovernor(AFE_GOVERNOR);
+
                 // Start audio service
                 audio_service.Start();
 
@@ -158,10 +186,16 @@ void Application::ApplicationMain()
                 {
                     xEventGroupSetBits(event_group, MAIN_EVENT_VAD_CHANGE);
                 };
+                audio_service_callbacks.on_wake_word = [this](const std::string &wake_word)
+                {
+                    // Power the speaker up before the reply audio arrives
+                    ESP_LOGI(TAG, "Wake Word: %s", wake_word.c_str());
+                    audio_service.Prewarm(AudioPowerHintSignaling);
+                };
                 audio_service.SetCallbacks(audio_service_callbacks);
 
                 // Play WiFi configuration sound
-                audio_service.PlaySound(Lang::Sounds::OGG_WIFI_SUCCESS);
+                audio_service.PlaySound(Lang::Sounds::WIFI_SUCCESS);
 
                 // Wait until audio service is idle
                 while (!audio_service.IsIdle())
@@ -177,6 +211,12 @@ void Application::ApplicationMain()
                     // Handle short press to unmute uplink audio
                     if (event == "button:short:press")
                     {
+                        // Power the codec up before the user starts talking
+                        audio_service.Prewarm(AudioPowerHintButton);
+
+                        // Open the uplink without waiting for the wake word
+                        audio_service.SetUplinkAwake(true);
+
                         // Unmute uplink audio if muted
                         if (mute_uplink_audio)
                         {
@@ -189,6 +229,7 @@ void Application::ApplicationMain()
 
                             // Unmute uplink audio
                             mute_uplink_audio = false;
+                            audio_service.SetUplinkMuted(false);
 
                             // Reset last audio time
                             last_audio_time_us = esp_timer_get_time();
@@ -209,12 +250,18 @@ void Application::ApplicationMain()
             if (event == "connection:wakeup:status" && label == "event")
             {
                 ESP_LOGI(TAG, "Wakeup Status: %s", data.c_str());
+
+                // Power the codec up ahead of the conversation
+                audio_service.Prewarm(AudioPowerHintSignaling);
             }
 
             // Handle speak status event
             if (event == "connection:speak:status" && label == "event")
             {
                 ESP_LOGI(TAG, "Speak Status: %s", data.c_str());
+
+                // Power the speaker up before the reply audio arrives
+                audio_service.Prewarm(AudioPowerHintSignaling);
             }
 
             // Handle wakeup status event
@@ -231,32 +278,28 @@ void Application::ApplicationMain()
         {
             ESP_LOGI(TAG, "Realtime Peer Video Info Event: %s label=%s codec=%d, width=%d, height=%d, fps=%d", event.c_str(), label.c_str(), info->codec, info->width, info->height, info->fps);
         };
-        realtime_callbacks.on_peer_audio_calledback = [this](std::string label, std::string event, const esp_peer_audio_frame_t *frame)
+        realtime_callbacks.on_peer_audio_calledback = [this](const esp_peer_audio_frame_t *frame)
         {
-            // ESP_LOGI(TAG, "Realtime Peer Audio Data Event: %s label=%s pts=%u, size=%d", event.c_str(), label.c_str(), frame->pts, frame->size);
+            // ESP_LOGI(TAG, "Realtime Peer Audio Data Event: pts=%u, size=%d", frame->pts, frame->size);
 
-            // Check event and frame validity
-            if (event != "peer:audio:frame" || !frame || frame->size == 0)
+            // Check frame validity
+            if (!frame || frame->size == 0)
             {
                 return;
             }
 
-            mute_uplink_audio = true;
+            // Mute uplink audio while the server speaks
+            if (!mute_uplink_audio)
+            {
+                mute_uplink_audio = true;
+                audio_service.SetUplinkMuted(true);
+            }
 
             // Update last audio time
             last_audio_time_us = esp_timer_get_time();
 
-            // Create audio service stream packet
-            auto packet = std::make_unique<AudioServiceStreamPacket>();
-            packet->payload.assign(frame->data, frame->data + frame->size);
-
-            // Set sample rate and timestamp
-            packet->sample_rate = 16000;
-            packet->frame_duration = OPUS_FRAME_DURATION_MS;
-            packet->timestamp = frame->pts;
-
             // Push packet to decode queue without waiting
-            audio_service.PushPacketToDecodeQueue(std::move(packet));
+            audio_service.PushPacketToDecodeQueue(frame->data, frame->size, 16000, OPUS_FRAME_DURATION_MS, frame->pts);
         };
         realtime_callbacks.on_peer_video_calledback = [this](std::string label, std::string event, const esp_peer_video_frame_t *frame)
         {
@@ -303,39 +346,21 @@ void Application::ApplicationLoop()
             if (peer)
             {
                 // Send audio frames from audio service send queue
-                while (auto packet = audio_service.PopPacketFromSendQueue())
+                while (audio_service.PopPacketFromSendQueue(uplink_packet))
                 {
-                    // Check if we need to send silence
-                    if (mute_uplink_audio)
-                    {
-                        static std::vector<uint8_t> silence_opus;
-                        silence_opus.assign(packet->payload.size(), 0);
+                    // Get packet from the reused uplink buffer
+                    auto *packet = &uplink_packet;
 
-                        // Prepare esp_peer_audio_frame_t
-                        esp_peer_audio_frame_t frame = {};
-                        frame.data = silence_opus.data();
-                        frame.size = silence_opus.size();
-                        frame.pts = packet->timestamp;
+                    // Prepare esp_peer_audio_frame_t, muted uplink packets are already DTX frames
+                    esp_peer_audio_frame_t frame = {};
+                    frame.data = packet->payload.data();
+                    frame.size = packet->payload.size();
+                    frame.pts = packet->timestamp;
 
-                        // Send audio frame via peer
-                        if (!peer->SendAudioFrame(&frame))
-                        {
-                            break;
-                        }
-                    }
-                    else
+                    // Send audio frame via peer
+                    if (peer->SendAudioFrame(&frame, packet->origin_us) != ESP_OK)
                     {
-                        // Prepare esp_peer_audio_frame_t
-                        esp_peer_audio_frame_t frame = {};
-                        frame.data = packet->payload.data();
-                        frame.size = packet->payload.size();
-                        frame.pts = packet->timestamp;
-
-                        // Send audio frame via peer
-                        if (!peer->SendAudioFrame(&frame))
-                        {
-                            break;
-                        }
+                        break;
                     }
                 }
             }
@@ -354,11 +379,26 @@ void Application::ApplicationLoop()
             // Increment health check clock
             health_check_clock++;
 
+            // Report uplink results since the last tick to the rate controller
+            auto *peer = RealtimeBasic::Instance().GetPeerInstance();
+            if (peer)
+            {
+                PeerAudioTxStats tx = peer->GetAudioTxStats();
+                if (tx.sent >= uplink_reported.sent && tx.failed >= uplink_reported.failed)
+                {
+                    audio_service.ReportUplink(tx.sent - uplink_reported.sent, tx.failed - uplink_reported.failed);
+                }
+                uplink_reported = tx;
+            }
+
             // Check if it's time for health check
             if (health_check_clock % 60 == 0)
             {
                 // Perform system health check every 30 seconds
                 SystemBasic::HealthCheck();
+
+                // Log audio pipeline counters with the health check
+                ESP_LOGI(TAG, "Audio Stats: %s", audio_service.GetStatsJson().c_str());
             }
         }
 
@@ -376,6 +416,7 @@ void Application::ApplicationLoop()
 
                 // Unmute uplink audio
                 mute_uplink_audio = false;
+                audio_service.SetUplinkMuted(false);
             }
         }
 
@@ -82,6 +82,12 @@ private:
     // mute uplink audio flag
     bool mute_uplink_audio = false;
 
+    // Reused buffer for packets popped from the send queue
+    AudioServiceStreamPacket uplink_packet;
+
+    // Peer audio counters at the last uplink report
+    PeerAudioTxStats uplink_reported;
+
 public:
     // Constructor and destructor
     Application();
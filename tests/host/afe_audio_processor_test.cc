@@ -0,0 +1,145 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// Include standard headers
+#include <mutex>
+#include <chrono>
+#include <vector>
+#include <cstdint>
+#include <condition_variable>
+
+// Include test headers
+#include <gtest/gtest.h>
+
+// Include headers
+#include "afe_audio_processor.h"
+#include "fake_codec.h"
+
+// Define AFE feed chunk and the frame the processor cuts its output into
+#define TEST_FEED_SAMPLES 512
+#define TEST_FRAME_MS 20
+#define TEST_FRAME_SAMPLES 320
+
+// Frames the processor emitted, gathered from its task
+class FrameLog
+{
+private:
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<std::vector<int16_t>> frames;
+
+public:
+    void Add(const int16_t *data, size_t samples)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            frames.emplace_back(data, data + samples);
+        }
+        cv.notify_all();
+    }
+
+    // Wait for a frame count, returns the frames seen by then
+    std::vector<std::vector<int16_t>> Wait(size_t count)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait_for(lock, std::chrono::seconds(2), [this, count]()
+                    { return frames.size() >= count; });
+        return frames;
+    }
+};
+
+// Processor over an AFE fetching a given chunk, fed a sample counter
+class AfeFramingTest : public ::testing::TestWithParam<int>
+{
+protected:
+    AfeAudioProcessor *processor = nullptr;
+    FrameLog *log = nullptr;
+    int16_t next = 0;
+
+    void SetUp() override
+    {
+        // The processing task never returns, so the processor outlives the test
+        HostAfeSetChunks(TEST_FEED_SAMPLES, GetParam());
+        processor = new AfeAudioProcessor();
+        log = new FrameLog();
+        processor->Initialize(new FakeCodec(16000, 16000), TEST_FRAME_MS);
+        FrameLog *frames = log;
+        processor->OnOutput([frames](const int16_t *data, size_t samples)
+                            { frames->Add(data, samples); });
+        processor->Start();
+    }
+
+    // Feed chunks of counting samples
+    void Feed(int chunks)
+    {
+        std::vector<int16_t> chunk(TEST_FEED_SAMPLES);
+        for (int i = 0; i < chunks; ++i)
+        {
+            for (int16_t &sample : chunk)
+            {
+                sample = next++;
+            }
+            processor->Feed(chunk);
+        }
+    }
+};
+
+// Fetches of any size come out as whole frames carrying every sample once, in order
+TEST_P(AfeFramingTest, CutsFetchesIntoFrames)
+{
+    // Feed whole fetches, the last partial frame stays pending
+    int chunks = 10;
+    size_t fetched = static_cast<size_t>(chunks) * TEST_FEED_SAMPLES / GetParam() * GetParam();
+    size_t expected = fetched / TEST_FRAME_SAMPLES;
+    Feed(chunks);
+    std::vector<std::vector<int16_t>> frames = log->Wait(expected);
+
+    ASSERT_EQ(frames.size(), expected);
+    int16_t sample = 0;
+    for (size_t i = 0; i < frames.size(); ++i)
+    {
+        ASSERT_EQ(frames[i].size(), static_cast<size_t>(TEST_FRAME_SAMPLES)) << "frame " << i;
+        for (int16_t value : frames[i])
+        {
+            ASSERT_EQ(value, sample++) << "frame " << i;
+        }
+    }
+}
+
+// Stopping drops a partial frame, output after a restart starts a new one
+TEST_P(AfeFramingTest, StopDropsPartialFrame)
+{
+    // Feed until a partial frame is pending
+    int chunks = (GetParam() + TEST_FEED_SAMPLES - 1) / TEST_FEED_SAMPLES;
+    Feed(chunks);
+    size_t fetched = static_cast<size_t>(chunks) * TEST_FEED_SAMPLES / GetParam() * GetParam();
+    std::vector<std::vector<int16_t>> frames = log->Wait(fetched / TEST_FRAME_SAMPLES);
+    ASSERT_EQ(frames.size(), fetched / TEST_FRAME_SAMPLES);
+    ASSERT_NE(fetched % TEST_FRAME_SAMPLES, 0u);
+
+    // Restart and feed a fresh run of samples, its first frame starts with it
+    // even when the task was still gathering the partial frame
+    processor->Stop();
+    processor->Start();
+    size_t before = frames.size();
+    next = 20000;
+    Feed(2);
+    frames = log->Wait(before + 1);
+    ASSERT_GT(frames.size(), before);
+    EXPECT_EQ(frames[before][0], 20000);
+}
+
+INSTANTIATE_TEST_SUITE_P(FetchSizes, AfeFramingTest, ::testing::Values(512, 480, 160, 1024));
\ No newline at end of file
@@ -0,0 +1,159 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// Include standard headers
+#include <algorithm>
+#include <cstdint>
+
+// Include test headers
+#include <gtest/gtest.h>
+
+// Include headers
+#include "bitrate_basic.h"
+
+// Define controller bounds of the tests
+#define TEST_MIN_BITRATE 8000
+#define TEST_MAX_BITRATE 32000
+#define TEST_START_BITRATE 24000
+
+// Define frames sent per decision interval, 20 ms frames
+#define TEST_INTERVAL_FRAMES 50
+
+// Controller driven one decision interval at a time
+class AudioBitrateControllerTest : public ::testing::Test
+{
+protected:
+    AudioBitrateController controller;
+    int64_t now_us = 1000000;
+
+    void SetUp() override
+    {
+        controller.Configure(TEST_MIN_BITRATE, TEST_MAX_BITRATE, TEST_START_BITRATE);
+        controller.Update(now_us, 0);
+    }
+
+    // Report an interval of frames, failed_percent of them lost, and decide
+    bool Interval(int failed_percent, int queue_ms = 0)
+    {
+        uint32_t failed = TEST_INTERVAL_FRAMES * failed_percent / 100;
+        controller.Report(TEST_INTERVAL_FRAMES - failed, failed);
+        now_us += AUDIO_BITRATE_INTERVAL_MS * 1000;
+        return controller.Update(now_us, queue_ms);
+    }
+};
+
+// Loss backs the bitrate off by a quarter
+TEST_F(AudioBitrateControllerTest, BacksOffOnLoss)
+{
+    EXPECT_TRUE(Interval(10));
+    EXPECT_EQ(controller.Bitrate(), TEST_START_BITRATE * 3 / 4);
+    EXPECT_GT(controller.LossPercent(), 0);
+    EXPECT_EQ(controller.GetStats().decreases, 1u);
+}
+
+// A send queue past the threshold backs off without any loss
+TEST_F(AudioBitrateControllerTest, BacksOffOnQueue)
+{
+    Interval(0, AUDIO_BITRATE_QUEUE_HIGH_MS);
+    EXPECT_EQ(controller.Bitrate(), TEST_START_BITRATE * 3 / 4);
+    Interval(0, AUDIO_BITRATE_QUEUE_HIGH_MS - 1);
+    EXPECT_EQ(controller.Bitrate(), TEST_START_BITRATE * 3 / 4);
+}
+
+// Clean intervals probe up one step at a time, never past the bounds
+TEST_F(AudioBitrateControllerTest, ProbesUpAdditively)
+{
+    for (int i = 0; i < AUDIO_BITRATE_CLEAN_INTERVALS - 1; ++i)
+    {
+        Interval(0);
+        EXPECT_EQ(controller.Bitrate(), TEST_START_BITRATE);
+    }
+    Interval(0);
+    EXPECT_EQ(controller.Bitrate(), TEST_START_BITRATE + AUDIO_BITRATE_STEP);
+    for (int i = 0; i < AUDIO_BITRATE_CLEAN_INTERVALS * 10; ++i)
+    {
+        Interval(0);
+    }
+    EXPECT_EQ(controller.Bitrate(), TEST_MAX_BITRATE);
+    for (int i = 0; i < 10; ++i)
+    {
+        Interval(50);
+    }
+    EXPECT_EQ(controller.Bitrate(), TEST_MIN_BITRATE);
+}
+
+// The smoothed loss passed to the encoder decays back to zero once losses stop
+TEST_F(AudioBitrateControllerTest, LossDecaysToZero)
+{
+    Interval(20);
+    Interval(2);
+    ASSERT_GT(controller.LossPercent(), 0);
+    for (int i = 0; i < 20 && controller.LossPercent() > 0; ++i)
+    {
+        int previous = controller.LossPercent();
+        EXPECT_TRUE(Interval(0));
+        EXPECT_LT(controller.LossPercent(), previous);
+    }
+    EXPECT_EQ(controller.LossPercent(), 0);
+    Interval(0);
+    EXPECT_EQ(controller.LossPercent(), 0);
+}
+
+// Automatic packetization joins frames under congestion and splits them again slowly
+TEST_F(AudioBitrateControllerTest, JoinsFramesUnderCongestion)
+{
+    controller.SetPacketFrames(3, true);
+    EXPECT_EQ(controller.PacketFrames(), 1);
+    Interval(10);
+    EXPECT_EQ(controller.PacketFrames(), 2);
+    Interval(10);
+    Interval(10);
+    EXPECT_EQ(controller.PacketFrames(), 3);
+    for (int i = 0; i < AUDIO_PACKET_CLEAN_INTERVALS; ++i)
+    {
+        Interval(0);
+    }
+    EXPECT_EQ(controller.PacketFrames(), 2);
+}
+
+// Against a link that loses what exceeds its capacity the bitrate settles
+// near the capacity, and climbs again once the link clears
+TEST_F(AudioBitrateControllerTest, TracksRateLimitedLink)
+{
+    int capacity = 14000;
+    int low = TEST_MAX_BITRATE;
+    int high = 0;
+    for (int i = 0; i < 60; ++i)
+    {
+        int bitrate = controller.Bitrate();
+        Interval(bitrate > capacity ? (bitrate - capacity) * 100 / bitrate : 0);
+        if (i >= 30)
+        {
+            low = std::min(low, controller.Bitrate());
+            high = std::max(high, controller.Bitrate());
+        }
+    }
+    EXPECT_GE(low, capacity * 3 / 4 - AUDIO_BITRATE_STEP);
+    EXPECT_LE(high, capacity + AUDIO_BITRATE_STEP);
+
+    // The link clears: the rate climbs to the bound and the loss decays
+    for (int i = 0; i < 60; ++i)
+    {
+        Interval(0);
+    }
+    EXPECT_EQ(controller.Bitrate(), TEST_MAX_BITRATE);
+    EXPECT_EQ(controller.LossPercent(), 0);
+}
\ No newline at end of file
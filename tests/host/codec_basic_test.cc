@@ -0,0 +1,255 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// Include standard headers
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <cstdint>
+
+// Include test headers
+#include <gtest/gtest.h>
+
+// Include headers
+#include "codec_basic.h"
+
+// Define stream format of the tests
+#define TEST_SAMPLE_RATE 16000
+#define TEST_RING 960
+
+// Define the segment the producer mixes and how long the clocked stream plays
+#define TEST_SEGMENT 320
+#define TEST_STREAM_MS 600
+
+// Codec with host I2S channels, tests play the DMA by raising its events
+class StreamCodec : public AudioCodec
+{
+protected:
+    int Read(int16_t *dest, int samples) override { return samples; }
+    int Write(const int16_t *data, int samples) override { return samples; }
+
+public:
+    StreamCodec()
+    {
+        duplex = true;
+        input_sample_rate = TEST_SAMPLE_RATE;
+        output_sample_rate = TEST_SAMPLE_RATE;
+        tx_handle = HostI2sCreateChannel();
+    }
+    i2s_chan_handle_t GetTxHandle() const { return tx_handle; }
+};
+
+// Output stream driven by host TX DMA events
+class AudioCodecStreamTest : public ::testing::Test
+{
+protected:
+    StreamCodec codec;
+    std::vector<int16_t> dma = std::vector<int16_t>(AUDIO_CODEC_DMA_FRAME_NUM);
+
+    void SetUp() override
+    {
+        ASSERT_TRUE(codec.EnableOutputStream(TEST_RING));
+        codec.Start();
+    }
+
+    // Time of the DMA queue: a refilled buffer waits for the descriptors ahead of it
+    static int64_t DmaDelayUs()
+    {
+        return static_cast<int64_t>(AUDIO_CODEC_DMA_DESC_NUM - 1) * AUDIO_CODEC_DMA_FRAME_NUM * 1000000 / TEST_SAMPLE_RATE;
+    }
+
+    // Send one DMA buffer and return the time it was sent
+    int64_t Send()
+    {
+        int64_t now_us = esp_timer_get_time();
+        HostI2sSent(codec.GetTxHandle(), dma.data(), dma.size());
+        return now_us;
+    }
+};
+
+// Samples written behind queued ones play after them, dated from the last DMA event
+TEST_F(AudioCodecStreamTest, DatesWritesFromDmaEvents)
+{
+    std::vector<int16_t> pcm(AUDIO_CODEC_DMA_FRAME_NUM * 2, 100);
+    ASSERT_EQ(codec.WriteOutputStream(pcm.data(), pcm.size()), pcm.size());
+
+    // The sent buffer was refilled with the first half, writes go in two buffers after its start
+    int64_t sent_us = Send();
+    int64_t buffer_us = AUDIO_CODEC_DMA_FRAME_NUM * 1000000LL / TEST_SAMPLE_RATE;
+    int64_t play_us = codec.GetOutputPlayTime();
+    EXPECT_GE(play_us, sent_us + DmaDelayUs() + 2 * buffer_us);
+    EXPECT_LT(play_us, sent_us + DmaDelayUs() + 2 * buffer_us + 5000);
+}
+
+// A drained ring plays new samples once the DMA queue ahead of them is sent
+TEST_F(AudioCodecStreamTest, DrainedRingPlaysAfterDmaQueue)
+{
+    std::vector<int16_t> pcm(AUDIO_CODEC_DMA_FRAME_NUM, 100);
+    codec.WriteOutputStream(pcm.data(), pcm.size());
+    Send();
+    Send();
+    int64_t now_us = esp_timer_get_time();
+    int64_t play_us = codec.GetOutputPlayTime();
+    EXPECT_GE(play_us, now_us + DmaDelayUs());
+    EXPECT_LT(play_us, now_us + DmaDelayUs() + 5000);
+}
+
+// A gap fades from the last sample to silence and counts once while playing
+TEST_F(AudioCodecStreamTest, FadesAndCountsUnderruns)
+{
+    std::vector<int16_t> pcm(100, 8000);
+    codec.SetOutputStreamActive(true);
+    codec.WriteOutputStream(pcm.data(), pcm.size());
+    Send();
+
+    // Queued samples play unchanged, then ramp down and stay silent
+    for (size_t i = 0; i < pcm.size(); ++i)
+    {
+        ASSERT_EQ(dma[i], 8000) << "sample " << i;
+    }
+    EXPECT_LT(dma[pcm.size()], 8000);
+    for (size_t i = pcm.size() + 1; i < pcm.size() + AUDIO_CODEC_UNDERRUN_FADE; ++i)
+    {
+        ASSERT_LE(dma[i], dma[i - 1]) << "sample " << i;
+    }
+    for (size_t i = pcm.size() + AUDIO_CODEC_UNDERRUN_FADE - 1; i < dma.size(); ++i)
+    {
+        ASSERT_EQ(dma[i], 0) << "sample " << i;
+    }
+
+    // A gap spanning several buffers is one underrun, every missing sample counts
+    Send();
+    AudioCodecStreamStats stats = codec.GetOutputStreamStats();
+    EXPECT_EQ(stats.dma_events, 2u);
+    EXPECT_EQ(stats.underruns, 1u);
+    EXPECT_EQ(stats.underrun_samples, 2 * AUDIO_CODEC_DMA_FRAME_NUM - pcm.size());
+
+    // Data after the gap ends it, the next gap counts again
+    codec.WriteOutputStream(pcm.data(), pcm.size());
+    Send();
+    EXPECT_EQ(codec.GetOutputStreamStats().underruns, 2u);
+}
+
+// Gaps while nothing plays are silence, not underruns
+TEST_F(AudioCodecStreamTest, IdleGapsAreNotUnderruns)
+{
+    Send();
+    Send();
+    AudioCodecStreamStats stats = codec.GetOutputStreamStats();
+    EXPECT_EQ(stats.underruns, 0u);
+    EXPECT_EQ(stats.underrun_samples, 0u);
+    for (int16_t sample : dma)
+    {
+        ASSERT_EQ(sample, 0);
+    }
+}
+
+// The producer is woken once, when the DMA has freed room for its segment
+TEST_F(AudioCodecStreamTest, WakesProducerOnceSpaceFits)
+{
+    std::vector<int16_t> pcm(TEST_RING, 100);
+    ASSERT_EQ(codec.WriteOutputStream(pcm.data(), pcm.size()), static_cast<size_t>(TEST_RING));
+    EXPECT_FALSE(codec.WaitOutputStreamSpace(xTaskGetCurrentTaskHandle(), TEST_SEGMENT));
+
+    // One buffer frees less than a segment, the second frees enough
+    uint64_t gives = HostNotifyGiveCount();
+    Send();
+    EXPECT_EQ(HostNotifyGiveCount(), gives);
+    Send();
+    EXPECT_EQ(HostNotifyGiveCount(), gives + 1);
+    EXPECT_EQ(ulTaskNotifyTake(pdTRUE, 0), 1u);
+
+    // Further buffers do not wake it again until it waits again
+    Send();
+    EXPECT_EQ(HostNotifyGiveCount(), gives + 1);
+    EXPECT_TRUE(codec.WaitOutputStreamSpace(xTaskGetCurrentTaskHandle(), TEST_SEGMENT));
+}
+
+// A producer waiting on space keeps a DMA clocked stream fed without gaps,
+// and every sample plays once and in order
+TEST_F(AudioCodecStreamTest, ClockedStreamPlaysWithoutGaps)
+{
+    // Prime the ring the way playback starts, samples count up
+    size_t written = 0;
+    std::vector<int16_t> segment(TEST_SEGMENT);
+    auto fill = [&segment, &written]()
+    {
+        for (int16_t &sample : segment)
+        {
+            sample = static_cast<int16_t>(written++ % 10000);
+        }
+    };
+    for (int i = 0; i < TEST_RING / TEST_SEGMENT; ++i)
+    {
+        fill();
+        codec.WriteOutputStream(segment.data(), segment.size());
+    }
+    codec.SetOutputStreamActive(true);
+
+    // Clock the DMA at the sample rate on its own thread, keeping what it played
+    std::atomic<bool> running{true};
+    std::vector<int16_t> played;
+    std::thread clock([this, &running, &played]()
+                      {
+        auto period = std::chrono::microseconds(AUDIO_CODEC_DMA_FRAME_NUM * 1000000LL / TEST_SAMPLE_RATE);
+        auto due = std::chrono::steady_clock::now();
+        std::vector<int16_t> buffer(AUDIO_CODEC_DMA_FRAME_NUM);
+        while (running)
+        {
+            due += period;
+            std::this_thread::sleep_until(due);
+            HostI2sSent(codec.GetTxHandle(), buffer.data(), buffer.size());
+            played.insert(played.end(), buffer.begin(), buffer.end());
+        } });
+
+    // Mix a segment whenever one fits, sleeping on the DMA wakeup otherwise
+    auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(TEST_STREAM_MS);
+    while (std::chrono::steady_clock::now() < end)
+    {
+        if (!codec.WaitOutputStreamSpace(xTaskGetCurrentTaskHandle(), TEST_SEGMENT))
+        {
+            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(100));
+            continue;
+        }
+        fill();
+        ASSERT_EQ(codec.WriteOutputStream(segment.data(), segment.size()), static_cast<size_t>(TEST_SEGMENT));
+    }
+    codec.SetOutputStreamActive(false);
+    running = false;
+    clock.join();
+
+    // Nothing ran dry while playing, and what played is what was written
+    AudioCodecStreamStats stats = codec.GetOutputStreamStats();
+    EXPECT_EQ(stats.underruns, 0u);
+    EXPECT_GE(stats.dma_events, static_cast<uint32_t>(TEST_STREAM_MS * TEST_SAMPLE_RATE / 1000 / AUDIO_CODEC_DMA_FRAME_NUM * 3 / 4));
+    size_t checked = std::min(played.size(), written);
+    for (size_t i = 0; i < checked; ++i)
+    {
+        ASSERT_EQ(played[i], static_cast<int16_t>(i % 10000)) << "sample " << i;
+    }
+}
+
+// Blocking writes are dated behind the DMA queue as well
+TEST(AudioCodecTest, BlockingWritesPlayAfterDmaQueue)
+{
+    StreamCodec codec;
+    int64_t now_us = esp_timer_get_time();
+    int64_t play_us = codec.GetOutputPlayTime();
+    int64_t delay_us = static_cast<int64_t>(AUDIO_CODEC_DMA_DESC_NUM - 1) * AUDIO_CODEC_DMA_FRAME_NUM * 1000000 / TEST_SAMPLE_RATE;
+    EXPECT_GE(play_us, now_us + delay_us);
+    EXPECT_LT(play_us, now_us + delay_us + 5000);
+}
\ No newline at end of file
@@ -0,0 +1,161 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// Include standard headers
+#include <vector>
+#include <cstdint>
+
+// Include test headers
+#include <gtest/gtest.h>
+
+// Include headers
+#include "jitter_basic.h"
+
+// Define stream format of the tests
+#define TEST_SAMPLE_RATE 16000
+#define TEST_FRAME_MS 60
+
+// Jitter buffer fed with one-byte payloads that name their timestamp
+class JitterBufferTest : public ::testing::Test
+{
+protected:
+    AudioJitterBuffer buffer;
+
+    void SetUp() override { buffer.Initialize(16); }
+
+    // Push a packet arriving exactly on its timestamp
+    void Push(uint32_t timestamp, int frame_duration = TEST_FRAME_MS)
+    {
+        std::vector<uint8_t> payload(1, static_cast<uint8_t>(timestamp / TEST_FRAME_MS));
+        buffer.Push(payload, TEST_SAMPLE_RATE, frame_duration, timestamp, static_cast<int64_t>(timestamp) * 1000);
+    }
+
+    // Pop the next action and the timestamp of the packet it carries
+    AudioJitterAction Pop(uint32_t &timestamp)
+    {
+        const AudioJitterPacket *packet = nullptr;
+        AudioJitterAction action = buffer.Pop(packet, 0);
+        timestamp = packet != nullptr ? packet->timestamp : UINT32_MAX;
+        return action;
+    }
+};
+
+// Packets arriving out of order play in timestamp order
+TEST_F(JitterBufferTest, ReordersPackets)
+{
+    Push(0);
+    Push(120);
+    Push(60);
+    uint32_t timestamp = 0;
+    for (uint32_t expected : {0u, 60u, 120u})
+    {
+        EXPECT_EQ(Pop(timestamp), AudioJitterDecode);
+        EXPECT_EQ(timestamp, expected);
+    }
+    EXPECT_EQ(buffer.GetStats().lost, 0u);
+}
+
+// A lost frame is rebuilt from the FEC of the next packet and counted once
+TEST_F(JitterBufferTest, RecoversLostFrameFromFec)
+{
+    Push(0);
+    Push(120);
+    Push(180);
+    uint32_t timestamp = 0;
+    EXPECT_EQ(Pop(timestamp), AudioJitterDecode);
+    EXPECT_EQ(Pop(timestamp), AudioJitterFec);
+    EXPECT_EQ(timestamp, 120u);
+    EXPECT_EQ(Pop(timestamp), AudioJitterDecode);
+    EXPECT_EQ(timestamp, 120u);
+    AudioJitterStats stats = buffer.GetStats();
+    EXPECT_EQ(stats.lost, 1u);
+    EXPECT_EQ(stats.recovered, 1u);
+    EXPECT_EQ(stats.concealed, 0u);
+}
+
+// A lost frame without a following packet is concealed
+TEST_F(JitterBufferTest, ConcealsLostFrameWithoutFec)
+{
+    Push(0);
+    Push(180);
+    uint32_t timestamp = 0;
+    EXPECT_EQ(Pop(timestamp), AudioJitterDecode);
+    EXPECT_EQ(Pop(timestamp), AudioJitterConceal);
+    EXPECT_EQ(Pop(timestamp), AudioJitterFec);
+    EXPECT_EQ(Pop(timestamp), AudioJitterDecode);
+    EXPECT_EQ(timestamp, 180u);
+    AudioJitterStats stats = buffer.GetStats();
+    EXPECT_EQ(stats.lost, 2u);
+    EXPECT_EQ(stats.recovered, 1u);
+    EXPECT_EQ(stats.concealed, 1u);
+}
+
+// Timestamps near the frame grid are snapped onto it, others are rejected
+TEST_F(JitterBufferTest, AlignsTimestampsToFrameGrid)
+{
+    Push(1000);
+    Push(1061);
+    Push(1119);
+    Push(1150);
+    uint32_t timestamp = 0;
+    for (uint32_t expected : {1000u, 1060u, 1120u})
+    {
+        EXPECT_EQ(Pop(timestamp), AudioJitterDecode);
+        EXPECT_EQ(timestamp, expected);
+    }
+    EXPECT_EQ(buffer.GetStats().rejected, 1u);
+}
+
+// Packets whose duration differs from the talkspurt are rejected
+TEST_F(JitterBufferTest, RejectsDurationChangeWithinTalkspurt)
+{
+    Push(0);
+    Push(60, 20);
+    Push(60);
+    EXPECT_EQ(buffer.GetStats().rejected, 1u);
+    uint32_t timestamp = 0;
+    EXPECT_EQ(Pop(timestamp), AudioJitterDecode);
+    EXPECT_EQ(Pop(timestamp), AudioJitterDecode);
+    EXPECT_EQ(timestamp, 60u);
+    EXPECT_EQ(buffer.FrameDuration(), TEST_FRAME_MS);
+}
+
+// A new duration is taken at the start of the next talkspurt
+TEST_F(JitterBufferTest, AcceptsDurationChangeAfterReset)
+{
+    Push(0);
+    buffer.RequestReset();
+    Push(1000, 20);
+    Push(1020, 20);
+    uint32_t timestamp = 0;
+    EXPECT_EQ(Pop(timestamp), AudioJitterDecode);
+    EXPECT_EQ(timestamp, 1000u);
+    EXPECT_EQ(buffer.FrameDuration(), 20);
+    EXPECT_EQ(buffer.GetStats().rejected, 0u);
+}
+
+// A packet behind the playout point is dropped as late
+TEST_F(JitterBufferTest, DropsLatePackets)
+{
+    Push(0);
+    Push(60);
+    uint32_t timestamp = 0;
+    EXPECT_EQ(Pop(timestamp), AudioJitterDecode);
+    EXPECT_EQ(Pop(timestamp), AudioJitterDecode);
+    Push(0);
+    EXPECT_EQ(buffer.GetStats().late, 1u);
+    EXPECT_EQ(buffer.GetStats().depth, 0);
+}
\ No newline at end of file
@@ -0,0 +1,134 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// Include standard headers
+#include <vector>
+#include <cstdint>
+
+// Include test headers
+#include <gtest/gtest.h>
+
+// Include headers
+#include "mixer_basic.h"
+
+// Define mixer format of the tests: 10 ms segments at 16 kHz
+#define TEST_SAMPLE_RATE 16000
+#define TEST_SEGMENT 160
+
+// Mixer with a low priority stream and a high priority prompt
+class AudioMixerTest : public ::testing::Test
+{
+protected:
+    AudioMixer mixer;
+    int stream = -1;
+    int prompt = -1;
+
+    void SetUp() override
+    {
+        mixer.Configure(TEST_SAMPLE_RATE, TEST_SEGMENT);
+        stream = mixer.AddSource(0);
+        prompt = mixer.AddSource(1);
+    }
+
+    // Mix one segment of constant levels, a zero level leaves the source out
+    std::vector<int16_t> Mix(int16_t stream_level, int16_t prompt_level)
+    {
+        uint32_t active = (stream_level != 0 ? 1u << stream : 0) | (prompt_level != 0 ? 1u << prompt : 0);
+        mixer.Begin(TEST_SEGMENT, active);
+        std::vector<int16_t> pcm(TEST_SEGMENT);
+        if (stream_level != 0)
+        {
+            pcm.assign(TEST_SEGMENT, stream_level);
+            mixer.Add(stream, pcm.data(), 0, pcm.size());
+        }
+        if (prompt_level != 0)
+        {
+            pcm.assign(TEST_SEGMENT, prompt_level);
+            mixer.Add(prompt, pcm.data(), 0, pcm.size());
+        }
+        const int16_t *out = mixer.End();
+        return std::vector<int16_t>(out, out + TEST_SEGMENT);
+    }
+};
+
+// Sources summing past full scale saturate instead of wrapping, and count
+TEST_F(AudioMixerTest, SaturatesAndCountsClipping)
+{
+    std::vector<int16_t> high = Mix(30000, 30000);
+    for (int16_t sample : high)
+    {
+        ASSERT_EQ(sample, INT16_MAX);
+    }
+
+    // Without a duck gain the stream keeps its level, so every sample clipped
+    EXPECT_EQ(mixer.GetStats(stream).clipped, static_cast<uint32_t>(TEST_SEGMENT));
+
+    // Negative full scale clamps to the 16 bit minimum
+    std::vector<int16_t> low = Mix(-30000, -30000);
+    EXPECT_EQ(low.front(), INT16_MIN);
+    EXPECT_GT(mixer.GetStats(stream).clipped, static_cast<uint32_t>(TEST_SEGMENT));
+}
+
+// A sum within range passes unchanged and counts nothing
+TEST_F(AudioMixerTest, MixesWithinRangeWithoutClipping)
+{
+    std::vector<int16_t> out = Mix(1000, 0);
+    for (int16_t sample : out)
+    {
+        ASSERT_EQ(sample, 1000);
+    }
+    AudioMixerStats stats = mixer.GetStats(stream);
+    EXPECT_EQ(stats.clipped, 0u);
+    EXPECT_EQ(stats.samples, static_cast<uint64_t>(TEST_SEGMENT));
+    EXPECT_EQ(stats.gain_percent, 100);
+    EXPECT_FALSE(stats.ducked);
+}
+
+// A playing prompt ramps the stream down to the duck gain and back up
+TEST_F(AudioMixerTest, DucksStreamUnderPrompt)
+{
+    mixer.SetDuckGain(0.25f);
+    Mix(8000, 0);
+
+    // Within one ramp the stream settles at a quarter of its level
+    for (int i = 0; i < AUDIO_MIXER_RAMP_MS * TEST_SAMPLE_RATE / 1000 / TEST_SEGMENT + 1; ++i)
+    {
+        Mix(8000, 100);
+    }
+    std::vector<int16_t> ducked = Mix(8000, 100);
+    EXPECT_EQ(ducked.back(), 8000 / 4 + 100);
+    AudioMixerStats stats = mixer.GetStats(stream);
+    EXPECT_TRUE(stats.ducked);
+    EXPECT_EQ(stats.gain_percent, 25);
+
+    // Without the prompt the stream ramps back to unity
+    for (int i = 0; i < AUDIO_MIXER_RAMP_MS * TEST_SAMPLE_RATE / 1000 / TEST_SEGMENT + 1; ++i)
+    {
+        Mix(8000, 0);
+    }
+    EXPECT_EQ(Mix(8000, 0).back(), 8000);
+    EXPECT_FALSE(mixer.GetStats(stream).ducked);
+}
+
+// Underruns are counted per source, unknown sources report nothing
+TEST_F(AudioMixerTest, CountsUnderrunsPerSource)
+{
+    mixer.Underrun(prompt);
+    mixer.Underrun(prompt);
+    EXPECT_EQ(mixer.GetStats(prompt).underruns, 2u);
+    EXPECT_EQ(mixer.GetStats(stream).underruns, 0u);
+    EXPECT_EQ(mixer.GetStats(-1).samples, 0u);
+}
\ No newline at end of file
@@ -0,0 +1,142 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// Include standard headers
+#include <vector>
+#include <cstdint>
+
+// Include test headers
+#include <gtest/gtest.h>
+
+// Include headers
+#include "reference_basic.h"
+
+// Define timeline of the tests: playback in 10 ms segments, mic in 32 ms chunks
+#define TEST_SAMPLE_RATE 16000
+#define TEST_SEGMENT 160
+#define TEST_CHUNK 512
+#define TEST_START_US 1000000LL
+
+// Reference fed with played noise, read back against mic chunks that carry
+// the same noise after an echo delay
+class AudioReferenceTest : public ::testing::Test
+{
+protected:
+    AudioReference reference;
+    std::vector<int16_t> played;
+    std::vector<int16_t> mic;
+    std::vector<int16_t> aligned;
+
+    void SetUp() override
+    {
+        reference.Initialize(TEST_SAMPLE_RATE);
+        mic.resize(TEST_CHUNK);
+        aligned.resize(TEST_CHUNK);
+    }
+
+    // Play noise in segments until the timeline reaches a point in time
+    void PlayUntil(int64_t until_us)
+    {
+        uint32_t seed = static_cast<uint32_t>(played.size()) * 2654435761u + 1;
+        while (TEST_START_US + static_cast<int64_t>(played.size()) * 1000000 / TEST_SAMPLE_RATE < until_us)
+        {
+            int64_t play_us = TEST_START_US + static_cast<int64_t>(played.size()) * 1000000 / TEST_SAMPLE_RATE;
+            size_t start = played.size();
+            for (int i = 0; i < TEST_SEGMENT; ++i)
+            {
+                seed = seed * 1664525u + 1013904223u;
+                played.push_back(static_cast<int16_t>(static_cast<int32_t>(seed >> 16) - 32768) / 2);
+            }
+            reference.Write(played.data() + start, TEST_SEGMENT, play_us);
+        }
+    }
+
+    // Capture a mic chunk at capture_us holding the echo of what played delay_ms before
+    void Capture(int64_t capture_us, int delay_ms)
+    {
+        int64_t first = (capture_us - TEST_START_US) * TEST_SAMPLE_RATE / 1000000 - TEST_SAMPLE_RATE / 1000 * delay_ms;
+        for (int i = 0; i < TEST_CHUNK; ++i)
+        {
+            int64_t index = first + i;
+            mic[i] = index >= 0 && index < static_cast<int64_t>(played.size()) ? played[index] / 2 : 0;
+        }
+    }
+
+    // Estimate on consecutive chunks from a point in time, returns the time after them
+    int64_t Estimate(int64_t capture_us, int delay_ms, int chunks)
+    {
+        for (int chunk = 0; chunk < chunks; ++chunk)
+        {
+            PlayUntil(capture_us + 200000);
+            Capture(capture_us, delay_ms);
+            reference.EstimateDelay(mic.data(), mic.size(), capture_us);
+            capture_us += TEST_CHUNK * 1000000LL / TEST_SAMPLE_RATE;
+        }
+        return capture_us;
+    }
+};
+
+// An echo path longer than the old 80 ms search window is found
+TEST_F(AudioReferenceTest, EstimatesLongEchoDelay)
+{
+    Estimate(TEST_START_US + 300000, 120, AUDIO_REFERENCE_AGREEING_ESTIMATES);
+    AudioReferenceStats stats = reference.GetStats();
+    EXPECT_EQ(stats.delay_ms, 120);
+    EXPECT_EQ(stats.estimates, 1u);
+}
+
+// After the echo path changes the estimate follows once chunks agree again
+TEST_F(AudioReferenceTest, RecoversAfterDelayChange)
+{
+    int64_t capture_us = Estimate(TEST_START_US + 300000, 40, AUDIO_REFERENCE_AGREEING_ESTIMATES);
+    ASSERT_EQ(reference.GetStats().delay_ms, 40);
+
+    // One disagreeing chunk is not enough to move the estimate
+    capture_us = Estimate(capture_us, 100, 1);
+    EXPECT_EQ(reference.GetStats().delay_ms, 40);
+    Estimate(capture_us, 100, AUDIO_REFERENCE_AGREEING_ESTIMATES - 1);
+    EXPECT_EQ(reference.GetStats().delay_ms, 100);
+    EXPECT_EQ(reference.GetStats().estimates, 2u);
+}
+
+// Once estimated, the reference read for a mic chunk is what played one echo delay earlier
+TEST_F(AudioReferenceTest, ReadsAlignedReference)
+{
+    int64_t capture_us = Estimate(TEST_START_US + 300000, 60, AUDIO_REFERENCE_AGREEING_ESTIMATES);
+    PlayUntil(capture_us + 200000);
+    reference.Read(aligned.data(), aligned.size(), capture_us);
+    int64_t first = (capture_us - TEST_START_US) * TEST_SAMPLE_RATE / 1000000 - TEST_SAMPLE_RATE / 1000 * (60 - AUDIO_REFERENCE_LEAD_MS);
+    for (int i = 0; i < TEST_CHUNK; ++i)
+    {
+        ASSERT_EQ(aligned[i], played[first + i]) << "sample " << i;
+    }
+}
+
+// A pause in playback is padded with silence and counted
+TEST_F(AudioReferenceTest, PadsPlaybackGaps)
+{
+    std::vector<int16_t> tone(TEST_SEGMENT, 1000);
+    reference.Write(tone.data(), tone.size(), TEST_START_US);
+    reference.Write(tone.data(), tone.size(), TEST_START_US + 50000);
+    EXPECT_EQ(reference.GetStats().gaps, 1u);
+
+    // Reading across the pause returns the tone, the silence, then the tone again
+    std::vector<int16_t> out(TEST_SAMPLE_RATE / 1000 * 60);
+    reference.Read(out.data(), out.size(), TEST_START_US - AUDIO_REFERENCE_LEAD_MS * 1000);
+    EXPECT_EQ(out[0], 1000);
+    EXPECT_EQ(out[TEST_SAMPLE_RATE / 1000 * 30], 0);
+    EXPECT_EQ(out[TEST_SAMPLE_RATE / 1000 * 55], 1000);
+}
\ No newline at end of file
@@ -0,0 +1,133 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// Include standard headers
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <cstdint>
+
+// Include test headers
+#include <gtest/gtest.h>
+
+// Include headers
+#include "resampler_basic.h"
+#include "dsps_dotprod.h"
+
+// Declare the resampler built for the ESP32-S3 under its own name, the
+// build compiles that copy against the host esp-dsp dot product
+#undef RESAMPLER_BASIC_H
+#undef RESAMPLER_SIMD
+#define ResamplerBasic ResamplerBasicSimd
+#include "resampler_basic.h"
+#undef ResamplerBasic
+
+// Define test input length and the odd block size it is fed in
+#define TEST_INPUT_MS 200
+#define TEST_BLOCK_FRAMES 77
+
+// Noise near full scale over a loud tone, so sums round both ways and
+// filter overshoot reaches the saturation limits
+static std::vector<int16_t> TestSignal(int sample_rate, int channels)
+{
+    std::mt19937 random(sample_rate + channels);
+    std::uniform_int_distribution<int> noise(-12000, 12000);
+    int frames = sample_rate * TEST_INPUT_MS / 1000;
+    std::vector<int16_t> signal(static_cast<size_t>(frames) * channels);
+    for (int i = 0; i < frames; ++i)
+    {
+        for (int c = 0; c < channels; ++c)
+        {
+            int value = ((i / (8 + c)) % 2 ? 24000 : -24000) + noise(random);
+            signal[static_cast<size_t>(i) * channels + c] = static_cast<int16_t>(std::clamp(value, INT16_MIN, INT16_MAX));
+        }
+    }
+    return signal;
+}
+
+// Resample a signal in odd sized blocks
+template <typename Resampler>
+static std::vector<int16_t> Resample(Resampler &resampler, const std::vector<int16_t> &signal)
+{
+    std::vector<int16_t> result;
+    int block = TEST_BLOCK_FRAMES * resampler.Channels();
+    for (size_t offset = 0; offset < signal.size(); offset += block)
+    {
+        int samples = static_cast<int>(std::min(signal.size() - offset, static_cast<size_t>(block)));
+        std::vector<int16_t> output(resampler.GetOutputSamples(samples));
+        int written = resampler.Process(signal.data() + offset, samples, output.data());
+        EXPECT_EQ(written, static_cast<int>(output.size()));
+        result.insert(result.end(), output.begin(), output.begin() + written);
+    }
+    return result;
+}
+
+// Rates and channels of one equivalence case
+struct ResamplerCase
+{
+    int input_sample_rate;
+    int output_sample_rate;
+    int channels;
+};
+
+class ResamplerEquivalenceTest : public ::testing::TestWithParam<ResamplerCase>
+{
+};
+
+// The esp-dsp path writes exactly what the scalar path writes
+TEST_P(ResamplerEquivalenceTest, SimdMatchesScalar)
+{
+    const ResamplerCase &param = GetParam();
+    ResamplerBasic scalar;
+    ResamplerBasicSimd simd;
+    scalar.Configure(param.input_sample_rate, param.output_sample_rate, param.channels);
+    simd.Configure(param.input_sample_rate, param.output_sample_rate, param.channels);
+    std::vector<int16_t> signal = TestSignal(param.input_sample_rate, param.channels);
+
+    uint64_t calls = HostDspDotprodCalls();
+    std::vector<int16_t> expected = Resample(scalar, signal);
+    EXPECT_EQ(HostDspDotprodCalls(), calls);
+    std::vector<int16_t> actual = Resample(simd, signal);
+    EXPECT_GT(HostDspDotprodCalls(), calls);
+
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+        ASSERT_EQ(actual[i], expected[i]) << "sample " << i;
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Rates, ResamplerEquivalenceTest,
+                         ::testing::Values(ResamplerCase{48000, 16000, 1},
+                                           ResamplerCase{16000, 48000, 1},
+                                           ResamplerCase{44100, 16000, 1},
+                                           ResamplerCase{24000, 16000, 2},
+                                           ResamplerCase{48000, 16000, 4}));
+
+// A constant level passes at unity gain once the window fills, within the
+// rounding of the Q14 coefficients
+TEST(ResamplerBasicTest, KeepsDcLevel)
+{
+    ResamplerBasic resampler;
+    resampler.Configure(48000, 16000);
+    std::vector<int16_t> signal(48000 * TEST_INPUT_MS / 1000, 10000);
+    std::vector<int16_t> output = Resample(resampler, signal);
+    ASSERT_GT(output.size(), static_cast<size_t>(RESAMPLER_MAX_TAPS));
+    for (size_t i = RESAMPLER_MAX_TAPS; i < output.size(); ++i)
+    {
+        ASSERT_NEAR(output[i], 10000, 10) << "sample " << i;
+    }
+}
\ No newline at end of file
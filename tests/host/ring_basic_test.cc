@@ -0,0 +1,305 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// Include standard headers
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <vector>
+#include <atomic>
+#include <cstdio>
+#include <condition_variable>
+
+// Include test headers
+#include <gtest/gtest.h>
+
+// Include host support
+#include "host_alloc.h"
+
+// Include headers
+#include "ring_basic.h"
+
+// Define frame size of the benchmark, 60 ms at 16 kHz
+#define TEST_FRAME_SAMPLES 960
+
+// Define frames passed through the benchmark
+#define TEST_BENCH_FRAMES 2000
+
+// Push a value through the producer side
+static bool Push(AudioRing<int> &ring, int value)
+{
+    int *slot = ring.Acquire();
+    if (slot == nullptr)
+    {
+        return false;
+    }
+    *slot = value;
+    ring.Commit();
+    return true;
+}
+
+// Pop a value through the consumer side, -1 if empty
+static int Pop(AudioRing<int> &ring)
+{
+    int *slot = ring.Front();
+    if (slot == nullptr)
+    {
+        return -1;
+    }
+    int value = *slot;
+    ring.Release();
+    return value;
+}
+
+// Positions wrap around the slots in order and reuse the same storage
+TEST(AudioRing, WrapsAroundInOrder)
+{
+    AudioRing<int> ring;
+    ring.Allocate(4);
+    std::vector<int *> slots;
+    for (int i = 0; i < 10; ++i)
+    {
+        slots.push_back(ring.Acquire());
+        ASSERT_TRUE(Push(ring, i));
+        ASSERT_TRUE(Push(ring, 100 + i));
+        EXPECT_EQ(Pop(ring), i);
+        EXPECT_EQ(Pop(ring), 100 + i);
+    }
+    EXPECT_TRUE(ring.Empty());
+    for (size_t i = 2; i < slots.size(); ++i)
+    {
+        EXPECT_EQ(slots[i], slots[i - 2]);
+    }
+}
+
+// Acquire refuses a full ring and Size tracks occupancy
+TEST(AudioRing, ReportsFullAndEmpty)
+{
+    AudioRing<int> ring;
+    ring.Allocate(3);
+    EXPECT_TRUE(ring.Empty());
+    EXPECT_EQ(Pop(ring), -1);
+    for (int i = 0; i < 3; ++i)
+    {
+        EXPECT_EQ(ring.Size(), static_cast<size_t>(i));
+        ASSERT_TRUE(Push(ring, i));
+    }
+    EXPECT_TRUE(ring.Full());
+    EXPECT_EQ(ring.Acquire(), nullptr);
+    EXPECT_EQ(Pop(ring), 0);
+    EXPECT_FALSE(ring.Full());
+    EXPECT_EQ(ring.Size(), 2u);
+}
+
+// A requested clear keeps the slots occupied until the consumer applies it
+TEST(AudioRing, ClearAppliesOnFront)
+{
+    AudioRing<int> ring;
+    ring.Allocate(2);
+    ASSERT_TRUE(Push(ring, 1));
+    ASSERT_TRUE(Push(ring, 2));
+    ring.RequestClear();
+    EXPECT_TRUE(ring.ClearPending());
+    EXPECT_EQ(ring.Size(), 2u);
+    EXPECT_TRUE(ring.Full());
+    EXPECT_EQ(ring.Acquire(), nullptr);
+    EXPECT_EQ(ring.Front(), nullptr);
+    EXPECT_FALSE(ring.ClearPending());
+    EXPECT_TRUE(ring.Empty());
+    ASSERT_TRUE(Push(ring, 3));
+    EXPECT_EQ(Pop(ring), 3);
+}
+
+// Applying a clear wakes a producer blocked on a full ring
+TEST(AudioRing, ClearWakesSpaceWaiter)
+{
+    AudioRing<int> ring;
+    ring.Allocate(1);
+    ASSERT_TRUE(Push(ring, 1));
+    std::atomic<bool> woke{false};
+    std::thread producer([&]()
+                         { woke = ring.WaitForSpace(pdMS_TO_TICKS(2000)); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    ring.RequestClear();
+    EXPECT_EQ(ring.Front(), nullptr);
+    producer.join();
+    EXPECT_TRUE(woke);
+}
+
+// A space wait leaves the consumer notification of another ring pending
+TEST(AudioRing, SpaceWaitKeepsConsumerNotification)
+{
+    AudioRing<int> input;
+    AudioRing<int> output;
+    input.Allocate(2);
+    output.Allocate(1);
+    input.SetConsumer(xTaskGetCurrentTaskHandle());
+    ASSERT_TRUE(Push(input, 7));
+    ASSERT_TRUE(Push(output, 1));
+
+    // Free the output slot later from its consumer
+    std::thread consumer([&]()
+                         {
+                             std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                             EXPECT_EQ(Pop(output), 1); });
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_TRUE(output.WaitForSpace(pdMS_TO_TICKS(2000)));
+    auto waited = std::chrono::steady_clock::now() - start;
+    consumer.join();
+    EXPECT_GE(waited, std::chrono::milliseconds(15));
+    EXPECT_EQ(ulTaskNotifyTake(pdTRUE, 0), 1u);
+    EXPECT_EQ(Pop(input), 7);
+}
+
+// A space wait gives up at its timeout
+TEST(AudioRing, SpaceWaitTimesOut)
+{
+    AudioRing<int> ring;
+    ring.Allocate(1);
+    ASSERT_TRUE(Push(ring, 1));
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(ring.WaitForSpace(pdMS_TO_TICKS(30)));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(30));
+}
+
+// Frame queue in the style the ring replaced: a deque of owned frames behind a mutex
+class DequeQueue
+{
+private:
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<std::vector<int16_t>> frames;
+    size_t capacity;
+
+public:
+    uint64_t wakeups = 0;
+
+    explicit DequeQueue(size_t capacity_) : capacity(capacity_) {}
+
+    void Push(const int16_t *data, size_t samples)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [this]()
+                { return frames.size() < capacity; });
+        frames.emplace_back(data, data + samples);
+        wakeups++;
+        cv.notify_all();
+    }
+
+    std::vector<int16_t> Pop()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [this]()
+                { return !frames.empty(); });
+        std::vector<int16_t> frame = std::move(frames.front());
+        frames.pop_front();
+        wakeups++;
+        cv.notify_all();
+        return frame;
+    }
+};
+
+// Steady state passes frames without allocating and about one wakeup per frame
+TEST(AudioRingBenchmark, SteadyStateAllocationsAndWakeups)
+{
+    std::vector<int16_t> source(TEST_FRAME_SAMPLES, 1);
+
+    // Ring: slots sized once, producer and consumer as separate tasks
+    AudioRing<std::vector<int16_t>> ring;
+    ring.Allocate(8, [](std::vector<int16_t> &slot)
+                  { slot.reserve(TEST_FRAME_SAMPLES); });
+    std::atomic<bool> go{false};
+    std::atomic<int> ready{0};
+    std::atomic<int64_t> checksum{0};
+    std::thread consumer([&]()
+                         {
+                             ring.SetConsumer(xTaskGetCurrentTaskHandle());
+                             ready++;
+                             while (!go) { std::this_thread::yield(); }
+                             int64_t sum = 0;
+                             for (int received = 0; received < TEST_BENCH_FRAMES;)
+                             {
+                                 std::vector<int16_t> *frame = ring.Front();
+                                 if (frame == nullptr)
+                                 {
+                                     ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(100));
+                                     continue;
+                                 }
+                                 sum += frame->size();
+                                 ring.Release();
+                                 received++;
+                             }
+                             checksum = sum; });
+    std::thread producer([&]()
+                         {
+                             xTaskGetCurrentTaskHandle();
+                             ready++;
+                             while (!go) { std::this_thread::yield(); }
+                             for (int sent = 0; sent < TEST_BENCH_FRAMES;)
+                             {
+                                 std::vector<int16_t> *slot = ring.Acquire();
+                                 if (slot == nullptr)
+                                 {
+                                     ring.WaitForSpace(pdMS_TO_TICKS(100));
+                                     continue;
+                                 }
+                                 slot->assign(source.begin(), source.end());
+                                 ring.Commit();
+                                 sent++;
+                             } });
+    while (ready < 2)
+    {
+        std::this_thread::yield();
+    }
+    uint64_t allocs = HostAllocCount();
+    uint64_t gives = HostNotifyGiveCount();
+    go = true;
+    while (checksum == 0)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    uint64_t ring_allocs = HostAllocCount() - allocs;
+    double ring_wakeups = static_cast<double>(HostNotifyGiveCount() - gives) / TEST_BENCH_FRAMES;
+    producer.join();
+    consumer.join();
+    EXPECT_EQ(checksum, static_cast<int64_t>(TEST_BENCH_FRAMES) * TEST_FRAME_SAMPLES);
+
+    // Baseline: the deque queue copies every frame into a new vector
+    DequeQueue queue(8);
+    allocs = HostAllocCount();
+    std::thread baseline([&]()
+                         {
+                             for (int i = 0; i < TEST_BENCH_FRAMES; ++i)
+                             {
+                                 queue.Push(source.data(), source.size());
+                             } });
+    for (int i = 0; i < TEST_BENCH_FRAMES; ++i)
+    {
+        queue.Pop();
+    }
+    baseline.join();
+    uint64_t deque_allocs = HostAllocCount() - allocs;
+    double deque_wakeups = static_cast<double>(queue.wakeups) / TEST_BENCH_FRAMES;
+
+    std::printf("ring: %llu allocations, %.2f wakeups per frame\n", (unsigned long long)ring_allocs, ring_wakeups);
+    std::printf("deque: %llu allocations, %.2f wakeups per frame\n", (unsigned long long)deque_allocs, deque_wakeups);
+    RecordProperty("ring_allocations", static_cast<int>(ring_allocs));
+    RecordProperty("deque_allocations", static_cast<int>(deque_allocs));
+    EXPECT_EQ(ring_allocs, 0u);
+    EXPECT_GE(deque_allocs, static_cast<uint64_t>(TEST_BENCH_FRAMES));
+    EXPECT_LE(ring_wakeups, 2.0);
+}
\ No newline at end of file
@@ -0,0 +1,452 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// Include standard headers
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstdint>
+#include <ctime>
+
+// Include test headers
+#include <gtest/gtest.h>
+
+// Include headers
+#include "service_basic.h"
+#include "fake_codec.h"
+#include "host_alloc.h"
+
+// Define downlink packets of the benchmark, and the time one frame holds the decoder
+#define TEST_DOWNLINK_FRAME_MS 60
+#define TEST_DECODE_COST_US 50000
+#define TEST_ENCODE_COST_US 5000
+#define TEST_BENCH_MS 3000
+
+// Define the AFE feed chunk and the chunks measured after warming up
+#define TEST_FEED_SAMPLES 512
+#define TEST_FEED_WARMUP 4
+#define TEST_FEED_CHUNKS 32
+
+// Define downlink packets streamed before and while allocations are counted
+#define TEST_DOWNLINK_WARMUP 10
+#define TEST_DOWNLINK_PACKETS 30
+
+// Define uplink audio drained per setting
+#define TEST_UPLINK_MS 1000
+
+// Encode one downlink packet with the host codec
+static std::vector<uint8_t> DownlinkPacket(int16_t level, int bitrate = 24000)
+{
+    std::vector<int16_t> pcm(16000 / 1000 * TEST_DOWNLINK_FRAME_MS, level);
+    std::vector<uint8_t> packet(1500);
+    OpusEncoder *encoder = opus_encoder_create(16000, 1, OPUS_APPLICATION_VOIP, nullptr);
+    opus_encoder_ctl(encoder, OPUS_SET_BITRATE(bitrate));
+    packet.resize(opus_encode(encoder, pcm.data(), pcm.size(), packet.data(), packet.size()));
+    opus_encoder_destroy(encoder);
+    return packet;
+}
+
+// Get CPU time spent by the calling thread
+static int64_t ThreadCpuUs()
+{
+    timespec now = {};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return static_cast<int64_t>(now.tv_sec) * 1000000 + now.tv_nsec / 1000;
+}
+
+// Capture at a codec rate and channel count, then read feed chunks through
+// ReadAudioData: past the first reads no chunk allocates, resampled or not
+static void BenchReadAudioData(int input_rate, int channels)
+{
+    FakeCodec codec(input_rate, 16000, channels);
+    codec.SetInput([](uint64_t index)
+                   { return static_cast<int16_t>((index / 8) % 2 ? 1000 : -1000); });
+    AudioService service;
+    service.Initialize(&codec);
+
+    // Let the first reads power up the codec and size the buffers
+    std::vector<int16_t> data;
+    for (int i = 0; i < TEST_FEED_WARMUP; ++i)
+    {
+        ASSERT_TRUE(service.ReadAudioData(data, 16000, TEST_FEED_SAMPLES));
+    }
+
+    // Count allocations and the CPU time of the reading thread, not the paced wait
+    uint64_t allocations = HostAllocCount();
+    int64_t cpu_us = ThreadCpuUs();
+    for (int i = 0; i < TEST_FEED_CHUNKS; ++i)
+    {
+        ASSERT_TRUE(service.ReadAudioData(data, 16000, TEST_FEED_SAMPLES));
+    }
+    cpu_us = ThreadCpuUs() - cpu_us;
+    allocations = HostAllocCount() - allocations;
+    std::printf("read %d Hz x%d: %.1f us and %.2f allocations per feed chunk\n",
+                input_rate, channels, static_cast<double>(cpu_us) / TEST_FEED_CHUNKS, static_cast<double>(allocations) / TEST_FEED_CHUNKS);
+    testing::Test::RecordProperty("read_us_" + std::to_string(input_rate) + "x" + std::to_string(channels), static_cast<int>(cpu_us / TEST_FEED_CHUNKS));
+
+    // Every chunk came out at 16 kHz with its channels interleaved
+    EXPECT_EQ(data.size(), static_cast<size_t>(TEST_FEED_SAMPLES * channels));
+    EXPECT_EQ(allocations, 0u);
+}
+
+// Check a stats line is one complete JSON object: formatted without truncation
+static void ExpectJsonObject(const std::string &json)
+{
+    ASSERT_FALSE(json.empty());
+    EXPECT_EQ(json.front(), '{');
+    EXPECT_EQ(json.back(), '}');
+    int depth = 0;
+    for (char c : json)
+    {
+        depth += c == '{' ? 1 : c == '}' ? -1 : 0;
+        ASSERT_GE(depth, 0);
+    }
+    EXPECT_EQ(depth, 0);
+}
+
+// The health log reads stats at any time, also before the service has a codec
+TEST(AudioServiceStatsTest, ReportsBeforeAndAfterInitialize)
+{
+    AudioService service;
+    AudioServiceStats stats = service.GetStats();
+    EXPECT_EQ(stats.frames_encoded, 0u);
+    EXPECT_EQ(stats.output_underruns, 0u);
+    EXPECT_EQ(stats.processor.fetch_cycles, 0u);
+    ExpectJsonObject(service.GetStatsJson());
+
+    // Once initialized every section comes from the live pipeline
+    FakeCodec codec(16000, 16000);
+    service.Initialize(&codec);
+    stats = service.GetStats();
+    EXPECT_GT(stats.bitrate, 0);
+    EXPECT_GT(stats.packet_ms, 0);
+    std::string json = service.GetStatsJson();
+    ExpectJsonObject(json);
+    EXPECT_NE(json.find("\"bitrate\":" + std::to_string(stats.bitrate)), std::string::npos);
+    EXPECT_NE(json.find("\"heap\":{"), std::string::npos);
+}
+
+// Wait until the input power state settles or the timeout passes
+static bool WaitInputPowerState(AudioService &service, AudioPowerState state, int timeout_ms)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    while (service.GetInputPowerState() != state)
+    {
+        if (std::chrono::steady_clock::now() > deadline)
+        {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return true;
+}
+
+// Re-enabling voice processing on a primed codec does not prime it again
+TEST(AudioServicePowerTest, ReenableKeepsPrimedInput)
+{
+    // The AFE task never returns, so the service and its codec outlive the test
+    FakeCodec &codec = *new FakeCodec(16000, 16000);
+    codec.SetInput([](uint64_t index)
+                   { return static_cast<int16_t>((index / 8) % 2 ? 1000 : -1000); });
+    AudioService *service = new AudioService();
+    service->Initialize(&codec);
+    service->Start();
+    UtilsLatency::Instance().Reset();
+    service->EnableVoiceProcessing(true);
+    ASSERT_TRUE(WaitInputPowerState(*service, AudioPowerOn, 1000));
+    EXPECT_EQ(UtilsLatency::Instance().GetStats(UtilsLatencyPowerInput).count, 1u);
+
+    // Toggle the processor while the codec stays powered
+    service->EnableVoiceProcessing(false);
+    service->EnableVoiceProcessing(true);
+    EXPECT_EQ(service->GetInputPowerState(), AudioPowerOn);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_EQ(UtilsLatency::Instance().GetStats(UtilsLatencyPowerInput).count, 1u);
+    service->EnableVoiceProcessing(false);
+    service->Stop();
+}
+
+// Reads at the AFE rate copy straight into the feed buffer
+TEST(AudioServiceBenchmark, ReadAudioDataDirect)
+{
+    BenchReadAudioData(16000, 1);
+}
+
+// Reads at the codec rate go through the persistent capture buffer and resampler
+TEST(AudioServiceBenchmark, ReadAudioDataResampled)
+{
+    BenchReadAudioData(48000, 2);
+}
+
+// Received packets are copied into pooled slots once and decoded in place:
+// past warm-up the downlink from push to playback never allocates
+TEST(AudioServiceBenchmark, DownlinkAllocations)
+{
+    // The AFE task never returns, so the service and its codec outlive the test
+    FakeCodec &codec = *new FakeCodec(16000, 16000);
+    AudioService *service = new AudioService();
+    service->Initialize(&codec);
+    service->Start();
+
+    // Stream packets that fit the slot reserve in real time, counting allocations after warm-up
+    std::vector<uint8_t> packet = DownlinkPacket(2000, 16000);
+    ASSERT_LE(packet.size(), static_cast<size_t>(AUDIO_SERVICE_PACKET_RESERVE));
+    uint64_t allocations = 0;
+    uint32_t decoded = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < TEST_DOWNLINK_WARMUP + TEST_DOWNLINK_PACKETS; ++i)
+    {
+        if (i == TEST_DOWNLINK_WARMUP)
+        {
+            allocations = HostAllocCount();
+            decoded = service->GetStats().frames_decoded;
+        }
+        service->PushPacketToDecodeQueue(packet.data(), packet.size(), 16000, TEST_DOWNLINK_FRAME_MS, i * TEST_DOWNLINK_FRAME_MS, true);
+        std::this_thread::sleep_until(start + std::chrono::milliseconds((i + 1) * TEST_DOWNLINK_FRAME_MS));
+    }
+    allocations = HostAllocCount() - allocations;
+    decoded = service->GetStats().frames_decoded - decoded;
+    service->Stop();
+    std::printf("downlink: %lu frames decoded, %.2f allocations per packet\n",
+                (unsigned long)decoded, static_cast<double>(allocations) / TEST_DOWNLINK_PACKETS);
+
+    // Packets were decoded behind the jitter buffer depth, none allocated
+    EXPECT_GE(decoded, static_cast<uint32_t>(TEST_DOWNLINK_PACKETS * 3 / 4));
+    EXPECT_EQ(allocations, 0u);
+}
+
+// Uplink packets, their frames and the frames carrying FEC
+struct UplinkCount
+{
+    uint32_t packets = 0;
+    uint32_t frames = 0;
+    uint32_t fec_frames = 0;
+    uint32_t max_packet_frames = 0;
+};
+
+// Drain the uplink for a while, counting frames that carry FEC
+static UplinkCount DrainUplink(AudioService &service, int duration_ms)
+{
+    UplinkCount count;
+    AudioServiceStreamPacket packet;
+    auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(duration_ms);
+    while (std::chrono::steady_clock::now() < end)
+    {
+        while (service.PopPacketFromSendQueue(packet))
+        {
+            count.packets++;
+            int16_t level = 0;
+            int16_t fec_level = 0;
+            bool fec = false;
+            uint32_t frames = 0;
+            for (; HostOpusReadFrame(packet.payload.data(), packet.payload.size(), frames, &level, &fec, &fec_level); ++frames)
+            {
+                count.fec_frames += fec ? 1 : 0;
+            }
+            count.frames += frames;
+            count.max_packet_frames = std::max(count.max_packet_frames, frames);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return count;
+}
+
+// FEC is off until the application enables it, and follows the switch at runtime
+TEST(AudioServiceUplinkTest, FecFollowsApplicationSetting)
+{
+    // The AFE task never returns, so the service and its codec outlive the test
+    FakeCodec &codec = *new FakeCodec(16000, 16000);
+    codec.SetInput([](uint64_t index)
+                   { return static_cast<int16_t>((index / 8) % 2 ? 1000 : -1000); });
+    AudioService *service = new AudioService();
+    service->Initialize(&codec);
+    EXPECT_FALSE(service->GetStats().fec);
+    service->EnableUplinkFec(true);
+    service->Start();
+    service->EnableVoiceProcessing(true);
+
+    // With FEC on every frame after the first protects the one before it
+    UplinkCount on = DrainUplink(*service, TEST_UPLINK_MS);
+    EXPECT_TRUE(service->GetStats().fec);
+    ASSERT_GT(on.frames, 0u);
+    EXPECT_GE(on.fec_frames + 1, on.frames);
+
+    // Switched off, frames encoded from then on carry none
+    service->EnableUplinkFec(false);
+    DrainUplink(*service, 100);
+    UplinkCount off = DrainUplink(*service, TEST_UPLINK_MS);
+    service->EnableVoiceProcessing(false);
+    service->Stop();
+    ASSERT_GT(off.frames, 0u);
+    EXPECT_EQ(off.fec_frames, 0u);
+}
+
+// The application picks the voice processing profile and governor, the AFE switches its stages to match
+TEST(AudioServiceProcessorTest, ProfileFollowsApplicationSetting)
+{
+    // The AFE task never returns, so the service and its codec outlive the test
+    FakeCodec &codec = *new FakeCodec(16000, 16000);
+    AudioService *service = new AudioService();
+    service->Initialize(&codec);
+    service->SetProcessorProfile(AudioProcessorProfileLowPower);
+    service->EnableProcessorGovernor(false);
+    service->Start();
+    service->EnableVoiceProcessing(true);
+    DrainUplink(*service, 200);
+
+    // Low power runs without noise suppression
+    AudioServiceStats stats = service->GetStats();
+    EXPECT_EQ(stats.processor.profile, AudioProcessorProfileLowPower);
+    EXPECT_EQ(stats.processor.ceiling, AudioProcessorProfileLowPower);
+    EXPECT_FALSE(stats.processor.governor);
+    EXPECT_FALSE(HostAfeGetStages().ns);
+
+    // Balanced turns it on before the next fetch
+    service->SetProcessorProfile(AudioProcessorProfileBalanced);
+    DrainUplink(*service, 200);
+    service->EnableVoiceProcessing(false);
+    service->Stop();
+    EXPECT_EQ(service->GetStats().processor.profile, AudioProcessorProfileBalanced);
+    EXPECT_TRUE(HostAfeGetStages().ns);
+}
+
+// The application sets the uplink packet duration, rounded to whole frames within one Opus packet
+TEST(AudioServiceUplinkTest, PacketDurationFollowsApplicationSetting)
+{
+    // The AFE task never returns, so the service and its codec outlive the test
+    FakeCodec &codec = *new FakeCodec(16000, 16000);
+    codec.SetInput([](uint64_t index)
+                   { return static_cast<int16_t>((index / 8) % 2 ? 1000 : -1000); });
+    AudioService *service = new AudioService();
+    service->Initialize(&codec);
+    service->SetUplinkPacketDuration(70);
+    service->Start();
+    service->EnableVoiceProcessing(true);
+
+    // Packets join three 20 ms frames, a late frame only flushes a shorter one
+    UplinkCount count = DrainUplink(*service, TEST_UPLINK_MS);
+    EXPECT_EQ(service->GetStats().packet_ms, 60);
+    ASSERT_GT(count.packets, 0u);
+    EXPECT_EQ(count.max_packet_frames, 3u);
+    EXPECT_GE(count.frames * 10, count.packets * 3 * 9);
+
+    // Longer requests are capped at the longest packet Opus allows
+    service->SetUplinkPacketDuration(1000);
+    DrainUplink(*service, 300);
+    service->EnableVoiceProcessing(false);
+    service->Stop();
+    EXPECT_EQ(service->GetStats().packet_ms, AUDIO_UPLINK_MAX_PACKET_MS);
+}
+
+// A muted uplink skips the encoder and keeps the stream alive with one
+// DTX frame per DTX interval, counting what that saved
+TEST(AudioServiceUplinkTest, MutedUplinkSendsDtxCadence)
+{
+    HostOpusSetEncodeCost(TEST_ENCODE_COST_US);
+    // The AFE task never returns, so the service and its codec outlive the test
+    FakeCodec &codec = *new FakeCodec(16000, 16000);
+    codec.SetInput([](uint64_t index)
+                   { return static_cast<int16_t>((index / 8) % 2 ? 1000 : -1000); });
+    AudioService *service = new AudioService();
+    service->Initialize(&codec);
+    service->SetUplinkPacketDuration(OPUS_FRAME_DURATION_MS);
+    service->Start();
+    service->EnableVoiceProcessing(true);
+    DrainUplink(*service, 200);
+
+    // Mute, letting frames encoded before it drain
+    service->SetUplinkMuted(true);
+    DrainUplink(*service, 100);
+    AudioServiceStats before = service->GetStats();
+    uint64_t encoded = HostOpusGetCounters().encoded;
+    UplinkCount muted = DrainUplink(*service, TEST_UPLINK_MS);
+    AudioServiceStats after = service->GetStats();
+    encoded = HostOpusGetCounters().encoded - encoded;
+
+    // Only DTX frames went out, at the DTX cadence, and nothing was encoded
+    uint32_t frames_muted = after.frames_muted - before.frames_muted;
+    EXPECT_GE(frames_muted, static_cast<uint32_t>(TEST_UPLINK_MS / OPUS_FRAME_DURATION_MS * 3 / 4));
+    EXPECT_EQ(encoded, 0u);
+    EXPECT_NEAR(muted.packets, frames_muted / (AUDIO_UPLINK_DTX_INTERVAL_MS / OPUS_FRAME_DURATION_MS), 1);
+    EXPECT_EQ(muted.fec_frames, 0u);
+    EXPECT_GT(after.muted_bytes_saved, before.muted_bytes_saved);
+    EXPECT_GT(after.muted_encode_us_saved, before.muted_encode_us_saved);
+
+    // Unmuted, every frame is encoded and sent again
+    service->SetUplinkMuted(false);
+    DrainUplink(*service, 100);
+    UplinkCount unmuted = DrainUplink(*service, TEST_UPLINK_MS);
+    service->EnableVoiceProcessing(false);
+    service->Stop();
+    HostOpusSetEncodeCost(0);
+    EXPECT_GE(unmuted.packets, static_cast<uint32_t>(TEST_UPLINK_MS / OPUS_FRAME_DURATION_MS * 3 / 4));
+}
+
+// Uplink frames keep their encode latency while the decoder runs flat out:
+// each 60 ms packet holds the decode task for 50 ms, which a shared codec
+// task would add to every frame waiting to be encoded
+TEST(AudioServiceBenchmark, EncodeLatencyUnderDecodeLoad)
+{
+    HostOpusSetDecodeCost(TEST_DECODE_COST_US);
+    HostOpusSetEncodeCost(TEST_ENCODE_COST_US);
+    // The AFE task never returns, so the service and its codec outlive the test
+    FakeCodec &codec = *new FakeCodec(16000, 16000);
+    codec.SetInput([](uint64_t index)
+                   { return static_cast<int16_t>((index / 8) % 2 ? 1000 : -1000); });
+    AudioService *service = new AudioService();
+    service->Initialize(&codec);
+    service->Start();
+    service->EnableVoiceProcessing(true);
+    UtilsLatency::Instance().Reset();
+
+    // Stream downlink packets in real time while draining the uplink
+    std::vector<uint8_t> packet = DownlinkPacket(2000);
+    AudioServiceStreamPacket sent;
+    uint32_t packets_sent = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t timestamp = 0; timestamp < TEST_BENCH_MS; timestamp += TEST_DOWNLINK_FRAME_MS)
+    {
+        service->PushPacketToDecodeQueue(packet.data(), packet.size(), 16000, TEST_DOWNLINK_FRAME_MS, timestamp, true);
+        while (service->PopPacketFromSendQueue(sent))
+        {
+            packets_sent++;
+        }
+        std::this_thread::sleep_until(start + std::chrono::milliseconds(timestamp + TEST_DOWNLINK_FRAME_MS));
+    }
+    service->EnableVoiceProcessing(false);
+    service->Stop();
+    HostOpusSetDecodeCost(0);
+    HostOpusSetEncodeCost(0);
+
+    // Report the encode stage, from AFE output to encoded frame
+    UtilsLatencyStats encode = UtilsLatency::Instance().GetStats(UtilsLatencyUplinkEncode);
+    AudioServiceStats stats = service->GetStats();
+    std::printf("encode latency: %lu frames, p50 %lu ms, p99 %lu ms, max %lu ms; %lu frames decoded\n",
+                (unsigned long)encode.count, (unsigned long)encode.p50_ms, (unsigned long)encode.p99_ms, (unsigned long)encode.max_ms, (unsigned long)stats.frames_decoded);
+    RecordProperty("encode_max_ms", static_cast<int>(encode.max_ms));
+    RecordProperty("encode_p99_ms", static_cast<int>(encode.p99_ms));
+
+    // The decoder was loaded and the uplink kept flowing
+    EXPECT_GE(stats.frames_decoded, static_cast<uint32_t>(TEST_BENCH_MS / TEST_DOWNLINK_FRAME_MS / 2));
+    EXPECT_GE(encode.count, static_cast<uint32_t>(TEST_BENCH_MS / OPUS_FRAME_DURATION_MS / 2));
+    EXPECT_GT(packets_sent, 0u);
+
+    // No frame waited for a decode to finish
+    EXPECT_LT(encode.max_ms, static_cast<uint32_t>(TEST_DECODE_COST_US / 1000));
+}
\ No newline at end of file
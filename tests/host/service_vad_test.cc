@@ -0,0 +1,120 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// Include standard headers
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <cstdint>
+
+// Include test headers
+#include <gtest/gtest.h>
+
+// Include headers
+#include "service_basic.h"
+#include "fake_codec.h"
+
+// Define the level step between captured frames, each frame carries its own level
+#define TEST_FRAME_SAMPLES (16000 / 1000 * OPUS_FRAME_DURATION_MS)
+#define TEST_LEVEL_STEP 10
+
+// Define silence and speech drained per phase, and the time the gate takes to settle
+#define TEST_SILENCE_MS 1200
+#define TEST_SPEECH_MS 600
+#define TEST_SETTLE_MS (AUDIO_VAD_HANGOVER_MS + 200)
+
+// Uplink seen in one phase: levels of audio frames in order, and DTX keep-alives
+struct UplinkLog
+{
+    std::vector<int16_t> levels;
+    uint32_t keepalives = 0;
+};
+
+// Drain the uplink for a while
+static UplinkLog DrainUplink(AudioService &service, int duration_ms)
+{
+    UplinkLog log;
+    AudioServiceStreamPacket packet;
+    auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(duration_ms);
+    while (std::chrono::steady_clock::now() < end)
+    {
+        while (service.PopPacketFromSendQueue(packet))
+        {
+            // A keep-alive is a TOC byte alone
+            if (packet.payload.size() == 1)
+            {
+                log.keepalives++;
+                continue;
+            }
+            int16_t level = 0;
+            int16_t fec_level = 0;
+            bool fec = false;
+            for (int frame = 0; HostOpusReadFrame(packet.payload.data(), packet.payload.size(), frame, &level, &fec, &fec_level); ++frame)
+            {
+                log.levels.push_back(level);
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return log;
+}
+
+// Silence sends only keep-alives, speech onset sends the held pre-roll
+// ahead of live frames without a gap, and silence closes the gate again
+TEST(AudioServiceVadGateTest, HoldsSilenceAndBurstsPrerollAtOnset)
+{
+    // The AFE task never returns, so the service and its codec outlive the test
+    HostAfeSetVad(VAD_SILENCE);
+    FakeCodec &codec = *new FakeCodec(16000, 16000);
+    codec.SetInput([](uint64_t index)
+                   { return static_cast<int16_t>(1000 + TEST_LEVEL_STEP * static_cast<int>(index / TEST_FRAME_SAMPLES)); });
+    AudioService *service = new AudioService();
+    service->Initialize(&codec);
+    service->SetUplinkPacketDuration(OPUS_FRAME_DURATION_MS);
+    service->Start();
+    service->EnableVoiceProcessing(true);
+    ASSERT_TRUE(service->GetStats().vad_gate);
+    DrainUplink(*service, 200);
+
+    // Silence: frames are held, a keep-alive goes out every DTX interval
+    uint32_t held = service->GetStats().frames_held;
+    UplinkLog silence = DrainUplink(*service, TEST_SILENCE_MS);
+    EXPECT_TRUE(silence.levels.empty());
+    EXPECT_NEAR(silence.keepalives, TEST_SILENCE_MS / AUDIO_UPLINK_DTX_INTERVAL_MS, 1);
+    EXPECT_GE(service->GetStats().frames_held - held, static_cast<uint32_t>(TEST_SILENCE_MS / OPUS_FRAME_DURATION_MS * 3 / 4));
+
+    // Speech: one burst of the whole pre-roll, then live frames, every frame once and in order
+    HostAfeSetVad(VAD_SPEECH);
+    UplinkLog speech = DrainUplink(*service, TEST_SPEECH_MS);
+    AudioServiceStats stats = service->GetStats();
+    EXPECT_EQ(stats.vad_bursts, 1u);
+    EXPECT_EQ(stats.vad_burst_frames, static_cast<uint32_t>(AUDIO_VAD_PREROLL_MS / OPUS_FRAME_DURATION_MS + 1));
+    ASSERT_GE(speech.levels.size(), static_cast<size_t>(stats.vad_burst_frames + TEST_SPEECH_MS / OPUS_FRAME_DURATION_MS / 2));
+    for (size_t i = 1; i < speech.levels.size(); ++i)
+    {
+        ASSERT_NEAR(speech.levels[i] - speech.levels[i - 1], TEST_LEVEL_STEP, 1) << "frame " << i;
+    }
+
+    // Silence after the hangover closes the gate again
+    HostAfeSetVad(VAD_SILENCE);
+    DrainUplink(*service, TEST_SETTLE_MS);
+    UplinkLog closed = DrainUplink(*service, TEST_SILENCE_MS);
+    service->EnableVoiceProcessing(false);
+    service->Stop();
+    EXPECT_TRUE(closed.levels.empty());
+    EXPECT_GT(closed.keepalives, 0u);
+    EXPECT_GT(service->GetStats().vad_bytes_saved, stats.vad_bytes_saved);
+}
\ No newline at end of file
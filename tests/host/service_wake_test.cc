@@ -0,0 +1,96 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// Include standard headers
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <cstdint>
+
+// Include test headers
+#include <gtest/gtest.h>
+
+// Include headers
+#include "service_basic.h"
+#include "fake_codec.h"
+
+// Define when the wake word is spoken and for how long, in captured samples
+#define TEST_WAKE_START (16000 * 500 / 1000)
+#define TEST_WAKE_SAMPLES (16000 * 100 / 1000)
+
+// Define uplink audio drained after the wake word
+#define TEST_UPLINK_MS 1000
+
+// The wake word latency runs from detection to the first packet captured
+// after it; pre-roll replayed ahead of that packet does not end it early
+TEST(AudioServiceWakeTest, WakeLatencyEndsAtFirstLivePacket)
+{
+    // The AFE task never returns, so the service and its codec outlive the test
+    HostSrSetWakeNet(true);
+    FakeCodec &codec = *new FakeCodec(16000, 16000);
+    codec.SetInput([](uint64_t index)
+                   { return static_cast<int16_t>(index >= TEST_WAKE_START && index < TEST_WAKE_START + TEST_WAKE_SAMPLES ? 32000 : ((index / 8) % 2 ? 1000 : -1000)); });
+    AudioService *service = new AudioService();
+    std::atomic<int64_t> detected_us{0};
+    AudioServiceCallbacks callbacks;
+    callbacks.on_wake_word = [&detected_us](const std::string &)
+    { detected_us = esp_timer_get_time(); };
+    service->SetCallbacks(callbacks);
+    service->Initialize(&codec);
+    service->SetUplinkPacketDuration(OPUS_FRAME_DURATION_MS);
+    ASSERT_TRUE(service->GetStats().wake_enabled);
+    UtilsLatency::Instance().Reset();
+    service->Start();
+    service->EnableVoiceProcessing(true);
+
+    // Drain the uplink, noting the first packet captured after the detection
+    AudioServiceStreamPacket packet;
+    int64_t first_live_us = 0;
+    int replayed = 0;
+    auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(TEST_WAKE_START / 16 + TEST_UPLINK_MS);
+    while (std::chrono::steady_clock::now() < end)
+    {
+        while (service->PopPacketFromSendQueue(packet))
+        {
+            int64_t wake_us = detected_us.load();
+            if (wake_us == 0)
+            {
+                continue;
+            }
+            if (packet.origin_us < wake_us)
+            {
+                replayed++;
+            }
+            else if (first_live_us == 0)
+            {
+                first_live_us = packet.stage_us;
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    service->EnableVoiceProcessing(false);
+    service->Stop();
+    HostSrSetWakeNet(false);
+
+    // Pre-roll went out first, one sample ends at the first live packet
+    ASSERT_NE(detected_us.load(), 0);
+    ASSERT_NE(first_live_us, 0);
+    EXPECT_GT(replayed, 0);
+    UtilsLatencyStats stats = UtilsLatency::Instance().GetStats(UtilsLatencyWakeFirstPacket);
+    EXPECT_EQ(stats.count, 1u);
+    EXPECT_NEAR(static_cast<double>(stats.max_ms), static_cast<double>(first_live_us - detected_us.load()) / 1000, 5);
+    EXPECT_GE(stats.max_ms, static_cast<uint32_t>(OPUS_FRAME_DURATION_MS / 2));
+}
\ No newline at end of file
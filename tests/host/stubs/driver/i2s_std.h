@@ -0,0 +1,62 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef HOST_DRIVER_I2S_STD_H
+#define HOST_DRIVER_I2S_STD_H
+
+// Include standard headers
+#include <cstddef>
+#include <cstdint>
+
+// Include ESP headers
+#include "esp_err.h"
+
+// Host stand-in for the I2S standard mode driver: a channel only keeps its
+// event callbacks, tests play the DMA by raising its events
+typedef struct host_i2s_channel *i2s_chan_handle_t;
+
+typedef struct
+{
+    void *data;
+    void *dma_buf;
+    size_t size;
+} i2s_event_data_t;
+
+typedef bool (*i2s_isr_callback_t)(i2s_chan_handle_t handle, i2s_event_data_t *event, void *user_ctx);
+
+typedef struct
+{
+    i2s_isr_callback_t on_recv;
+    i2s_isr_callback_t on_recv_q_ovf;
+    i2s_isr_callback_t on_sent;
+    i2s_isr_callback_t on_send_q_ovf;
+} i2s_event_callbacks_t;
+
+// Register callbacks and enable or disable a channel
+esp_err_t i2s_channel_register_event_callback(i2s_chan_handle_t handle, const i2s_event_callbacks_t *callbacks, void *user_data);
+esp_err_t i2s_channel_enable(i2s_chan_handle_t handle);
+esp_err_t i2s_channel_disable(i2s_chan_handle_t handle);
+
+// Host only: create a channel, never freed like on the target
+i2s_chan_handle_t HostI2sCreateChannel();
+
+// Host only: raise a sent event, the callback refills the buffer just sent
+bool HostI2sSent(i2s_chan_handle_t handle, int16_t *buffer, size_t samples);
+
+// Host only: raise a received event for a buffer the DMA just filled
+bool HostI2sReceived(i2s_chan_handle_t handle, int16_t *buffer, size_t samples);
+
+#endif
\ No newline at end of file
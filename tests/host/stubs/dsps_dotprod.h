@@ -0,0 +1,34 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef HOST_DSPS_DOTPROD_H
+#define HOST_DSPS_DOTPROD_H
+
+// Include standard headers
+#include <cstdint>
+
+// Include ESP headers
+#include "esp_err.h"
+
+// Host stand-in for the esp-dsp 16 bit dot product, the ANSI reference the
+// accelerated versions match: the sum starts at 0x7fff >> shift, shifts
+// right by 15 - shift and keeps its low 16 bits
+esp_err_t dsps_dotprod_s16(const int16_t *src1, const int16_t *src2, int16_t *dest, int len, int8_t shift);
+
+// Host only: dot products computed so far
+uint64_t HostDspDotprodCalls();
+
+#endif
\ No newline at end of file
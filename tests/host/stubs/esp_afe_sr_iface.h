@@ -0,0 +1,157 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef HOST_ESP_AFE_SR_IFACE_H
+#define HOST_ESP_AFE_SR_IFACE_H
+
+// Include standard headers
+#include <cstdint>
+
+// Include FreeRTOS headers
+#include "freertos/FreeRTOS.h"
+
+// Include model headers
+#include "model_path.h"
+
+// Host stand-in for the esp-sr AFE: it passes the first mic channel through
+// in fetch chunks and reports the VAD state a test sets
+typedef enum
+{
+    VAD_SILENCE = 0,
+    VAD_SPEECH = 1,
+} vad_state_t;
+
+typedef enum
+{
+    AFE_TYPE_SR,
+    AFE_TYPE_VC,
+    AFE_TYPE_VC_8K,
+} afe_type_t;
+
+typedef enum
+{
+    AFE_MODE_LOW_COST,
+    AFE_MODE_HIGH_PERF,
+} afe_mode_t;
+
+typedef enum
+{
+    AEC_MODE_SR_LOW_COST,
+    AEC_MODE_SR_HIGH_PERF,
+    AEC_MODE_VOIP_LOW_COST,
+    AEC_MODE_VOIP_HIGH_PERF,
+} afe_aec_mode_t;
+
+typedef enum
+{
+    VAD_MODE_0,
+    VAD_MODE_1,
+    VAD_MODE_2,
+    VAD_MODE_3,
+    VAD_MODE_4,
+} vad_mode_t;
+
+typedef enum
+{
+    AFE_NS_MODE_WEBRTC,
+    AFE_NS_MODE_NET,
+} afe_ns_mode_t;
+
+typedef enum
+{
+    AFE_AGC_MODE_WEBRTC,
+    AFE_AGC_MODE_WAKENET,
+} afe_agc_mode_t;
+
+typedef enum
+{
+    AFE_MEMORY_ALLOC_MORE_INTERNAL,
+    AFE_MEMORY_ALLOC_INTERNAL_PSRAM_BALANCE,
+    AFE_MEMORY_ALLOC_MORE_PSRAM,
+} afe_memory_alloc_mode_t;
+
+typedef struct
+{
+    bool aec_init;
+    afe_aec_mode_t aec_mode;
+    bool vad_init;
+    vad_mode_t vad_mode;
+    char *vad_model_name;
+    int vad_min_noise_ms;
+    int vad_min_speech_ms;
+    bool ns_init;
+    char *ns_model_name;
+    afe_ns_mode_t afe_ns_mode;
+    bool agc_init;
+    afe_agc_mode_t agc_mode;
+    afe_memory_alloc_mode_t memory_alloc_mode;
+    afe_mode_t afe_mode;
+    afe_type_t afe_type;
+    int channels;
+} afe_config_t;
+
+typedef struct
+{
+    int16_t *data;
+    int data_size;
+    vad_state_t vad_state;
+    int ret_value;
+} afe_fetch_result_t;
+
+typedef struct esp_afe_sr_data_t esp_afe_sr_data_t;
+
+typedef struct
+{
+    esp_afe_sr_data_t *(*create_from_config)(afe_config_t *config);
+    int (*feed)(esp_afe_sr_data_t *afe, const int16_t *in);
+    afe_fetch_result_t *(*fetch)(esp_afe_sr_data_t *afe);
+    afe_fetch_result_t *(*fetch_with_delay)(esp_afe_sr_data_t *afe, TickType_t ticks);
+    int (*reset_buffer)(esp_afe_sr_data_t *afe);
+    int (*get_feed_chunksize)(esp_afe_sr_data_t *afe);
+    int (*get_fetch_chunksize)(esp_afe_sr_data_t *afe);
+    int (*get_channel_num)(esp_afe_sr_data_t *afe);
+    int (*get_samp_rate)(esp_afe_sr_data_t *afe);
+    int (*disable_aec)(esp_afe_sr_data_t *afe);
+    int (*enable_aec)(esp_afe_sr_data_t *afe);
+    int (*disable_vad)(esp_afe_sr_data_t *afe);
+    int (*enable_vad)(esp_afe_sr_data_t *afe);
+    int (*disable_ns)(esp_afe_sr_data_t *afe);
+    int (*enable_ns)(esp_afe_sr_data_t *afe);
+    int (*disable_agc)(esp_afe_sr_data_t *afe);
+    int (*enable_agc)(esp_afe_sr_data_t *afe);
+    void (*destroy)(esp_afe_sr_data_t *afe);
+} esp_afe_sr_iface_t;
+
+// Build a configuration from an input format such as "MR"
+afe_config_t *afe_config_init(const char *input_format, srmodel_list_t *models, afe_type_t type, afe_mode_t mode);
+
+// Host only: feed and fetch chunk sizes of AFE instances created from now on
+void HostAfeSetChunks(int feed_samples, int fetch_samples);
+
+// Host only: VAD state reported by every fetch from now on
+void HostAfeSetVad(vad_state_t state);
+
+// Host only: the stages the newest AFE instance has enabled
+struct HostAfeStages
+{
+    bool aec = false;
+    bool vad = false;
+    bool ns = false;
+    bool agc = false;
+};
+HostAfeStages HostAfeGetStages();
+
+#endif
\ No newline at end of file
@@ -0,0 +1,26 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef HOST_ESP_AFE_SR_MODELS_H
+#define HOST_ESP_AFE_SR_MODELS_H
+
+// Include AFE headers
+#include "esp_afe_sr_iface.h"
+
+// Get the AFE interface a configuration selects
+const esp_afe_sr_iface_t *esp_afe_handle_from_config(afe_config_t *config);
+
+#endif
\ No newline at end of file
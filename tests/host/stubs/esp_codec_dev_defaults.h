@@ -0,0 +1,22 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef HOST_ESP_CODEC_DEV_DEFAULTS_H
+#define HOST_ESP_CODEC_DEV_DEFAULTS_H
+
+// Host stand-in for esp_codec_dev, the audio package includes it without using it
+
+#endif
\ No newline at end of file
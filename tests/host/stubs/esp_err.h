@@ -0,0 +1,52 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef HOST_ESP_ERR_H
+#define HOST_ESP_ERR_H
+
+// Include standard headers
+#include <cstdio>
+#include <cstdlib>
+
+// Host stand-in for ESP-IDF error codes
+typedef int esp_err_t;
+
+#define ESP_OK 0
+#define ESP_FAIL -1
+#define ESP_ERR_NO_MEM 0x101
+#define ESP_ERR_INVALID_ARG 0x102
+#define ESP_ERR_INVALID_STATE 0x103
+#define ESP_ERR_INVALID_SIZE 0x104
+#define ESP_ERR_NOT_FOUND 0x105
+#define ESP_ERR_NOT_SUPPORTED 0x106
+#define ESP_ERR_TIMEOUT 0x107
+
+// Get error name
+inline const char *esp_err_to_name(esp_err_t code) { return code == ESP_OK ? "ESP_OK" : "ESP_ERR"; }
+
+// Abort on error like the target does
+#define ESP_ERROR_CHECK(x)                                                   \
+    do                                                                       \
+    {                                                                        \
+        esp_err_t err_rc_ = (x);                                             \
+        if (err_rc_ != ESP_OK)                                               \
+        {                                                                    \
+            std::fprintf(stderr, "ESP_ERROR_CHECK failed: %d\n", err_rc_);   \
+            std::abort();                                                    \
+        }                                                                    \
+    } while (0)
+
+#endif
\ No newline at end of file
@@ -0,0 +1,30 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef HOST_ESP_LOG_H
+#define HOST_ESP_LOG_H
+
+// Include standard headers
+#include <cstdio>
+
+// Host stand-in for ESP-IDF logging, errors and warnings go to stderr
+#define ESP_LOGE(tag, format, ...) std::fprintf(stderr, "E %s " format "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGW(tag, format, ...) std::fprintf(stderr, "W %s " format "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGI(tag, format, ...) do { if (0) std::fprintf(stderr, format, ##__VA_ARGS__); (void)(tag); } while (0)
+#define ESP_LOGD(tag, format, ...) ESP_LOGI(tag, format, ##__VA_ARGS__)
+#define ESP_LOGV(tag, format, ...) ESP_LOGI(tag, format, ##__VA_ARGS__)
+
+#endif
\ No newline at end of file
@@ -0,0 +1,60 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef HOST_ESP_TIMER_H
+#define HOST_ESP_TIMER_H
+
+// Include standard headers
+#include <cstdint>
+
+// Include ESP headers
+#include "esp_err.h"
+
+// Host stand-in for the ESP-IDF high resolution timer
+typedef struct host_timer *esp_timer_handle_t;
+
+typedef void (*esp_timer_cb_t)(void *arg);
+
+typedef enum
+{
+    ESP_TIMER_TASK,
+    ESP_TIMER_ISR,
+} esp_timer_dispatch_t;
+
+typedef struct
+{
+    esp_timer_cb_t callback;
+    void *arg;
+    int dispatch_method;
+    const char *name;
+    bool skip_unhandled_events;
+} esp_timer_create_args_t;
+
+// Get microseconds since start, or the manual clock once a test set it
+int64_t esp_timer_get_time();
+
+// Timers never fire on the host, tests call the callbacks they need
+esp_err_t esp_timer_create(const esp_timer_create_args_t *args, esp_timer_handle_t *handle);
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t handle, uint64_t period);
+esp_err_t esp_timer_start_once(esp_timer_handle_t handle, uint64_t timeout);
+esp_err_t esp_timer_stop(esp_timer_handle_t handle);
+esp_err_t esp_timer_delete(esp_timer_handle_t handle);
+
+// Host only: drive esp_timer_get_time() by hand, a negative time returns to the real clock
+void HostTimerSet(int64_t time_us);
+void HostTimerAdvance(int64_t delta_us);
+
+#endif
\ No newline at end of file
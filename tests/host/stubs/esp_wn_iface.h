@@ -0,0 +1,52 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef HOST_ESP_WN_IFACE_H
+#define HOST_ESP_WN_IFACE_H
+
+// Include standard headers
+#include <cstdint>
+
+// Include model headers
+#include "model_path.h"
+
+// Host stand-in for the WakeNet interface: a chunk with a sample at or
+// above the wake level counts as the wake word
+#define HOST_WAKENET_LEVEL 30000
+#define HOST_WAKENET_CHUNK 480
+
+typedef struct model_iface_data_t model_iface_data_t;
+
+typedef enum
+{
+    DET_MODE_90 = 0,
+    DET_MODE_95 = 1,
+} det_mode_t;
+
+typedef struct
+{
+    model_iface_data_t *(*create)(const void *model_name, det_mode_t det_mode);
+    int (*get_samp_chunksize)(model_iface_data_t *model);
+    int (*get_channel_num)(model_iface_data_t *model);
+    int (*get_samp_rate)(model_iface_data_t *model);
+    int (*get_word_num)(model_iface_data_t *model);
+    char *(*get_word_name)(model_iface_data_t *model, int word_index);
+    int (*detect)(model_iface_data_t *model, int16_t *samples);
+    void (*clean)(model_iface_data_t *model);
+    void (*destroy)(model_iface_data_t *model);
+} esp_wn_iface_t;
+
+#endif
\ No newline at end of file
@@ -0,0 +1,51 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef HOST_FREERTOS_TASK_H
+#define HOST_FREERTOS_TASK_H
+
+// Include FreeRTOS headers
+#include "freertos/FreeRTOS.h"
+
+// Host stand-in for FreeRTOS tasks, each task is a detached thread
+typedef struct host_task *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *);
+
+#define tskDEFAULT_INDEX_TO_NOTIFY 0
+
+// Create and delete tasks
+BaseType_t xTaskCreate(TaskFunction_t function, const char *name, uint32_t stack, void *arg, UBaseType_t priority, TaskHandle_t *handle);
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char *name, uint32_t stack, void *arg, UBaseType_t priority, TaskHandle_t *handle, BaseType_t core);
+void vTaskDelete(TaskHandle_t handle);
+
+// Time
+void vTaskDelay(TickType_t ticks);
+TickType_t xTaskGetTickCount();
+
+// Get the calling task, threads not created by xTaskCreate get one on first use
+TaskHandle_t xTaskGetCurrentTaskHandle();
+
+// Direct to task notifications
+void xTaskNotifyGiveIndexed(TaskHandle_t handle, UBaseType_t index);
+uint32_t ulTaskNotifyTakeIndexed(UBaseType_t index, BaseType_t clear, TickType_t ticks);
+void vTaskNotifyGiveFromISR(TaskHandle_t handle, BaseType_t *woken);
+inline void xTaskNotifyGive(TaskHandle_t handle) { xTaskNotifyGiveIndexed(handle, tskDEFAULT_INDEX_TO_NOTIFY); }
+inline uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t ticks) { return ulTaskNotifyTakeIndexed(tskDEFAULT_INDEX_TO_NOTIFY, clear, ticks); }
+
+// Host only: count notifications given, to measure wakeups per frame
+uint64_t HostNotifyGiveCount();
+
+#endif
\ No newline at end of file
@@ -0,0 +1,47 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// Include standard headers
+#include <atomic>
+
+// Include DSP headers
+#include "dsps_dotprod.h"
+
+// Dot products computed so far
+static std::atomic<uint64_t> dotprod_calls{0};
+
+// Dot product of two 16 bit vectors
+esp_err_t dsps_dotprod_s16(const int16_t *src1, const int16_t *src2, int16_t *dest, int len, int8_t shift)
+{
+    // Start from the rounding offset esp-dsp uses, accumulate in 64 bits
+    int64_t acc = 0x7fff >> shift;
+    for (int i = 0; i < len; ++i)
+    {
+        acc += static_cast<int32_t>(src1[i]) * static_cast<int32_t>(src2[i]);
+    }
+
+    // Scale back and truncate to 16 bits
+    int final_shift = shift - 15;
+    *dest = static_cast<int16_t>(final_shift > 0 ? acc << final_shift : acc >> -final_shift);
+    dotprod_calls++;
+    return ESP_OK;
+}
+
+// Dot products computed so far
+uint64_t HostDspDotprodCalls()
+{
+    return dotprod_calls;
+}
\ No newline at end of file
@@ -0,0 +1,204 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// Include standard headers
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <condition_variable>
+
+// Include FreeRTOS headers
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/event_groups.h"
+
+// Task control block: notification counters guarded by one mutex
+struct host_task
+{
+    std::mutex mutex;
+    std::condition_variable cv;
+    uint32_t notify[configTASK_NOTIFICATION_ARRAY_ENTRIES] = {0};
+};
+
+// Event group: bits guarded by one mutex
+struct host_event_group
+{
+    std::mutex mutex;
+    std::condition_variable cv;
+    EventBits_t bits = 0;
+};
+
+// Calling task and the count of notifications given
+static thread_local host_task *current_task = nullptr;
+static std::atomic<uint64_t> notify_give_count{0};
+static const auto start_time = std::chrono::steady_clock::now();
+
+// Convert ticks to a deadline
+static std::chrono::steady_clock::time_point Deadline(TickType_t ticks)
+{
+    return std::chrono::steady_clock::now() + std::chrono::milliseconds(ticks);
+}
+
+// Create task
+BaseType_t xTaskCreate(TaskFunction_t function, const char *name, uint32_t stack, void *arg, UBaseType_t priority, TaskHandle_t *handle)
+{
+    host_task *task = new host_task();
+    if (handle != nullptr)
+    {
+        *handle = task;
+    }
+    std::thread([function, arg, task]()
+                {
+                    current_task = task;
+                    function(arg);
+                })
+        .detach();
+    return pdPASS;
+}
+
+// Create task on a core
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char *name, uint32_t stack, void *arg, UBaseType_t priority, TaskHandle_t *handle, BaseType_t core)
+{
+    return xTaskCreate(function, name, stack, arg, priority, handle);
+}
+
+// Delete task: the control block stays valid for late notifications, the
+// calling thread simply returns from its function
+void vTaskDelete(TaskHandle_t handle)
+{
+}
+
+// Sleep
+void vTaskDelay(TickType_t ticks)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(ticks));
+}
+
+// Get milliseconds since start
+TickType_t xTaskGetTickCount()
+{
+    return static_cast<TickType_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start_time).count());
+}
+
+// Get calling task
+TaskHandle_t xTaskGetCurrentTaskHandle()
+{
+    if (current_task == nullptr)
+    {
+        current_task = new host_task();
+    }
+    return current_task;
+}
+
+// Give notification
+void xTaskNotifyGiveIndexed(TaskHandle_t handle, UBaseType_t index)
+{
+    notify_give_count.fetch_add(1, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(handle->mutex);
+        handle->notify[index]++;
+    }
+    handle->cv.notify_all();
+}
+
+// Give notification from an interrupt
+void vTaskNotifyGiveFromISR(TaskHandle_t handle, BaseType_t *woken)
+{
+    xTaskNotifyGiveIndexed(handle, tskDEFAULT_INDEX_TO_NOTIFY);
+    if (woken != nullptr)
+    {
+        *woken = pdTRUE;
+    }
+}
+
+// Take notification
+uint32_t ulTaskNotifyTakeIndexed(UBaseType_t index, BaseType_t clear, TickType_t ticks)
+{
+    host_task *task = xTaskGetCurrentTaskHandle();
+    std::unique_lock<std::mutex> lock(task->mutex);
+    auto ready = [task, index]()
+    { return task->notify[index] != 0; };
+    if (ticks == portMAX_DELAY)
+    {
+        task->cv.wait(lock, ready);
+    }
+    else if (!task->cv.wait_until(lock, Deadline(ticks), ready))
+    {
+        return 0;
+    }
+    uint32_t value = task->notify[index];
+    task->notify[index] = clear ? 0 : value - 1;
+    return value;
+}
+
+// Get notifications given
+uint64_t HostNotifyGiveCount()
+{
+    return notify_give_count.load(std::memory_order_relaxed);
+}
+
+// Create event group
+EventGroupHandle_t xEventGroupCreate()
+{
+    return new host_event_group();
+}
+
+// Delete event group
+void vEventGroupDelete(EventGroupHandle_t group)
+{
+    delete group;
+}
+
+// Set bits
+EventBits_t xEventGroupSetBits(EventGroupHandle_t group, EventBits_t bits)
+{
+    std::lock_guard<std::mutex> lock(group->mutex);
+    group->bits |= bits;
+    group->cv.notify_all();
+    return group->bits;
+}
+
+// Clear bits, returns the bits before clearing
+EventBits_t xEventGroupClearBits(EventGroupHandle_t group, EventBits_t bits)
+{
+    std::lock_guard<std::mutex> lock(group->mutex);
+    EventBits_t previous = group->bits;
+    group->bits &= ~bits;
+    return previous;
+}
+
+// Get bits
+EventBits_t xEventGroupGetBits(EventGroupHandle_t group)
+{
+    std::lock_guard<std::mutex> lock(group->mutex);
+    return group->bits;
+}
+
+// Wait for bits
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t group, EventBits_t bits, BaseType_t clear, BaseType_t all, TickType_t ticks)
+{
+    std::unique_lock<std::mutex> lock(group->mutex);
+    auto ready = [group, bits, all]()
+    { return all ? (group->bits & bits) == bits : (group->bits & bits) != 0; };
+    bool met = ticks == portMAX_DELAY ? (group->cv.wait(lock, ready), true) : group->cv.wait_until(lock, Deadline(ticks), ready);
+    EventBits_t value = group->bits;
+    if (met && clear)
+    {
+        group->bits &= ~bits;
+    }
+    return value;
+}
\ No newline at end of file
@@ -0,0 +1,87 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// Include standard headers
+#include <atomic>
+
+// Include driver headers
+#include "driver/i2s_std.h"
+
+// Channel: callbacks, their context and whether the channel runs
+struct host_i2s_channel
+{
+    i2s_event_callbacks_t callbacks = {};
+    void *user_data = nullptr;
+    std::atomic<bool> enabled{false};
+};
+
+// Register event callbacks
+esp_err_t i2s_channel_register_event_callback(i2s_chan_handle_t handle, const i2s_event_callbacks_t *callbacks, void *user_data)
+{
+    if (handle == nullptr || handle->enabled)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+    handle->callbacks = *callbacks;
+    handle->user_data = user_data;
+    return ESP_OK;
+}
+
+// Enable channel
+esp_err_t i2s_channel_enable(i2s_chan_handle_t handle)
+{
+    handle->enabled = true;
+    return ESP_OK;
+}
+
+// Disable channel
+esp_err_t i2s_channel_disable(i2s_chan_handle_t handle)
+{
+    handle->enabled = false;
+    return ESP_OK;
+}
+
+// Create channel
+i2s_chan_handle_t HostI2sCreateChannel()
+{
+    return new host_i2s_channel();
+}
+
+// Raise an event on a running channel
+static bool Raise(i2s_chan_handle_t handle, i2s_isr_callback_t callback, int16_t *buffer, size_t samples)
+{
+    if (!handle->enabled || callback == nullptr)
+    {
+        return false;
+    }
+    i2s_event_data_t event = {};
+    event.data = buffer;
+    event.dma_buf = buffer;
+    event.size = samples * sizeof(int16_t);
+    return callback(handle, &event, handle->user_data);
+}
+
+// Raise a sent event
+bool HostI2sSent(i2s_chan_handle_t handle, int16_t *buffer, size_t samples)
+{
+    return Raise(handle, handle->callbacks.on_sent, buffer, samples);
+}
+
+// Raise a received event
+bool HostI2sReceived(i2s_chan_handle_t handle, int16_t *buffer, size_t samples)
+{
+    return Raise(handle, handle->callbacks.on_recv, buffer, samples);
+}
\ No newline at end of file
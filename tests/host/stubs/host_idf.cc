@@ -0,0 +1,131 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// Include standard headers
+#include <cstdlib>
+#include <chrono>
+#include <atomic>
+
+// Include ESP headers
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+
+// Include host support
+#include "host_alloc.h"
+
+// Manual clock, negative while the real clock is in use
+static std::atomic<int64_t> manual_time_us{-1};
+static const auto start_time = std::chrono::steady_clock::now();
+
+// Get microseconds since start
+int64_t esp_timer_get_time()
+{
+    int64_t manual = manual_time_us.load(std::memory_order_relaxed);
+    if (manual >= 0)
+    {
+        return manual;
+    }
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_time).count();
+}
+
+// Set manual clock
+void HostTimerSet(int64_t time_us)
+{
+    manual_time_us.store(time_us, std::memory_order_relaxed);
+}
+
+// Advance manual clock
+void HostTimerAdvance(int64_t delta_us)
+{
+    manual_time_us.fetch_add(delta_us, std::memory_order_relaxed);
+}
+
+// Timer handle, never armed on the host
+struct host_timer
+{
+    esp_timer_create_args_t args;
+};
+
+// Create timer
+esp_err_t esp_timer_create(const esp_timer_create_args_t *args, esp_timer_handle_t *handle)
+{
+    *handle = new host_timer{*args};
+    return ESP_OK;
+}
+
+// Start periodic timer
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t handle, uint64_t period)
+{
+    return ESP_OK;
+}
+
+// Start one shot timer
+esp_err_t esp_timer_start_once(esp_timer_handle_t handle, uint64_t timeout)
+{
+    return ESP_OK;
+}
+
+// Stop timer
+esp_err_t esp_timer_stop(esp_timer_handle_t handle)
+{
+    return ESP_OK;
+}
+
+// Delete timer
+esp_err_t esp_timer_delete(esp_timer_handle_t handle)
+{
+    delete handle;
+    return ESP_OK;
+}
+
+// Allocate with capabilities
+void *heap_caps_malloc(size_t size, uint32_t caps)
+{
+    HostAllocNote();
+    return std::malloc(size);
+}
+
+// Allocate zeroed with capabilities
+void *heap_caps_calloc(size_t count, size_t size, uint32_t caps)
+{
+    HostAllocNote();
+    return std::calloc(count, size);
+}
+
+// Reallocate with capabilities
+void *heap_caps_realloc(void *ptr, size_t size, uint32_t caps)
+{
+    HostAllocNote();
+    return std::realloc(ptr, size);
+}
+
+// Free with capabilities
+void heap_caps_free(void *ptr)
+{
+    std::free(ptr);
+}
+
+// Get free heap size, the host never runs out
+size_t heap_caps_get_free_size(uint32_t caps)
+{
+    return 8 * 1024 * 1024;
+}
+
+// Get minimum free heap size
+size_t heap_caps_get_minimum_free_size(uint32_t caps)
+{
+    return 8 * 1024 * 1024;
+}
\ No newline at end of file
@@ -0,0 +1,671 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// Include standard headers
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <cstdarg>
+#include <cstring>
+
+// Include Opus headers
+#include "opus.h"
+#include "resampler_silk.h"
+
+// Define host frame layout after the TOC byte: flags, level, and the FEC level when flagged
+#define HOST_OPUS_FLAG_FEC 0x01
+#define HOST_OPUS_FRAME_BYTES 3
+#define HOST_OPUS_FEC_BYTES 2
+
+// Define most frames and 48 kHz samples one packet holds
+#define HOST_OPUS_MAX_FRAMES 48
+#define HOST_OPUS_MAX_SAMPLES_48K 5760
+
+// Encoder state
+struct OpusEncoder
+{
+    int sample_rate = 0;
+    HostOpusEncoderSettings settings;
+    int16_t previous_level = 0;
+    bool has_previous = false;
+};
+
+// Decoder state
+struct OpusDecoder
+{
+    int sample_rate = 0;
+    int16_t last_level = 0;
+};
+
+// Repacketizer state, frames reference the caller's packets
+struct OpusRepacketizer
+{
+    unsigned char toc = 0;
+    int count = 0;
+    const unsigned char *frames[HOST_OPUS_MAX_FRAMES] = {};
+    opus_int32 sizes[HOST_OPUS_MAX_FRAMES] = {};
+};
+
+// Costs, counters and the settings of the newest encoder
+static std::atomic<int64_t> encode_cost_us{0};
+static std::atomic<int64_t> decode_cost_us{0};
+static std::atomic<uint64_t> frames_encoded{0};
+static std::atomic<uint64_t> frames_decoded{0};
+static std::atomic<uint64_t> frames_recovered{0};
+static std::atomic<uint64_t> frames_concealed{0};
+static std::mutex settings_mutex;
+static OpusEncoder *newest_encoder = nullptr;
+
+// Hold the calling task for a cost
+static void Spend(int64_t us)
+{
+    if (us > 0)
+    {
+        std::this_thread::sleep_for(std::chrono::microseconds(us));
+    }
+}
+
+// Get the duration of one frame in 48 kHz samples from a TOC byte
+static int FrameSamples48k(unsigned char toc)
+{
+    int config = toc >> 3;
+    if (config < 12)
+    {
+        static const int silk[] = {480, 960, 1920, 2880};
+        return silk[config & 3];
+    }
+    if (config < 16)
+    {
+        return (config & 1) ? 960 : 480;
+    }
+    static const int celt[] = {120, 240, 480, 960};
+    return celt[config & 3];
+}
+
+// Read a frame length, one byte below 252, otherwise two
+static int ReadLength(const unsigned char *&data, opus_int32 &len, opus_int32 &size)
+{
+    if (len < 1)
+    {
+        return OPUS_INVALID_PACKET;
+    }
+    if (data[0] < 252)
+    {
+        size = data[0];
+        data++;
+        len--;
+        return OPUS_OK;
+    }
+    if (len < 2)
+    {
+        return OPUS_INVALID_PACKET;
+    }
+    size = data[0] + 4 * data[1];
+    data += 2;
+    len -= 2;
+    return OPUS_OK;
+}
+
+// Split a packet into its frames, returns the frame count or an error
+static int ParsePacket(const unsigned char *data, opus_int32 len, const unsigned char **frames, opus_int32 *sizes)
+{
+    if (data == nullptr || len < 1)
+    {
+        return OPUS_INVALID_PACKET;
+    }
+    int code = data[0] & 0x03;
+    data++;
+    len--;
+
+    // One frame, or two of equal size
+    if (code == 0 || code == 1)
+    {
+        int count = code == 0 ? 1 : 2;
+        if (len % count != 0)
+        {
+            return OPUS_INVALID_PACKET;
+        }
+        for (int i = 0; i < count; ++i)
+        {
+            frames[i] = data + i * (len / count);
+            sizes[i] = len / count;
+        }
+        return count;
+    }
+
+    // Two frames, the first with an explicit length
+    if (code == 2)
+    {
+        opus_int32 first = 0;
+        if (ReadLength(data, len, first) != OPUS_OK || first > len)
+        {
+            return OPUS_INVALID_PACKET;
+        }
+        frames[0] = data;
+        sizes[0] = first;
+        frames[1] = data + first;
+        sizes[1] = len - first;
+        return 2;
+    }
+
+    // Any number of frames with a frame count byte and optional padding
+    if (len < 1)
+    {
+        return OPUS_INVALID_PACKET;
+    }
+    int count = data[0] & 0x3F;
+    bool vbr = (data[0] & 0x80) != 0;
+    bool padded = (data[0] & 0x40) != 0;
+    data++;
+    len--;
+    if (count == 0 || count > HOST_OPUS_MAX_FRAMES)
+    {
+        return OPUS_INVALID_PACKET;
+    }
+    if (padded)
+    {
+        int padding = 0;
+        int step = 255;
+        while (step == 255)
+        {
+            if (len < 1)
+            {
+                return OPUS_INVALID_PACKET;
+            }
+            step = data[0];
+            data++;
+            len--;
+            padding += step == 255 ? 254 : step;
+        }
+        if (padding > len)
+        {
+            return OPUS_INVALID_PACKET;
+        }
+        len -= padding;
+    }
+    if (vbr)
+    {
+        opus_int32 total = 0;
+        for (int i = 0; i < count - 1; ++i)
+        {
+            if (ReadLength(data, len, sizes[i]) != OPUS_OK)
+            {
+                return OPUS_INVALID_PACKET;
+            }
+            total += sizes[i];
+        }
+        if (total > len)
+        {
+            return OPUS_INVALID_PACKET;
+        }
+        sizes[count - 1] = len - total;
+    }
+    else
+    {
+        if (len % count != 0)
+        {
+            return OPUS_INVALID_PACKET;
+        }
+        for (int i = 0; i < count; ++i)
+        {
+            sizes[i] = len / count;
+        }
+    }
+    for (int i = 0; i < count; ++i)
+    {
+        frames[i] = data;
+        data += sizes[i];
+    }
+    return count;
+}
+
+// Fill samples with a level
+static void Fill(opus_int16 *pcm, int samples, int16_t level)
+{
+    for (int i = 0; i < samples; ++i)
+    {
+        pcm[i] = level;
+    }
+}
+
+// Create encoder
+OpusEncoder *opus_encoder_create(opus_int32 Fs, int channels, int application, int *error)
+{
+    OpusEncoder *st = new OpusEncoder();
+    st->sample_rate = Fs;
+    st->settings.bitrate = 24000;
+    {
+        std::lock_guard<std::mutex> lock(settings_mutex);
+        newest_encoder = st;
+    }
+    if (error != nullptr)
+    {
+        *error = OPUS_OK;
+    }
+    return st;
+}
+
+// Destroy encoder
+void opus_encoder_destroy(OpusEncoder *st)
+{
+    std::lock_guard<std::mutex> lock(settings_mutex);
+    if (newest_encoder == st)
+    {
+        newest_encoder = nullptr;
+    }
+    delete st;
+}
+
+// Apply an encoder control
+int opus_encoder_ctl(OpusEncoder *st, int request, ...)
+{
+    std::lock_guard<std::mutex> lock(settings_mutex);
+    if (request == OPUS_RESET_STATE)
+    {
+        st->has_previous = false;
+        st->previous_level = 0;
+        return OPUS_OK;
+    }
+    va_list args;
+    va_start(args, request);
+    opus_int32 value = va_arg(args, opus_int32);
+    va_end(args);
+    switch (request)
+    {
+    case OPUS_SET_BITRATE_REQUEST:
+        st->settings.bitrate = value;
+        break;
+    case OPUS_SET_MAX_BANDWIDTH_REQUEST:
+        st->settings.max_bandwidth = value;
+        break;
+    case OPUS_SET_COMPLEXITY_REQUEST:
+        st->settings.complexity = value;
+        break;
+    case OPUS_SET_INBAND_FEC_REQUEST:
+        st->settings.fec = value != 0;
+        break;
+    case OPUS_SET_PACKET_LOSS_PERC_REQUEST:
+        st->settings.loss_percent = value;
+        break;
+    case OPUS_SET_DTX_REQUEST:
+        st->settings.dtx = value != 0;
+        break;
+    default:
+        return OPUS_BAD_ARG;
+    }
+    return OPUS_OK;
+}
+
+// Encode one frame as a SILK wideband packet sized by the bitrate
+opus_int32 opus_encode(OpusEncoder *st, const opus_int16 *pcm, int frame_size, unsigned char *data, opus_int32 max_data_bytes)
+{
+    // Pick the TOC for the frame duration
+    int duration_ms = frame_size * 1000 / st->sample_rate;
+    static const int durations[] = {10, 20, 40, 60};
+    int config = -1;
+    for (int i = 0; i < 4; ++i)
+    {
+        if (durations[i] == duration_ms)
+        {
+            config = 8 + i;
+        }
+    }
+    if (config < 0 || max_data_bytes < 1)
+    {
+        return OPUS_BAD_ARG;
+    }
+    Spend(encode_cost_us.load());
+    frames_encoded++;
+
+    // Measure the mean level
+    int64_t sum = 0;
+    bool silent = true;
+    for (int i = 0; i < frame_size; ++i)
+    {
+        sum += pcm[i];
+        silent = silent && pcm[i] == 0;
+    }
+    int16_t level = static_cast<int16_t>(sum / frame_size);
+
+    // Silence under DTX is a TOC byte alone
+    std::lock_guard<std::mutex> lock(settings_mutex);
+    data[0] = static_cast<unsigned char>(config << 3);
+    if (st->settings.dtx && silent)
+    {
+        st->previous_level = 0;
+        st->has_previous = true;
+        return 1;
+    }
+
+    // Size the packet by the bitrate, FEC needs expected loss like in Opus
+    bool fec = st->settings.fec && st->settings.loss_percent > 0 && st->has_previous;
+    opus_int32 size = 1 + HOST_OPUS_FRAME_BYTES + (fec ? HOST_OPUS_FEC_BYTES : 0);
+    opus_int32 target = static_cast<opus_int32>(static_cast<int64_t>(st->settings.bitrate) * duration_ms / 8000);
+    size = target > size ? target : size;
+    if (size > max_data_bytes)
+    {
+        return OPUS_BUFFER_TOO_SMALL;
+    }
+    memset(data + 1, 0, size - 1);
+    data[1] = fec ? HOST_OPUS_FLAG_FEC : 0;
+    memcpy(data + 2, &level, sizeof(level));
+    if (fec)
+    {
+        memcpy(data + 4, &st->previous_level, sizeof(st->previous_level));
+    }
+    st->previous_level = level;
+    st->has_previous = true;
+    return size;
+}
+
+// Get the settings of the newest encoder
+HostOpusEncoderSettings HostOpusGetEncoderSettings()
+{
+    std::lock_guard<std::mutex> lock(settings_mutex);
+    return newest_encoder != nullptr ? newest_encoder->settings : HostOpusEncoderSettings();
+}
+
+// Create decoder
+OpusDecoder *opus_decoder_create(opus_int32 Fs, int channels, int *error)
+{
+    OpusDecoder *st = new OpusDecoder();
+    st->sample_rate = Fs;
+    if (error != nullptr)
+    {
+        *error = OPUS_OK;
+    }
+    return st;
+}
+
+// Destroy decoder
+void opus_decoder_destroy(OpusDecoder *st)
+{
+    delete st;
+}
+
+// Apply a decoder control
+int opus_decoder_ctl(OpusDecoder *st, int request, ...)
+{
+    if (request == OPUS_RESET_STATE)
+    {
+        st->last_level = 0;
+        return OPUS_OK;
+    }
+    return OPUS_BAD_ARG;
+}
+
+// Decode a packet, recover the frame before it from FEC, or conceal a lost frame
+int opus_decode(OpusDecoder *st, const unsigned char *data, opus_int32 len, opus_int16 *pcm, int frame_size, int decode_fec)
+{
+    // Concealment fades the last level
+    if (data == nullptr || len == 0)
+    {
+        Spend(decode_cost_us.load());
+        st->last_level = static_cast<int16_t>(st->last_level / 2);
+        Fill(pcm, frame_size, st->last_level);
+        frames_concealed++;
+        return frame_size;
+    }
+
+    // FEC recovers the level of the frame before, concealing without it
+    if (decode_fec)
+    {
+        int16_t level = 0;
+        int16_t fec_level = 0;
+        bool fec = false;
+        Spend(decode_cost_us.load());
+        if (HostOpusReadFrame(data, len, 0, &level, &fec, &fec_level) && fec)
+        {
+            st->last_level = fec_level;
+            frames_recovered++;
+        }
+        else
+        {
+            st->last_level = static_cast<int16_t>(st->last_level / 2);
+            frames_concealed++;
+        }
+        Fill(pcm, frame_size, st->last_level);
+        return frame_size;
+    }
+
+    // Decode every frame of the packet
+    const unsigned char *frames[HOST_OPUS_MAX_FRAMES];
+    opus_int32 sizes[HOST_OPUS_MAX_FRAMES];
+    int count = ParsePacket(data, len, frames, sizes);
+    if (count < 0)
+    {
+        return count;
+    }
+    int samples = static_cast<int>(static_cast<int64_t>(FrameSamples48k(data[0])) * st->sample_rate / 48000);
+    if (samples * count > frame_size)
+    {
+        return OPUS_BUFFER_TOO_SMALL;
+    }
+    for (int i = 0; i < count; ++i)
+    {
+        Spend(decode_cost_us.load());
+        int16_t level = 0;
+        if (sizes[i] >= HOST_OPUS_FRAME_BYTES)
+        {
+            memcpy(&level, frames[i] + 1, sizeof(level));
+        }
+        Fill(pcm + i * samples, samples, level);
+        st->last_level = level;
+        frames_decoded++;
+    }
+    return samples * count;
+}
+
+// Count frames in a packet
+int opus_packet_get_nb_frames(const unsigned char *packet, opus_int32 len)
+{
+    const unsigned char *frames[HOST_OPUS_MAX_FRAMES];
+    opus_int32 sizes[HOST_OPUS_MAX_FRAMES];
+    return ParsePacket(packet, len, frames, sizes);
+}
+
+// Count samples in a packet
+int opus_packet_get_nb_samples(const unsigned char *packet, opus_int32 len, opus_int32 Fs)
+{
+    int count = opus_packet_get_nb_frames(packet, len);
+    if (count < 0)
+    {
+        return count;
+    }
+    int samples = count * FrameSamples48k(packet[0]);
+    if (samples > HOST_OPUS_MAX_SAMPLES_48K)
+    {
+        return OPUS_INVALID_PACKET;
+    }
+    return static_cast<int>(static_cast<int64_t>(samples) * Fs / 48000);
+}
+
+// Read one frame of a host packet
+bool HostOpusReadFrame(const unsigned char *packet, opus_int32 len, int frame, int16_t *level, bool *fec, int16_t *fec_level)
+{
+    const unsigned char *frames[HOST_OPUS_MAX_FRAMES];
+    opus_int32 sizes[HOST_OPUS_MAX_FRAMES];
+    int count = ParsePacket(packet, len, frames, sizes);
+    if (frame >= count || sizes[frame] < HOST_OPUS_FRAME_BYTES)
+    {
+        return false;
+    }
+    memcpy(level, frames[frame] + 1, sizeof(*level));
+    *fec = (frames[frame][0] & HOST_OPUS_FLAG_FEC) != 0 && sizes[frame] >= HOST_OPUS_FRAME_BYTES + HOST_OPUS_FEC_BYTES;
+    *fec_level = 0;
+    if (*fec)
+    {
+        memcpy(fec_level, frames[frame] + HOST_OPUS_FRAME_BYTES, sizeof(*fec_level));
+    }
+    return true;
+}
+
+// Set the encode cost
+void HostOpusSetEncodeCost(int64_t us)
+{
+    encode_cost_us = us;
+}
+
+// Set the decode cost
+void HostOpusSetDecodeCost(int64_t us)
+{
+    decode_cost_us = us;
+}
+
+// Get the frame counters
+HostOpusCounters HostOpusGetCounters()
+{
+    HostOpusCounters counters;
+    counters.encoded = frames_encoded.load();
+    counters.decoded = frames_decoded.load();
+    counters.recovered = frames_recovered.load();
+    counters.concealed = frames_concealed.load();
+    return counters;
+}
+
+// Create repacketizer
+OpusRepacketizer *opus_repacketizer_create(void)
+{
+    return new OpusRepacketizer();
+}
+
+// Reset repacketizer
+OpusRepacketizer *opus_repacketizer_init(OpusRepacketizer *rp)
+{
+    rp->count = 0;
+    return rp;
+}
+
+// Destroy repacketizer
+void opus_repacketizer_destroy(OpusRepacketizer *rp)
+{
+    delete rp;
+}
+
+// Add the frames of a packet, all packets must share the TOC configuration
+int opus_repacketizer_cat(OpusRepacketizer *rp, const unsigned char *data, opus_int32 len)
+{
+    const unsigned char *frames[HOST_OPUS_MAX_FRAMES];
+    opus_int32 sizes[HOST_OPUS_MAX_FRAMES];
+    int count = ParsePacket(data, len, frames, sizes);
+    if (count < 0)
+    {
+        return OPUS_INVALID_PACKET;
+    }
+    if (rp->count > 0 && (data[0] & 0xFC) != rp->toc)
+    {
+        return OPUS_INVALID_PACKET;
+    }
+    if ((rp->count + count) * FrameSamples48k(data[0]) > HOST_OPUS_MAX_SAMPLES_48K)
+    {
+        return OPUS_INVALID_PACKET;
+    }
+    rp->toc = data[0] & 0xFC;
+    for (int i = 0; i < count; ++i)
+    {
+        rp->frames[rp->count] = frames[i];
+        rp->sizes[rp->count] = sizes[i];
+        rp->count++;
+    }
+    return OPUS_OK;
+}
+
+// Write the added frames as one packet, code 0 for one frame and code 3 otherwise
+opus_int32 opus_repacketizer_out(OpusRepacketizer *rp, unsigned char *data, opus_int32 maxlen)
+{
+    if (rp->count == 0)
+    {
+        return OPUS_BAD_ARG;
+    }
+
+    // Write the header
+    unsigned char header[2 + 2 * HOST_OPUS_MAX_FRAMES];
+    opus_int32 header_size = 0;
+    opus_int32 payload = 0;
+    bool vbr = false;
+    for (int i = 0; i < rp->count; ++i)
+    {
+        payload += rp->sizes[i];
+        vbr = vbr || rp->sizes[i] != rp->sizes[0];
+    }
+    if (rp->count == 1)
+    {
+        header[header_size++] = rp->toc;
+    }
+    else
+    {
+        header[header_size++] = rp->toc | 0x03;
+        header[header_size++] = static_cast<unsigned char>(rp->count | (vbr ? 0x80 : 0));
+        for (int i = 0; vbr && i < rp->count - 1; ++i)
+        {
+            opus_int32 size = rp->sizes[i];
+            if (size < 252)
+            {
+                header[header_size++] = static_cast<unsigned char>(size);
+            }
+            else
+            {
+                header[header_size++] = static_cast<unsigned char>(252 + (size & 3));
+                header[header_size++] = static_cast<unsigned char>((size - 252 - (size & 3)) >> 2);
+            }
+        }
+    }
+    if (header_size + payload > maxlen)
+    {
+        return OPUS_BUFFER_TOO_SMALL;
+    }
+
+    // Copy header and frames
+    memcpy(data, header, header_size);
+    opus_int32 offset = header_size;
+    for (int i = 0; i < rp->count; ++i)
+    {
+        memcpy(data + offset, rp->frames[i], rp->sizes[i]);
+        offset += rp->sizes[i];
+    }
+    return offset;
+}
+
+// Count added frames
+int opus_repacketizer_get_nb_frames(OpusRepacketizer *rp)
+{
+    return rp->count;
+}
+
+// Initialize the SILK resampler, the host one holds the nearest input sample
+extern "C" opus_int silk_resampler_init(silk_resampler_state_struct *S, opus_int32 Fs_Hz_in, opus_int32 Fs_Hz_out, opus_int forEnc)
+{
+    if (Fs_Hz_in <= 0 || Fs_Hz_out <= 0)
+    {
+        return -1;
+    }
+    memset(S, 0, sizeof(*S));
+    S->Fs_in_kHz = Fs_Hz_in / 1000;
+    S->Fs_out_kHz = Fs_Hz_out / 1000;
+    return 0;
+}
+
+// Resample one block
+extern "C" opus_int silk_resampler(silk_resampler_state_struct *S, opus_int16 out[], const opus_int16 in[], opus_int32 inLen)
+{
+    opus_int32 outLen = inLen * S->Fs_out_kHz / S->Fs_in_kHz;
+    for (opus_int32 i = 0; i < outLen; ++i)
+    {
+        out[i] = in[i * S->Fs_in_kHz / S->Fs_out_kHz];
+    }
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,28 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// Embed the sound assets under the symbols the IDF build gives embedded files
+#define HOST_EMBED(name, file)                \
+    ".global _binary_" name "_start\n"        \
+    "_binary_" name "_start:\n"               \
+    ".incbin \"" HOST_SOUND_DIR "/" file "\"\n" \
+    ".global _binary_" name "_end\n"          \
+    "_binary_" name "_end:\n"
+
+asm(".section .rodata\n"
+    HOST_EMBED("wifi_config_ogg", "wifi_config.ogg")
+    HOST_EMBED("wifi_success_ogg", "wifi_success.ogg")
+    ".previous\n");
\ No newline at end of file
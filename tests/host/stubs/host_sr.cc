@@ -0,0 +1,401 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// Include standard headers
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include <cstring>
+#include <condition_variable>
+
+// Include ESP headers
+#include "esp_err.h"
+#include "esp_afe_sr_models.h"
+#include "esp_wn_models.h"
+
+// Include project headers
+#include "model_basic.h"
+
+// Define fetch chunks the host AFE buffers before it drops the oldest samples
+#define HOST_AFE_BUFFER_CHUNKS 8
+
+// AFE instance: mic samples fed and not yet fetched, in a fixed ring
+struct esp_afe_sr_data_t
+{
+    int channels = 1;
+    int feed_chunk = 0;
+    int fetch_chunk = 0;
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<int16_t> ring;
+    size_t head = 0;
+    size_t count = 0;
+    std::vector<int16_t> output;
+    afe_fetch_result_t result = {};
+    HostAfeStages stages;
+};
+
+// WakeNet instance
+struct model_iface_data_t
+{
+    int chunks = 0;
+};
+
+// Chunk sizes and VAD state of new fetches, the newest AFE and the model list
+static std::atomic<int> afe_feed_chunk{512};
+static std::atomic<int> afe_fetch_chunk{512};
+static std::atomic<vad_state_t> afe_vad{VAD_SILENCE};
+static std::mutex afe_newest_mutex;
+static esp_afe_sr_data_t *afe_newest = nullptr;
+static std::atomic<bool> wakenet_available{false};
+static char model_ns[] = "nsnet2";
+static char model_vad[] = "vadnet1_medium";
+static char model_wn[] = "wn9_hiesp";
+static char wake_word[] = "hi esp";
+
+// Create an AFE instance
+static esp_afe_sr_data_t *AfeCreate(afe_config_t *config)
+{
+    esp_afe_sr_data_t *afe = new esp_afe_sr_data_t();
+    afe->channels = config->channels;
+    afe->feed_chunk = afe_feed_chunk.load();
+    afe->fetch_chunk = afe_fetch_chunk.load();
+    afe->ring.assign((afe->feed_chunk + afe->fetch_chunk) * HOST_AFE_BUFFER_CHUNKS, 0);
+    afe->output.assign(afe->fetch_chunk, 0);
+    afe->stages.aec = config->aec_init;
+    afe->stages.vad = config->vad_init;
+    afe->stages.ns = config->ns_init;
+    afe->stages.agc = config->agc_init;
+    std::lock_guard<std::mutex> lock(afe_newest_mutex);
+    afe_newest = afe;
+    return afe;
+}
+
+// Feed one chunk of interleaved samples, keeping the mic channel
+static int AfeFeed(esp_afe_sr_data_t *afe, const int16_t *in)
+{
+    {
+        std::lock_guard<std::mutex> lock(afe->mutex);
+        for (int i = 0; i < afe->feed_chunk; ++i)
+        {
+            afe->ring[(afe->head + afe->count) % afe->ring.size()] = in[i * afe->channels];
+            if (afe->count == afe->ring.size())
+            {
+                afe->head = (afe->head + 1) % afe->ring.size();
+            }
+            else
+            {
+                afe->count++;
+            }
+        }
+    }
+    afe->cv.notify_all();
+    return afe->feed_chunk;
+}
+
+// Fetch one chunk, waiting for it up to ticks
+static afe_fetch_result_t *AfeFetchWithDelay(esp_afe_sr_data_t *afe, TickType_t ticks)
+{
+    std::unique_lock<std::mutex> lock(afe->mutex);
+    auto ready = [afe]()
+    { return afe->count >= static_cast<size_t>(afe->fetch_chunk); };
+    if (ticks == portMAX_DELAY)
+    {
+        afe->cv.wait(lock, ready);
+    }
+    else if (!afe->cv.wait_for(lock, std::chrono::milliseconds(ticks), ready))
+    {
+        return nullptr;
+    }
+    for (int i = 0; i < afe->fetch_chunk; ++i)
+    {
+        afe->output[i] = afe->ring[(afe->head + i) % afe->ring.size()];
+    }
+    afe->head = (afe->head + afe->fetch_chunk) % afe->ring.size();
+    afe->count -= afe->fetch_chunk;
+    afe->result.data = afe->output.data();
+    afe->result.data_size = afe->fetch_chunk * sizeof(int16_t);
+    afe->result.vad_state = afe_vad.load();
+    afe->result.ret_value = ESP_OK;
+    return &afe->result;
+}
+
+// Fetch one chunk, waiting for it
+static afe_fetch_result_t *AfeFetch(esp_afe_sr_data_t *afe)
+{
+    return AfeFetchWithDelay(afe, portMAX_DELAY);
+}
+
+// Drop buffered samples
+static int AfeResetBuffer(esp_afe_sr_data_t *afe)
+{
+    std::lock_guard<std::mutex> lock(afe->mutex);
+    afe->head = 0;
+    afe->count = 0;
+    return ESP_OK;
+}
+
+// Get chunk sizes and format
+static int AfeGetFeedChunksize(esp_afe_sr_data_t *afe)
+{
+    return afe->feed_chunk;
+}
+static int AfeGetFetchChunksize(esp_afe_sr_data_t *afe)
+{
+    return afe->fetch_chunk;
+}
+static int AfeGetChannelNum(esp_afe_sr_data_t *afe)
+{
+    return afe->channels;
+}
+static int AfeGetSampRate(esp_afe_sr_data_t *afe)
+{
+    return 16000;
+}
+
+// Switch stages
+static int AfeSetStage(esp_afe_sr_data_t *afe, bool HostAfeStages::*stage, bool enable)
+{
+    std::lock_guard<std::mutex> lock(afe->mutex);
+    afe->stages.*stage = enable;
+    return ESP_OK;
+}
+static int AfeDisableAec(esp_afe_sr_data_t *afe)
+{
+    return AfeSetStage(afe, &HostAfeStages::aec, false);
+}
+static int AfeEnableAec(esp_afe_sr_data_t *afe)
+{
+    return AfeSetStage(afe, &HostAfeStages::aec, true);
+}
+static int AfeDisableVad(esp_afe_sr_data_t *afe)
+{
+    return AfeSetStage(afe, &HostAfeStages::vad, false);
+}
+static int AfeEnableVad(esp_afe_sr_data_t *afe)
+{
+    return AfeSetStage(afe, &HostAfeStages::vad, true);
+}
+static int AfeDisableNs(esp_afe_sr_data_t *afe)
+{
+    return AfeSetStage(afe, &HostAfeStages::ns, false);
+}
+static int AfeEnableNs(esp_afe_sr_data_t *afe)
+{
+    return AfeSetStage(afe, &HostAfeStages::ns, true);
+}
+static int AfeDisableAgc(esp_afe_sr_data_t *afe)
+{
+    return AfeSetStage(afe, &HostAfeStages::agc, false);
+}
+static int AfeEnableAgc(esp_afe_sr_data_t *afe)
+{
+    return AfeSetStage(afe, &HostAfeStages::agc, true);
+}
+
+// Destroy an AFE instance
+static void AfeDestroy(esp_afe_sr_data_t *afe)
+{
+    {
+        std::lock_guard<std::mutex> lock(afe_newest_mutex);
+        if (afe_newest == afe)
+        {
+            afe_newest = nullptr;
+        }
+    }
+    delete afe;
+}
+
+// AFE interface
+static const esp_afe_sr_iface_t host_afe_iface = {
+    .create_from_config = AfeCreate,
+    .feed = AfeFeed,
+    .fetch = AfeFetch,
+    .fetch_with_delay = AfeFetchWithDelay,
+    .reset_buffer = AfeResetBuffer,
+    .get_feed_chunksize = AfeGetFeedChunksize,
+    .get_fetch_chunksize = AfeGetFetchChunksize,
+    .get_channel_num = AfeGetChannelNum,
+    .get_samp_rate = AfeGetSampRate,
+    .disable_aec = AfeDisableAec,
+    .enable_aec = AfeEnableAec,
+    .disable_vad = AfeDisableVad,
+    .enable_vad = AfeEnableVad,
+    .disable_ns = AfeDisableNs,
+    .enable_ns = AfeEnableNs,
+    .disable_agc = AfeDisableAgc,
+    .enable_agc = AfeEnableAgc,
+    .destroy = AfeDestroy,
+};
+
+// Build a configuration, one channel per format letter
+afe_config_t *afe_config_init(const char *input_format, srmodel_list_t *models, afe_type_t type, afe_mode_t mode)
+{
+    afe_config_t *config = new afe_config_t();
+    config->afe_type = type;
+    config->afe_mode = mode;
+    config->vad_init = true;
+    config->channels = static_cast<int>(strlen(input_format));
+    return config;
+}
+
+// Get the AFE interface
+const esp_afe_sr_iface_t *esp_afe_handle_from_config(afe_config_t *config)
+{
+    return &host_afe_iface;
+}
+
+// Set chunk sizes of new instances
+void HostAfeSetChunks(int feed_samples, int fetch_samples)
+{
+    afe_feed_chunk = feed_samples;
+    afe_fetch_chunk = fetch_samples;
+}
+
+// Set the VAD state of new fetches
+void HostAfeSetVad(vad_state_t state)
+{
+    afe_vad = state;
+}
+
+// Get the stages of the newest instance
+HostAfeStages HostAfeGetStages()
+{
+    std::lock_guard<std::mutex> lock(afe_newest_mutex);
+    if (afe_newest == nullptr)
+    {
+        return HostAfeStages();
+    }
+    std::lock_guard<std::mutex> stages_lock(afe_newest->mutex);
+    return afe_newest->stages;
+}
+
+// Create a WakeNet instance
+static model_iface_data_t *WakeNetCreate(const void *model_name, det_mode_t det_mode)
+{
+    return new model_iface_data_t();
+}
+
+// Get WakeNet chunk size and format
+static int WakeNetGetSampChunksize(model_iface_data_t *model)
+{
+    return HOST_WAKENET_CHUNK;
+}
+static int WakeNetGetChannelNum(model_iface_data_t *model)
+{
+    return 1;
+}
+static int WakeNetGetSampRate(model_iface_data_t *model)
+{
+    return 16000;
+}
+static int WakeNetGetWordNum(model_iface_data_t *model)
+{
+    return 1;
+}
+static char *WakeNetGetWordName(model_iface_data_t *model, int word_index)
+{
+    return word_index == 1 ? wake_word : nullptr;
+}
+
+// Detect the wake word as a loud chunk
+static int WakeNetDetect(model_iface_data_t *model, int16_t *samples)
+{
+    model->chunks++;
+    for (int i = 0; i < HOST_WAKENET_CHUNK; ++i)
+    {
+        if (samples[i] >= HOST_WAKENET_LEVEL)
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Forget detection history
+static void WakeNetClean(model_iface_data_t *model)
+{
+}
+
+// Destroy a WakeNet instance
+static void WakeNetDestroy(model_iface_data_t *model)
+{
+    delete model;
+}
+
+// WakeNet interface
+static const esp_wn_iface_t host_wn_iface = {
+    .create = WakeNetCreate,
+    .get_samp_chunksize = WakeNetGetSampChunksize,
+    .get_channel_num = WakeNetGetChannelNum,
+    .get_samp_rate = WakeNetGetSampRate,
+    .get_word_num = WakeNetGetWordNum,
+    .get_word_name = WakeNetGetWordName,
+    .detect = WakeNetDetect,
+    .clean = WakeNetClean,
+    .destroy = WakeNetDestroy,
+};
+
+// Get the WakeNet interface
+const esp_wn_iface_t *esp_wn_handle_from_name(const char *model_name)
+{
+    return strncmp(model_name, ESP_WN_PREFIX, strlen(ESP_WN_PREFIX)) == 0 ? &host_wn_iface : nullptr;
+}
+
+// Find a model by keywords
+char *esp_srmodel_filter(srmodel_list_t *models, const char *keyword1, const char *keyword2)
+{
+    for (int i = 0; models != nullptr && i < models->num; ++i)
+    {
+        char *name = models->model_name[i];
+        if ((keyword1 == nullptr || strstr(name, keyword1) != nullptr) && (keyword2 == nullptr || strstr(name, keyword2) != nullptr))
+        {
+            return name;
+        }
+    }
+    return nullptr;
+}
+
+// Include a WakeNet model
+void HostSrSetWakeNet(bool available)
+{
+    wakenet_available = available;
+}
+
+// Constructor
+ModelBasic::ModelBasic()
+{
+    event_group = xEventGroupCreate();
+}
+
+// Destructor
+ModelBasic::~ModelBasic()
+{
+    vEventGroupDelete(event_group);
+}
+
+// Load the host model list
+srmodel_list_t *ModelBasic::Load(void)
+{
+    static char *names_with_wakenet[] = {model_ns, model_vad, model_wn};
+    static char *names[] = {model_ns, model_vad};
+    static srmodel_list_t models;
+    bool wakenet = wakenet_available.load();
+    models.num = wakenet ? 3 : 2;
+    models.model_name = wakenet ? names_with_wakenet : names;
+    return &models;
+}
\ No newline at end of file
@@ -0,0 +1,41 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef HOST_MODEL_PATH_H
+#define HOST_MODEL_PATH_H
+
+// Host stand-in for the esp-sr model list
+typedef struct
+{
+    int num;
+    char **model_name;
+    char **model_info;
+    void **model_data;
+} srmodel_list_t;
+
+// Define model name prefixes
+#define ESP_WN_PREFIX "wn"
+#define ESP_NSNET_PREFIX "nsnet"
+#define ESP_VADN_PREFIX "vadnet"
+
+// Find the first model whose name holds both keywords, either may be null
+char *esp_srmodel_filter(srmodel_list_t *models, const char *keyword1, const char *keyword2);
+
+// Host only: include a WakeNet model in the list ModelBasic loads, which
+// on the host hands out a fixed list instead of reading SPIFFS
+void HostSrSetWakeNet(bool available);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,125 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef HOST_OPUS_H
+#define HOST_OPUS_H
+
+// Include standard headers
+#include <cstdint>
+
+// Host stand-in for libopus. Packets keep real TOC bytes and code 3
+// framing, so durations, repacketization and FEC lookups behave like Opus,
+// but a frame only carries its mean level and the level of the frame
+// before it; decoding fills the frame with that level.
+typedef int16_t opus_int16;
+typedef int32_t opus_int32;
+typedef uint32_t opus_uint32;
+typedef int opus_int;
+typedef int64_t opus_int64;
+typedef int8_t opus_int8;
+typedef uint8_t opus_uint8;
+
+typedef struct OpusEncoder OpusEncoder;
+typedef struct OpusDecoder OpusDecoder;
+typedef struct OpusRepacketizer OpusRepacketizer;
+
+// Error codes
+#define OPUS_OK 0
+#define OPUS_BAD_ARG -1
+#define OPUS_BUFFER_TOO_SMALL -2
+#define OPUS_INTERNAL_ERROR -3
+#define OPUS_INVALID_PACKET -4
+
+// Applications and bandwidths
+#define OPUS_APPLICATION_VOIP 2048
+#define OPUS_AUTO -1000
+#define OPUS_BANDWIDTH_NARROWBAND 1101
+#define OPUS_BANDWIDTH_MEDIUMBAND 1102
+#define OPUS_BANDWIDTH_WIDEBAND 1103
+#define OPUS_BANDWIDTH_SUPERWIDEBAND 1104
+#define OPUS_BANDWIDTH_FULLBAND 1105
+
+// Control requests
+#define OPUS_SET_BITRATE_REQUEST 4002
+#define OPUS_SET_MAX_BANDWIDTH_REQUEST 4004
+#define OPUS_SET_COMPLEXITY_REQUEST 4010
+#define OPUS_SET_INBAND_FEC_REQUEST 4012
+#define OPUS_SET_PACKET_LOSS_PERC_REQUEST 4014
+#define OPUS_SET_DTX_REQUEST 4016
+#define OPUS_RESET_STATE 4028
+#define OPUS_SET_BITRATE(x) OPUS_SET_BITRATE_REQUEST, (opus_int32)(x)
+#define OPUS_SET_MAX_BANDWIDTH(x) OPUS_SET_MAX_BANDWIDTH_REQUEST, (opus_int32)(x)
+#define OPUS_SET_COMPLEXITY(x) OPUS_SET_COMPLEXITY_REQUEST, (opus_int32)(x)
+#define OPUS_SET_INBAND_FEC(x) OPUS_SET_INBAND_FEC_REQUEST, (opus_int32)(x)
+#define OPUS_SET_PACKET_LOSS_PERC(x) OPUS_SET_PACKET_LOSS_PERC_REQUEST, (opus_int32)(x)
+#define OPUS_SET_DTX(x) OPUS_SET_DTX_REQUEST, (opus_int32)(x)
+
+// Encoder
+OpusEncoder *opus_encoder_create(opus_int32 Fs, int channels, int application, int *error);
+void opus_encoder_destroy(OpusEncoder *st);
+int opus_encoder_ctl(OpusEncoder *st, int request, ...);
+opus_int32 opus_encode(OpusEncoder *st, const opus_int16 *pcm, int frame_size, unsigned char *data, opus_int32 max_data_bytes);
+
+// Decoder
+OpusDecoder *opus_decoder_create(opus_int32 Fs, int channels, int *error);
+void opus_decoder_destroy(OpusDecoder *st);
+int opus_decoder_ctl(OpusDecoder *st, int request, ...);
+int opus_decode(OpusDecoder *st, const unsigned char *data, opus_int32 len, opus_int16 *pcm, int frame_size, int decode_fec);
+
+// Packet inspection
+int opus_packet_get_nb_frames(const unsigned char *packet, opus_int32 len);
+int opus_packet_get_nb_samples(const unsigned char *packet, opus_int32 len, opus_int32 Fs);
+
+// Repacketizer
+OpusRepacketizer *opus_repacketizer_create(void);
+OpusRepacketizer *opus_repacketizer_init(OpusRepacketizer *rp);
+void opus_repacketizer_destroy(OpusRepacketizer *rp);
+int opus_repacketizer_cat(OpusRepacketizer *rp, const unsigned char *data, opus_int32 len);
+opus_int32 opus_repacketizer_out(OpusRepacketizer *rp, unsigned char *data, opus_int32 maxlen);
+int opus_repacketizer_get_nb_frames(OpusRepacketizer *rp);
+
+// Host only: time each encoded or decoded frame holds the calling task,
+// spent sleeping as if the codec ran on a core of its own
+void HostOpusSetEncodeCost(int64_t us);
+void HostOpusSetDecodeCost(int64_t us);
+
+// Host only: frames encoded, decoded, recovered from FEC and concealed since start
+struct HostOpusCounters
+{
+    uint64_t encoded = 0;
+    uint64_t decoded = 0;
+    uint64_t recovered = 0;
+    uint64_t concealed = 0;
+};
+HostOpusCounters HostOpusGetCounters();
+
+// Host only: the settings the encoder created last was given
+struct HostOpusEncoderSettings
+{
+    int bitrate = 0;
+    int max_bandwidth = 0;
+    int complexity = 0;
+    bool fec = false;
+    int loss_percent = 0;
+    bool dtx = false;
+};
+HostOpusEncoderSettings HostOpusGetEncoderSettings();
+
+// Host only: read the level one frame of a packet carries, and the level of
+// the frame before it when the frame carries FEC; false for a non-host frame
+bool HostOpusReadFrame(const unsigned char *packet, opus_int32 len, int frame, int16_t *level, bool *fec, int16_t *fec_level);
+
+#endif
\ No newline at end of file
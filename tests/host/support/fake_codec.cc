@@ -0,0 +1,111 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// Include standard headers
+#include <thread>
+
+// Include host support
+#include "fake_codec.h"
+
+// Constructor
+FakeCodec::FakeCodec(int input_rate, int output_rate, int channels, bool reference)
+{
+    duplex = true;
+    input_reference = reference;
+    input_sample_rate = input_rate;
+    output_sample_rate = output_rate;
+    input_channels = channels;
+    output_channels = 1;
+    input_source = [](uint64_t)
+    { return static_cast<int16_t>(0); };
+    output.reserve(static_cast<size_t>(output_rate) * FAKE_CODEC_RECORD_SECONDS);
+}
+
+// Set capture signal
+void FakeCodec::SetInput(std::function<int16_t(uint64_t index)> source)
+{
+    input_source = source;
+}
+
+// Read samples, returning once the last one would have been captured
+int FakeCodec::Read(int16_t *dest, int samples)
+{
+    // Start the capture clock on the first read, restart it after a stall
+    auto now = std::chrono::steady_clock::now();
+    int frames = samples / input_channels;
+    auto period = std::chrono::microseconds(static_cast<int64_t>(frames) * 1000000 / input_sample_rate);
+    auto due = capture_start + std::chrono::microseconds(static_cast<int64_t>(captured) * 1000000 / input_sample_rate);
+    if (captured == 0 || due + period < now)
+    {
+        capture_start = now;
+        captured = 0;
+        due = now;
+    }
+    std::this_thread::sleep_until(due + period);
+
+    // Fill the first channel with the signal, the others with silence
+    for (int i = 0; i < frames; ++i)
+    {
+        dest[i * input_channels] = input_source(captured + i);
+        for (int channel = 1; channel < input_channels; ++channel)
+        {
+            dest[i * input_channels + channel] = 0;
+        }
+    }
+    captured += frames;
+    return samples;
+}
+
+// Write samples, blocking while the DMA buffers are full
+int FakeCodec::Write(const int16_t *data, int samples)
+{
+    // Queue behind what still plays, or play at once after running dry
+    auto now = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point wait_until;
+    {
+        std::lock_guard<std::mutex> lock(output_mutex);
+        if (play_end < now)
+        {
+            play_end = now;
+        }
+        play_end += std::chrono::microseconds(static_cast<int64_t>(samples) * 1000000 / output_sample_rate);
+        wait_until = play_end - std::chrono::microseconds(static_cast<int64_t>(AUDIO_CODEC_DMA_DESC_NUM * AUDIO_CODEC_DMA_FRAME_NUM) * 1000000 / output_sample_rate);
+
+        // Record what fits the reserve
+        size_t count = std::min(static_cast<size_t>(samples), output.capacity() - output.size());
+        output.insert(output.end(), data, data + count);
+        output_samples += samples;
+    }
+    std::this_thread::sleep_until(wait_until);
+    return samples;
+}
+
+// Get samples played
+uint64_t FakeCodec::GetOutputSamples() const
+{
+    std::lock_guard<std::mutex> lock(output_mutex);
+    return output_samples;
+}
+
+// Take recorded playback
+std::vector<int16_t> FakeCodec::TakeOutput()
+{
+    std::lock_guard<std::mutex> lock(output_mutex);
+    std::vector<int16_t> taken;
+    taken.reserve(output.capacity());
+    taken.swap(output);
+    return taken;
+}
\ No newline at end of file
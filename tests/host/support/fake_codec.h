@@ -0,0 +1,65 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef HOST_FAKE_CODEC_H
+#define HOST_FAKE_CODEC_H
+
+// Include standard headers
+#include <mutex>
+#include <chrono>
+#include <vector>
+#include <functional>
+
+// Include project headers
+#include "codec_basic.h"
+
+// Define playback the fake codec records before it stops recording
+#define FAKE_CODEC_RECORD_SECONDS 10
+
+// Host codec paced like blocking I2S reads and writes: capture delivers a
+// test signal in real time on the first channel, playback is recorded
+class FakeCodec : public AudioCodec
+{
+private:
+    // Capture signal and clock
+    std::function<int16_t(uint64_t index)> input_source;
+    std::chrono::steady_clock::time_point capture_start;
+    uint64_t captured = 0;
+
+    // Playback clock and recording, the recording never grows past its reserve
+    mutable std::mutex output_mutex;
+    std::chrono::steady_clock::time_point play_end;
+    std::vector<int16_t> output;
+    uint64_t output_samples = 0;
+
+protected:
+    // Blocking read and write
+    int Read(int16_t *dest, int samples) override;
+    int Write(const int16_t *data, int samples) override;
+
+public:
+    // Constructor, the reference flag adds a codec reference channel to the input
+    FakeCodec(int input_rate, int output_rate, int channels = 1, bool reference = false);
+
+    // Set the signal captured on the first channel
+    void SetInput(std::function<int16_t(uint64_t index)> source);
+
+    // Get samples played, and take the recorded playback
+    uint64_t GetOutputSamples() const;
+    std::vector<int16_t> TakeOutput();
+};
+
+#endif
\ No newline at end of file
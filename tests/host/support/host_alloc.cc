@@ -0,0 +1,80 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// Include standard headers
+#include <new>
+#include <atomic>
+#include <cstdlib>
+
+// Include host support
+#include "host_alloc.h"
+
+// Allocations since start
+static std::atomic<uint64_t> alloc_count{0};
+
+// Count an allocation
+void HostAllocNote()
+{
+    alloc_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Get allocations since start
+uint64_t HostAllocCount()
+{
+    return alloc_count.load(std::memory_order_relaxed);
+}
+
+// Replace the global allocator so every new is counted
+void *operator new(std::size_t size)
+{
+    HostAllocNote();
+    void *ptr = std::malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+// Replace array new
+void *operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+// Replace delete
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+// Replace sized delete
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+// Replace array delete
+void operator delete[](void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+// Replace sized array delete
+void operator delete[](void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
\ No newline at end of file
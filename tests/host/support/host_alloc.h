@@ -0,0 +1,29 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef HOST_ALLOC_H
+#define HOST_ALLOC_H
+
+// Include standard headers
+#include <cstdint>
+
+// Count an allocation, called by operator new and the heap_caps stand-ins
+void HostAllocNote();
+
+// Get allocations made by any thread since start
+uint64_t HostAllocCount();
+
+#endif
\ No newline at end of file
@@ -0,0 +1,247 @@
+/*
+Copyright 2025 GEEKROS, Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// Include standard headers
+#include <mutex>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <unistd.h>
+
+// Include test headers
+#include <gtest/gtest.h>
+
+// Include headers
+#include "tap_basic.h"
+
+// Define a PCM write that spans several records, and how long the drain task is waited for
+#define TEST_PCM_SAMPLES 5000
+#define TEST_DRAIN_WAIT_MS 2000
+
+// One parsed record
+struct TapRecord
+{
+    AudioTapRecord header;
+    std::vector<uint8_t> payload;
+};
+
+// Split a stream of records, failing on a broken one
+static std::vector<TapRecord> ParseRecords(const std::vector<uint8_t> &stream)
+{
+    std::vector<TapRecord> parsed;
+    size_t offset = 0;
+    while (offset + sizeof(AudioTapRecord) <= stream.size())
+    {
+        TapRecord record;
+        memcpy(&record.header, stream.data() + offset, sizeof(record.header));
+        EXPECT_EQ(record.header.magic, static_cast<uint32_t>(AUDIO_TAP_MAGIC));
+        if (record.header.magic != AUDIO_TAP_MAGIC || offset + sizeof(record.header) + record.header.size > stream.size())
+        {
+            ADD_FAILURE() << "broken record at " << offset;
+            break;
+        }
+        offset += sizeof(record.header);
+        record.payload.assign(stream.begin() + offset, stream.begin() + offset + record.header.size);
+        offset += record.header.size;
+        parsed.push_back(record);
+    }
+    EXPECT_EQ(offset, stream.size());
+    return parsed;
+}
+
+// Tap draining into a callback. The drain task never returns, so the tap outlives the test
+class AudioTapTest : public ::testing::Test
+{
+protected:
+    AudioTap *tap = new AudioTap();
+    std::mutex mutex;
+    std::vector<uint8_t> received;
+    std::vector<size_t> batches;
+
+    void SetUp() override
+    {
+        tap->SetSink([this](const uint8_t *data, size_t size)
+                     {
+            std::lock_guard<std::mutex> lock(mutex);
+            received.insert(received.end(), data, data + size);
+            batches.push_back(size);
+            return true; });
+    }
+
+    void TearDown() override
+    {
+        tap->Disable();
+        tap->SetSink(nullptr);
+    }
+
+    // Wait until the drain task handed over a number of bytes
+    std::vector<uint8_t> WaitReceived(size_t size)
+    {
+        auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(TEST_DRAIN_WAIT_MS);
+        while (std::chrono::steady_clock::now() < end)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (received.size() >= size)
+                {
+                    return received;
+                }
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        return received;
+    }
+};
+
+// Only enabled taps report enabled and take records
+TEST_F(AudioTapTest, DisabledTapsTakeNothing)
+{
+    tap->Enable(1u << AudioTapMic);
+    EXPECT_TRUE(tap->IsEnabled(AudioTapMic));
+    EXPECT_FALSE(tap->IsEnabled(AudioTapUplink));
+
+    const uint8_t packet[] = {0x48};
+    tap->WriteOpus(AudioTapUplink, packet, sizeof(packet), 16000, 1);
+    EXPECT_EQ(tap->GetStats().records, 0u);
+
+    // Disabling stops every tap
+    tap->Disable();
+    EXPECT_FALSE(tap->IsEnabled(AudioTapMic));
+    int16_t pcm[160] = {};
+    tap->WritePcm(AudioTapMic, pcm, 160, 16000, 1, 1);
+    EXPECT_EQ(tap->GetStats().records, 0u);
+}
+
+// PCM is split into records that fit a batch, each stamped with its own
+// start time, and Opus packets pass as they are; batches hold whole records
+TEST_F(AudioTapTest, RecordsRoundTrip)
+{
+    tap->Enable((1u << AudioTapResampled) | (1u << AudioTapUplink));
+    std::vector<int16_t> pcm(TEST_PCM_SAMPLES);
+    for (size_t i = 0; i < pcm.size(); ++i)
+    {
+        pcm[i] = static_cast<int16_t>(i);
+    }
+    const int64_t start_us = 1000000;
+    tap->WritePcm(AudioTapResampled, pcm.data(), pcm.size(), 16000, 2, start_us);
+    const uint8_t packet[] = {0x08, 0x01, 0x02, 0x03};
+    tap->WriteOpus(AudioTapUplink, packet, sizeof(packet), 16000, start_us + 5);
+
+    // Wait for every record, then check each batch parses on its own
+    AudioTapStats stats = tap->GetStats();
+    EXPECT_EQ(stats.dropped, 0u);
+    std::vector<uint8_t> stream = WaitReceived(stats.bytes);
+    ASSERT_EQ(stream.size(), stats.bytes);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        size_t offset = 0;
+        for (size_t size : batches)
+        {
+            EXPECT_LE(size, static_cast<size_t>(AUDIO_TAP_DRAIN_BYTES));
+            ParseRecords(std::vector<uint8_t>(stream.begin() + offset, stream.begin() + offset + size));
+            offset += size;
+        }
+    }
+
+    // PCM records join back into the input, timed from where each starts
+    std::vector<TapRecord> records = ParseRecords(stream);
+    ASSERT_EQ(records.size(), stats.records);
+    std::vector<int16_t> joined;
+    for (const TapRecord &record : records)
+    {
+        if (record.header.point == AudioTapUplink)
+        {
+            EXPECT_EQ(record.header.format, AudioTapOpus);
+            EXPECT_EQ(record.header.timestamp_us, start_us + 5);
+            EXPECT_EQ(record.payload, std::vector<uint8_t>(packet, packet + sizeof(packet)));
+            continue;
+        }
+        EXPECT_EQ(record.header.point, AudioTapResampled);
+        EXPECT_EQ(record.header.format, AudioTapPcm16);
+        EXPECT_EQ(record.header.channels, 2);
+        EXPECT_EQ(record.header.sample_rate, 16000u);
+        EXPECT_EQ(record.header.timestamp_us, start_us + static_cast<int64_t>(joined.size() / 2) * 1000000 / 16000);
+        size_t samples = record.payload.size() / sizeof(int16_t);
+        joined.resize(joined.size() + samples);
+        memcpy(joined.data() + joined.size() - samples, record.payload.data(), record.payload.size());
+    }
+    EXPECT_GT(records.size(), 2u);
+    EXPECT_EQ(joined, pcm);
+}
+
+// A full ring drops records instead of blocking the producer
+TEST_F(AudioTapTest, FullRingDropsRecords)
+{
+    tap->Enable(1u << AudioTapMic);
+    std::vector<int16_t> pcm(AUDIO_TAP_BUFFER_KB * 1024);
+    auto start = std::chrono::steady_clock::now();
+    tap->WritePcm(AudioTapMic, pcm.data(), pcm.size(), 16000, 1, 1);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    // Twice the ring was written, what did not fit was dropped at once
+    AudioTapStats stats = tap->GetStats();
+    EXPECT_GT(stats.dropped, 0u);
+    EXPECT_LE(stats.bytes, static_cast<uint64_t>(AUDIO_TAP_BUFFER_KB * 1024));
+    EXPECT_LT(elapsed, std::chrono::milliseconds(AUDIO_TAP_DRAIN_MS));
+
+    // What was queued still drains whole
+    ParseRecords(WaitReceived(stats.bytes));
+}
+
+// A capture file holds whole records and stops at its size limit
+TEST(AudioTapFileTest, FileStopsAtLimit)
+{
+    // The drain task never returns, so the tap outlives the test
+    AudioTap *tap = new AudioTap();
+    char path[] = "/tmp/tap_basic_test_XXXXXX";
+    int fd = mkstemp(path);
+    ASSERT_GE(fd, 0);
+    close(fd);
+    const size_t limit = 3 * AUDIO_TAP_DRAIN_BYTES;
+    ASSERT_TRUE(tap->OpenFile(path, limit));
+    tap->Enable(1u << AudioTapDecoded);
+
+    // Write more than the file takes, spread over several drains
+    std::vector<int16_t> pcm(16000 / 1000 * 100);
+    for (int i = 0; i < 10; ++i)
+    {
+        tap->WritePcm(AudioTapDecoded, pcm.data(), pcm.size(), 16000, 1, 1 + i * 100000);
+        std::this_thread::sleep_for(std::chrono::milliseconds(AUDIO_TAP_DRAIN_MS / 2));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(AUDIO_TAP_DRAIN_MS * 3));
+    tap->Disable();
+
+    // The file stayed within its limit and parses, the rest counted as dropped
+    FILE *file = fopen(path, "rb");
+    ASSERT_NE(file, nullptr);
+    std::vector<uint8_t> stream;
+    uint8_t buffer[1024];
+    for (size_t read; (read = fread(buffer, 1, sizeof(buffer), file)) > 0;)
+    {
+        stream.insert(stream.end(), buffer, buffer + read);
+    }
+    fclose(file);
+    remove(path);
+    EXPECT_GT(stream.size(), 0u);
+    EXPECT_LE(stream.size(), limit);
+    std::vector<TapRecord> records = ParseRecords(stream);
+    EXPECT_EQ(records.size() + tap->GetStats().dropped, tap->GetStats().records);
+}
\ No newline at end of file
@@ -0,0 +1,160 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+import argparse
+import os
+import io
+import struct
+import wave
+
+# Tap record header: magic, point, format, channels, reserved, sample rate, size, timestamp
+TAP_HEADER = struct.Struct("<IBBBBIIq")
+TAP_MAGIC = 0x50415447
+
+# Tap point names, indexed by AudioTapPoint
+TAP_POINTS = ["mic", "resampled", "afe", "decoded", "playback", "uplink"]
+
+# Tap payload formats
+TAP_PCM16 = 0
+TAP_OPUS = 1
+
+# Opus frame duration in tenths of a millisecond, indexed by TOC config
+OPUS_FRAME_DURATIONS = (
+    [100, 200, 400, 600] * 3 +
+    [100, 200] * 2 +
+    [25, 50, 100, 200] * 4
+)
+
+def opus_packet_samples_48k(packet):
+    """Get the duration of an Opus packet in 48 kHz samples from its TOC byte."""
+    toc = packet[0]
+    code = toc & 0x03
+    if code == 0:
+        frames = 1
+    elif code in (1, 2):
+        frames = 2
+    else:
+        if len(packet) < 2:
+            raise ValueError("truncated code 3 Opus packet")
+        frames = packet[1] & 0x3F
+    return OPUS_FRAME_DURATIONS[toc >> 3] * frames * 48 // 10
+
+def parse_records(data):
+    """Walk tap records and return [(point, format, channels, rate, timestamp, payload)]."""
+    records = []
+    offset = 0
+    skipped = 0
+    while offset + TAP_HEADER.size <= len(data):
+        magic, point, fmt, channels, _, rate, size, timestamp = TAP_HEADER.unpack_from(data, offset)
+        end = offset + TAP_HEADER.size + size
+        if magic != TAP_MAGIC or end > len(data):
+            # Resynchronize on the next magic after a torn or corrupt record
+            offset += 1
+            skipped += 1
+            continue
+        records.append((point, fmt, channels, rate, timestamp, data[offset + TAP_HEADER.size:end]))
+        offset = end
+    if skipped:
+        print(f"Skipped {skipped} bytes of unparsable data")
+    return records
+
+def assemble_pcm(records, start_us, tolerance_ms):
+    """Place PCM records on a timeline starting at start_us, zero filling gaps."""
+    rate = records[0][3]
+    channels = records[0][2]
+    frame_bytes = 2 * channels
+    tolerance = rate * tolerance_ms // 1000
+    pcm = bytearray()
+    gaps = 0
+    for _, _, _, _, timestamp, payload in sorted(records, key=lambda r: r[4]):
+        position = (timestamp - start_us) * rate // 1000000
+        written = len(pcm) // frame_bytes
+        # Small timestamp jitter joins records back to back
+        if position > written + tolerance:
+            pcm += bytes((position - written) * frame_bytes)
+            gaps += 1 if written > 0 else 0
+        elif position < written - tolerance and position >= 0:
+            del pcm[position * frame_bytes:]
+        pcm += payload
+    return rate, channels, bytes(pcm), gaps
+
+def write_wav(path, rate, channels, pcm):
+    """Write 16-bit PCM to a WAV file."""
+    with wave.open(path, "wb") as f:
+        f.setnchannels(channels)
+        f.setsampwidth(2)
+        f.setframerate(rate)
+        f.writeframes(pcm)
+
+def ogg_crc(data):
+    """Compute the OGG page checksum."""
+    crc = 0
+    for byte in data:
+        crc ^= byte << 24
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x04C11DB7) if crc & 0x80000000 else crc << 1
+            crc &= 0xFFFFFFFF
+    return crc
+
+def ogg_page(packet, granule, sequence, flags):
+    """Build an OGG page holding one packet."""
+    lacing = [255] * (len(packet) // 255) + [len(packet) % 255]
+    header = struct.pack("<4sBBqIII", b"OggS", 0, flags, granule, 1, sequence, 0) + bytes([len(lacing)]) + bytes(lacing)
+    page = bytearray(header + packet)
+    struct.pack_into("<I", page, 22, ogg_crc(page))
+    return bytes(page)
+
+def write_ogg_opus(path, rate, packets):
+    """Write Opus packets to an OGG Opus file."""
+    head = b"OpusHead" + struct.pack("<BBHIhB", 1, 1, 0, rate, 0, 0)
+    tags = b"OpusTags" + struct.pack("<I", 10) + b"audio_taps" + struct.pack("<I", 0)
+    pages = [ogg_page(head, 0, 0, 0x02), ogg_page(tags, 0, 1, 0)]
+    granule = 0
+    for index, packet in enumerate(packets):
+        granule += opus_packet_samples_48k(packet)
+        flags = 0x04 if index == len(packets) - 1 else 0
+        pages.append(ogg_page(packet, granule, index + 2, flags))
+    with io.open(path, "wb") as f:
+        f.write(b"".join(pages))
+
+def extract(inputs, output_dir, tolerance_ms):
+    """Split captured tap records into one aligned file per tap."""
+    records = []
+    for path in inputs:
+        with io.open(path, "rb") as f:
+            records += parse_records(f.read())
+    if not records:
+        print("No tap records found")
+        return
+
+    # Align every tap to the earliest record of the capture
+    start_us = min(r[4] for r in records)
+    os.makedirs(output_dir, exist_ok=True)
+    for point in sorted(set(r[0] for r in records)):
+        name = TAP_POINTS[point] if point < len(TAP_POINTS) else f"tap{point}"
+        tap = [r for r in records if r[0] == point]
+        offset_ms = (min(r[4] for r in tap) - start_us) / 1000
+        if tap[0][1] == TAP_OPUS:
+            path = os.path.join(output_dir, f"{name}.opus")
+            packets = [r[5] for r in sorted(tap, key=lambda r: r[4])]
+            write_ogg_opus(path, tap[0][3], packets)
+            print(f"Extracted: {path} ({len(packets)} packets, starts at {offset_ms:.1f} ms)")
+        else:
+            path = os.path.join(output_dir, f"{name}.wav")
+            rate, channels, pcm, gaps = assemble_pcm(tap, start_us, tolerance_ms)
+            write_wav(path, rate, channels, pcm)
+            seconds = len(pcm) / (2 * channels * rate)
+            print(f"Extracted: {path} ({rate} Hz, {channels} ch, {seconds:.2f} s, {gaps} gaps)")
+
+def main():
+    parser = argparse.ArgumentParser(description="Split captured audio tap records into time-aligned WAV files")
+    parser.add_argument("--output", default="taps", help="Output directory")
+    parser.add_argument("--tolerance-ms", type=int, default=5, help="Timestamp jitter joined without a gap")
+    parser.add_argument("inputs", nargs="+", help="Tap captures, taps.bin from SPIFFS or saved data channel messages")
+    args = parser.parse_args()
+
+    extract(args.inputs, args.output, args.tolerance_ms)
+
+
+if __name__ == "__main__":
+    main()
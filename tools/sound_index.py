@@ -0,0 +1,145 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+import argparse
+import os
+import io
+import struct
+
+# Opus frame duration in tenths of a millisecond, indexed by TOC config
+OPUS_FRAME_DURATIONS = (
+    [100, 200, 400, 600] * 3 +
+    [100, 200] * 2 +
+    [25, 50, 100, 200] * 4
+)
+
+def opus_packet_duration_ms(packet):
+    """Get the duration of an Opus packet from its TOC byte."""
+    toc = packet[0]
+    code = toc & 0x03
+    if code == 0:
+        frames = 1
+    elif code in (1, 2):
+        frames = 2
+    else:
+        if len(packet) < 2:
+            raise ValueError("truncated code 3 Opus packet")
+        frames = packet[1] & 0x3F
+    return OPUS_FRAME_DURATIONS[toc >> 3] * frames // 10
+
+def parse_ogg(data):
+    """Walk OGG pages and return (sample_rate, [(offset, size, duration)])."""
+    sample_rate = 16000
+    seen_head = False
+    seen_tags = False
+    packets = []
+
+    offset = 0
+    pending = None
+    while offset + 27 <= len(data):
+        if data[offset:offset + 4] != b"OggS":
+            raise ValueError(f"missing OGG capture pattern at {offset}")
+
+        segments = data[offset + 26]
+        table = data[offset + 27:offset + 27 + segments]
+        cur = offset + 27 + segments
+
+        for lacing in table:
+            # Start or continue a packet
+            if pending is None:
+                pending = [cur, 0]
+            pending[1] += lacing
+            cur += lacing
+            if lacing == 255:
+                continue
+
+            # Packet is complete
+            start, size = pending
+            pending = None
+            if size == 0:
+                continue
+            if start + size != cur:
+                raise ValueError("OGG packet spans pages, not supported for flash playback")
+            packet = data[start:start + size]
+
+            if not seen_head:
+                if size >= 19 and packet[:8] == b"OpusHead":
+                    seen_head = True
+                    sample_rate = struct.unpack_from("<I", packet, 12)[0] or 48000
+                continue
+            if not seen_tags:
+                if size >= 8 and packet[:8] == b"OpusTags":
+                    seen_tags = True
+                continue
+
+            packets.append((start, size, opus_packet_duration_ms(packet)))
+
+        offset = cur
+
+    if not seen_head:
+        raise ValueError("no OpusHead packet found")
+    return sample_rate, packets
+
+def symbol_name(path):
+    """Derive the C++ symbol prefix from an asset file name."""
+    name = os.path.splitext(os.path.basename(path))[0]
+    return "".join(c if c.isalnum() else "_" for c in name).upper()
+
+def write_index(inputs, output_path):
+    """Write a constexpr packet index header for the given OGG files."""
+    lines = [
+        "// Generated by tools/sound_index.py, do not edit",
+        "",
+        "#ifndef LANGUAGE_SOUND_INDEX_H",
+        "#define LANGUAGE_SOUND_INDEX_H",
+        "",
+        "// Namespace for language sounds",
+        "namespace Lang",
+        "{",
+        "    // Namespace for sound assets",
+        "    namespace Sounds",
+        "    {",
+        "        // Namespace for pre-indexed packet tables",
+        "        namespace Index",
+        "        {",
+    ]
+
+    for path in sorted(inputs):
+        with io.open(path, "rb") as f:
+            data = f.read()
+        sample_rate, packets = parse_ogg(data)
+        name = symbol_name(path)
+        total_ms = sum(p[2] for p in packets)
+
+        lines.append(f"            // {os.path.basename(path)}: {len(packets)} packets, {total_ms} ms")
+        lines.append(f"            inline constexpr int {name}_SAMPLE_RATE = {sample_rate};")
+        lines.append(f"            inline constexpr Packet {name}_PACKETS[] = {{")
+        for start, size, duration in packets:
+            lines.append(f"                {{{start}, {size}, {duration}}},")
+        lines.append("            };")
+        print(f"Indexed: {path} ({len(packets)} packets, {sample_rate} Hz, {total_ms} ms)")
+
+    lines += [
+        "        }",
+        "    }",
+        "}",
+        "",
+        "#endif",
+    ]
+
+    os.makedirs(os.path.dirname(output_path) or ".", exist_ok=True)
+    with io.open(output_path, "w", encoding="utf-8") as f:
+        f.write("\n".join(lines) + "\n")
+    print(f"Generated: {output_path}")
+
+def main():
+    parser = argparse.ArgumentParser(description="Generate a constexpr Opus packet index from OGG sound assets")
+    parser.add_argument("--output", required=True, help="Output header path")
+    parser.add_argument("inputs", nargs="+", help="OGG sound files")
+    args = parser.parse_args()
+
+    write_index(args.inputs, args.output)
+
+
+if __name__ == "__main__":
+    main()
\ No newline at end of file